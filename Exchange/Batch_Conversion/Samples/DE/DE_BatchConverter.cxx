@@ -0,0 +1,529 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#include <DE_BatchConverter.hxx>
+
+#include <Message.hxx>
+#include <Message_ProgressIndicator.hxx>
+#include <Message_ProgressScope.hxx>
+#include <NCollection_Array1.hxx>
+#include <NCollection_DataMap.hxx>
+#include <OSD_FileSystem.hxx>
+#include <OSD_MemInfo.hxx>
+#include <OSD_OpenFile.hxx>
+#include <OSD_Parallel.hxx>
+#include <OSD_ThreadPool.hxx>
+#include <OSD_Timer.hxx>
+#include <Standard_Failure.hxx>
+#include <TDocStd_Application.hxx>
+#include <TDocStd_Document.hxx>
+
+#include <atomic>
+#include <fstream>
+#include <new>
+#include <string>
+
+IMPLEMENT_STANDARD_RTTIEXT(DE_BatchConverter, Standard_Transient)
+
+namespace
+{
+//! Returns the private memory of the process in bytes.
+static Standard_Size privateMemory()
+{
+  OSD_MemInfo aMemInfo(Standard_False);
+  aMemInfo.SetActive(Standard_False);
+  aMemInfo.SetActive(OSD_MemInfo::MemPrivate, Standard_True);
+  aMemInfo.Update();
+  return aMemInfo.Value(OSD_MemInfo::MemPrivate);
+}
+
+//! Appends the string to JSON output with escaping.
+static void jsonString(TCollection_AsciiString& theJson, const TCollection_AsciiString& theStr)
+{
+  theJson += "\"";
+  for (Standard_Integer aCharIter = 1; aCharIter <= theStr.Length(); ++aCharIter)
+  {
+    const Standard_Character aChar = theStr.Value(aCharIter);
+    switch (aChar)
+    {
+      case '"':
+        theJson += "\\\"";
+        break;
+      case '\\':
+        theJson += "\\\\";
+        break;
+      case '\b':
+        theJson += "\\b";
+        break;
+      case '\f':
+        theJson += "\\f";
+        break;
+      case '\n':
+        theJson += "\\n";
+        break;
+      case '\r':
+        theJson += "\\r";
+        break;
+      case '\t':
+        theJson += "\\t";
+        break;
+      default: {
+        // other control characters U+0000..U+001F are not allowed in JSON strings
+        if ((unsigned char)aChar < 0x20)
+        {
+          char aCode[8];
+          Sprintf(aCode, "\\u%04x", (unsigned int)(unsigned char)aChar);
+          theJson += aCode;
+        }
+        else
+        {
+          theJson += aChar;
+        }
+        break;
+      }
+    }
+  }
+  theJson += "\"";
+}
+
+//! Progress indicator of a single job interrupting it by timeout, memory limit
+//! or interruption of the whole batch.
+//! The memory base is taken when the job starts, as the heap freed by previous jobs
+//! is rarely returned to the system and would be counted against every next job.
+class DE_JobIndicator : public Message_ProgressIndicator
+{
+public:
+  DE_JobIndicator(const Message_ProgressScope& theBatchScope,
+                  const Standard_Real          theTimeout,
+                  const Standard_Size          theMemoryLimit)
+      : myBatchScope(theBatchScope),
+        myTimeout(theTimeout),
+        myMemoryLimit(theMemoryLimit),
+        myMemoryBase(theMemoryLimit != 0 ? privateMemory() : 0),
+        myLastCheck(0.0),
+        myMemoryPeak(0),
+        myState(DE_BatchConverter::Status_NotStarted)
+  {
+    myTimer.Start();
+  }
+
+  virtual Standard_Boolean UserBreak() Standard_OVERRIDE
+  {
+    if (myState != DE_BatchConverter::Status_NotStarted)
+    {
+      return Standard_True;
+    }
+    if (myBatchScope.UserBreak())
+    {
+      return Standard_True;
+    }
+
+    const Standard_Real aTime = myTimer.ElapsedTime();
+    if (myTimeout > 0.0 && aTime > myTimeout)
+    {
+      myState = DE_BatchConverter::Status_Timeout;
+      return Standard_True;
+    }
+    // querying the memory counters is a system call, so they are checked at most twice a second
+    if (myMemoryLimit > 0 && aTime - myLastCheck > 0.5)
+    {
+      myLastCheck = aTime;
+      CheckMemory();
+    }
+    return myState != DE_BatchConverter::Status_NotStarted;
+  }
+
+  virtual void Show(const Message_ProgressScope&, const Standard_Boolean) Standard_OVERRIDE {}
+
+  //! Updates the memory peak and checks the memory limit of the process.
+  void CheckMemory()
+  {
+    const Standard_Size aMemory = privateMemory();
+    myMemoryPeak                = Max(myMemoryPeak.load(), aMemory);
+    // the heap is shared by all jobs, so that only the growth of the whole process is known
+    if (myMemoryLimit != 0 && aMemory > myMemoryBase && aMemory - myMemoryBase > myMemoryLimit)
+    {
+      myState = DE_BatchConverter::Status_MemoryLimit;
+    }
+  }
+
+  //! Returns the status of the interrupted job or Status_NotStarted.
+  DE_BatchConverter::Status State() const { return (DE_BatchConverter::Status)myState.load(); }
+
+  //! Returns the peak private memory of the process observed during the job.
+  Standard_Size MemoryPeak() const { return myMemoryPeak; }
+
+private:
+  const Message_ProgressScope& myBatchScope;
+  const Standard_Real          myTimeout;
+  const Standard_Size          myMemoryLimit;
+  const Standard_Size          myMemoryBase;
+  OSD_Timer                    myTimer;
+  std::atomic<double>          myLastCheck;
+  std::atomic<Standard_Size>   myMemoryPeak;
+  std::atomic<int>             myState;
+};
+
+//! Wrappers and application owned by a worker thread.
+struct DE_BatchWorker
+{
+  Handle(DE_Wrapper) Wrapper; //!< copy of the batch wrapper
+  NCollection_DataMap<TCollection_AsciiString, Handle(DE_Wrapper)> Configs; //!< wrappers of job configurations
+  Handle(TDocStd_Application) Application; //!< application creating the documents of the jobs
+};
+
+//! Functor converting a single file.
+class DE_BatchFunctor
+{
+public:
+  DE_BatchFunctor(NCollection_Array1<DE_BatchConverter::Job>&      theJobs,
+                  NCollection_Array1<DE_BatchWorker>&              theWorkers,
+                  const NCollection_Array1<Message_ProgressRange>& theRanges,
+                  const Standard_Real                              theTimeout,
+                  const Standard_Size                              theMemoryLimit)
+      : myJobs(theJobs),
+        myWorkers(theWorkers),
+        myRanges(theRanges),
+        myTimeout(theTimeout),
+        myMemoryLimit(theMemoryLimit)
+  {
+  }
+
+  void operator()(int theThreadIndex, int theIndex) const
+  {
+    DE_BatchConverter::Job& aJob = myJobs.ChangeValue(theIndex);
+    Message_ProgressScope   aBatchPS(myRanges.Value(theIndex), NULL, 1);
+    if (aBatchPS.UserBreak())
+    {
+      return;
+    }
+
+    DE_BatchWorker&    aWorker  = myWorkers.ChangeValue(theThreadIndex);
+    Handle(DE_Wrapper) aWrapper = aWorker.Wrapper;
+    if (!aJob.Config.IsEmpty() && !aWorker.Configs.Find(aJob.Config, aWrapper))
+    {
+      // the configuration is loaded once per worker and reused by its next jobs
+      aWrapper = aWorker.Wrapper->Copy();
+      if (!aWrapper->Load(aJob.Config))
+      {
+        aWrapper.Nullify();
+      }
+      aWorker.Configs.Bind(aJob.Config, aWrapper);
+    }
+    if (aWrapper.IsNull())
+    {
+      aJob.State   = DE_BatchConverter::Status_ConfigFailed;
+      aJob.Message = TCollection_AsciiString("unable to load configuration ") + aJob.Config;
+      return;
+    }
+
+    Handle(DE_JobIndicator) anIndicator =
+      new DE_JobIndicator(aBatchPS, myTimeout, myMemoryLimit);
+    Handle(TDocStd_Document) aDoc;
+    aWorker.Application->NewDocument("BinXCAF", aDoc);
+    // exceptions are reported with the status of the phase which has thrown them
+    DE_BatchConverter::Status aFailure = DE_BatchConverter::Status_ReadFailed;
+    try
+    {
+      Message_ProgressScope aJobPS(anIndicator->Start(), NULL, 2);
+      OSD_Timer             aTimer;
+      aTimer.Start();
+      const bool isRead = aWrapper->Read(aJob.Input, aDoc, aJobPS.Next());
+      aTimer.Stop();
+      aJob.ReadTime = aTimer.ElapsedTime();
+      if (!isRead)
+      {
+        aJob.State   = DE_BatchConverter::Status_ReadFailed;
+        aJob.Message = "reading failed";
+      }
+      else
+      {
+        aFailure = DE_BatchConverter::Status_WriteFailed;
+        aTimer.Reset();
+        aTimer.Start();
+        const bool isWritten = aWrapper->Write(aJob.Output, aDoc, aJobPS.Next());
+        aTimer.Stop();
+        aJob.WriteTime = aTimer.ElapsedTime();
+        aJob.State     = isWritten ? DE_BatchConverter::Status_Done
+                                   : DE_BatchConverter::Status_WriteFailed;
+        aJob.Message   = isWritten ? "" : "writing failed";
+      }
+    }
+    catch (const Standard_Failure& theFailure)
+    {
+      aJob.State   = aFailure;
+      aJob.Message = TCollection_AsciiString("exception: ") + theFailure.GetMessageString();
+    }
+    catch (const std::bad_alloc&)
+    {
+      aJob.State   = DE_BatchConverter::Status_MemoryLimit;
+      aJob.Message = "out of memory";
+    }
+
+    anIndicator->CheckMemory();
+    aJob.MemoryPeak = anIndicator->MemoryPeak();
+    if (anIndicator->State() == DE_BatchConverter::Status_Timeout)
+    {
+      aJob.State   = DE_BatchConverter::Status_Timeout;
+      aJob.Message = "timeout";
+    }
+    else if (anIndicator->State() == DE_BatchConverter::Status_MemoryLimit
+             && aJob.State != DE_BatchConverter::Status_Done)
+    {
+      aJob.State   = DE_BatchConverter::Status_MemoryLimit;
+      aJob.Message = "memory limit";
+    }
+    else if (aJob.State != DE_BatchConverter::Status_Done && aBatchPS.UserBreak())
+    {
+      aJob.State   = DE_BatchConverter::Status_NotStarted;
+      aJob.Message = "interrupted";
+    }
+    aWorker.Application->Close(aDoc);
+  }
+
+private:
+  NCollection_Array1<DE_BatchConverter::Job>&      myJobs;
+  NCollection_Array1<DE_BatchWorker>&              myWorkers;
+  const NCollection_Array1<Message_ProgressRange>& myRanges;
+  const Standard_Real                              myTimeout;
+  const Standard_Size                              myMemoryLimit;
+};
+} // namespace
+
+//=======================================================================
+// function : DE_BatchConverter
+// purpose  :
+//=======================================================================
+DE_BatchConverter::DE_BatchConverter(const Handle(DE_Wrapper)& theWrapper)
+    : myWrapper(theWrapper),
+      myNbThreads(0),
+      myTimeout(0.0),
+      myProcessMemoryLimit(0),
+      myElapsedTime(0.0)
+{
+}
+
+//=======================================================================
+// function : AddJob
+// purpose  :
+//=======================================================================
+void DE_BatchConverter::AddJob(const TCollection_AsciiString& theInput,
+                               const TCollection_AsciiString& theOutput,
+                               const TCollection_AsciiString& theConfig)
+{
+  Job aJob;
+  aJob.Input  = theInput;
+  aJob.Output = theOutput;
+  aJob.Config = theConfig;
+  myJobs.Append(aJob);
+}
+
+//=======================================================================
+// function : LoadManifest
+// purpose  :
+//=======================================================================
+bool DE_BatchConverter::LoadManifest(const TCollection_AsciiString& thePath)
+{
+  const Handle(OSD_FileSystem)& aFileSystem = OSD_FileSystem::DefaultFileSystem();
+  std::shared_ptr<std::istream> aStream     = aFileSystem->OpenIStream(thePath, std::ios::in);
+  if (aStream.get() == NULL || !aStream->good())
+  {
+    Message::SendFail() << "Error in the DE_BatchConverter: unable to open manifest " << thePath;
+    return false;
+  }
+
+  bool             isDone     = true;
+  Standard_Integer aLineIndex = 0;
+  std::string      aLineStr;
+  while (std::getline(*aStream, aLineStr))
+  {
+    ++aLineIndex;
+    TCollection_AsciiString aLine(aLineStr.c_str());
+    aLine.RightAdjust();
+    if (aLine.IsEmpty() || aLine.Value(1) == '#')
+    {
+      continue;
+    }
+
+    const TCollection_AsciiString anInput  = aLine.Token("\t", 1);
+    const TCollection_AsciiString anOutput = aLine.Token("\t", 2);
+    if (anOutput.IsEmpty())
+    {
+      Message::SendFail() << "Error in the DE_BatchConverter: no output file at line " << aLineIndex
+                          << " of manifest " << thePath;
+      isDone = false;
+      continue;
+    }
+    AddJob(anInput, anOutput, aLine.Token("\t", 3));
+  }
+  return isDone;
+}
+
+//=======================================================================
+// function : Perform
+// purpose  :
+//=======================================================================
+Standard_Integer DE_BatchConverter::Perform(const Message_ProgressRange& theProgress)
+{
+  myElapsedTime = 0.0;
+  if (myJobs.IsEmpty())
+  {
+    return 0;
+  }
+
+  OSD_Timer aTimer;
+  aTimer.Start();
+  NCollection_Array1<Job>                   aJobs(0, myJobs.Length() - 1);
+  NCollection_Array1<Message_ProgressRange> aRanges(0, myJobs.Length() - 1);
+  Message_ProgressScope                     aPS(theProgress, "Converting files", myJobs.Length());
+  Standard_Integer                          aJobIndex = 0;
+  for (NCollection_Sequence<Job>::Iterator aJobIter(myJobs); aJobIter.More();
+       aJobIter.Next(), ++aJobIndex)
+  {
+    aJobs.SetValue(aJobIndex, aJobIter.Value());
+    aJobs.ChangeValue(aJobIndex).State = Status_NotStarted;
+    aRanges.SetValue(aJobIndex, aPS.Next());
+  }
+
+  const int aNbThreads =
+    Min(myNbThreads > 0 ? myNbThreads : OSD_Parallel::NbLogicalProcessors(), aJobs.Length());
+  Handle(OSD_ThreadPool)   aPool = new OSD_ThreadPool(aNbThreads);
+  OSD_ThreadPool::Launcher aLauncher(*aPool, aNbThreads);
+
+  // wrappers are copied by the calling thread, so that the batch wrapper is never accessed concurrently
+  NCollection_Array1<DE_BatchWorker> aWorkers(aLauncher.LowerThreadIndex(),
+                                              aLauncher.UpperThreadIndex());
+  for (Standard_Integer aWorkerIter = aWorkers.Lower(); aWorkerIter <= aWorkers.Upper();
+       ++aWorkerIter)
+  {
+    DE_BatchWorker& aWorker = aWorkers.ChangeValue(aWorkerIter);
+    aWorker.Wrapper         = myWrapper->Copy();
+    aWorker.Application     = new TDocStd_Application();
+  }
+
+  const DE_BatchFunctor aFunctor(aJobs, aWorkers, aRanges, myTimeout, myProcessMemoryLimit);
+  aLauncher.Perform(aJobs.Lower(), aJobs.Upper() + 1, aFunctor);
+
+  Standard_Integer aNbDone = 0;
+  aJobIndex                = 0;
+  for (NCollection_Sequence<Job>::Iterator aJobIter(myJobs); aJobIter.More();
+       aJobIter.Next(), ++aJobIndex)
+  {
+    aJobIter.ChangeValue() = aJobs.Value(aJobIndex);
+    if (aJobIter.Value().State == Status_Done)
+    {
+      ++aNbDone;
+    }
+    else if (aJobIter.Value().State != Status_NotStarted)
+    {
+      Message::SendFail() << "Error in the DE_BatchConverter during converting the file "
+                          << aJobIter.Value().Input << "\t: " << aJobIter.Value().Message;
+    }
+  }
+  aTimer.Stop();
+  myElapsedTime = aTimer.ElapsedTime();
+  return aNbDone;
+}
+
+//=======================================================================
+// function : StatusName
+// purpose  :
+//=======================================================================
+Standard_CString DE_BatchConverter::StatusName(const Status theStatus)
+{
+  switch (theStatus)
+  {
+    case Status_NotStarted:
+      return "notStarted";
+    case Status_Done:
+      return "done";
+    case Status_ReadFailed:
+      return "readFailed";
+    case Status_WriteFailed:
+      return "writeFailed";
+    case Status_Timeout:
+      return "timeout";
+    case Status_MemoryLimit:
+      return "memoryLimit";
+    case Status_ConfigFailed:
+      return "configFailed";
+  }
+  return "unknown";
+}
+
+//=======================================================================
+// function : Report
+// purpose  :
+//=======================================================================
+TCollection_AsciiString DE_BatchConverter::Report() const
+{
+  Standard_Integer aNbDone = 0;
+  for (NCollection_Sequence<Job>::Iterator aJobIter(myJobs); aJobIter.More(); aJobIter.Next())
+  {
+    if (aJobIter.Value().State == Status_Done)
+    {
+      ++aNbDone;
+    }
+  }
+
+  TCollection_AsciiString aJson = TCollection_AsciiString("{\n  \"threads\": ") + myNbThreads
+                                  + ",\n  \"timeout\": " + myTimeout
+                                  + ",\n  \"processMemoryLimit\": "
+                                  + (Standard_Real)myProcessMemoryLimit
+                                  + ",\n  \"elapsed\": " + myElapsedTime
+                                  + ",\n  \"nbJobs\": " + myJobs.Length()
+                                  + ",\n  \"nbDone\": " + aNbDone
+                                  + ",\n  \"nbFailed\": " + (myJobs.Length() - aNbDone)
+                                  + ",\n  \"jobs\": [";
+  bool isFirst = true;
+  for (NCollection_Sequence<Job>::Iterator aJobIter(myJobs); aJobIter.More(); aJobIter.Next())
+  {
+    const Job& aJob = aJobIter.Value();
+    aJson += isFirst ? "\n" : ",\n";
+    isFirst = false;
+    aJson += "    {\"input\": ";
+    jsonString(aJson, aJob.Input);
+    aJson += ", \"output\": ";
+    jsonString(aJson, aJob.Output);
+    aJson += ", \"config\": ";
+    jsonString(aJson, aJob.Config);
+    aJson += TCollection_AsciiString(",\n     \"status\": \"") + StatusName(aJob.State) + "\""
+             + ", \"readTime\": " + aJob.ReadTime + ", \"writeTime\": " + aJob.WriteTime
+             + ", \"memoryPeak\": " + (Standard_Real)aJob.MemoryPeak + ", \"message\": ";
+    jsonString(aJson, aJob.Message);
+    aJson += "}";
+  }
+  aJson += "\n  ]\n}\n";
+  return aJson;
+}
+
+//=======================================================================
+// function : WriteReport
+// purpose  :
+//=======================================================================
+bool DE_BatchConverter::WriteReport(const TCollection_AsciiString& thePath) const
+{
+  std::ofstream aStream;
+  OSD_OpenStream(aStream, thePath, std::ios::out | std::ios::binary);
+  if (!aStream.is_open())
+  {
+    Message::SendFail() << "Error in the DE_BatchConverter: unable to open file " << thePath
+                        << " for writing";
+    return false;
+  }
+  aStream << Report();
+  aStream.close();
+  return !aStream.fail();
+}
@@ -0,0 +1,149 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#ifndef _DE_BatchConverter_HeaderFile
+#define _DE_BatchConverter_HeaderFile
+
+#include <DE_Wrapper.hxx>
+#include <Message_ProgressRange.hxx>
+#include <NCollection_Sequence.hxx>
+#include <TCollection_AsciiString.hxx>
+
+//! Converter of many files through DE_Wrapper in a fixed pool of worker threads.
+//! Each job reads the input file into an XDE document and writes it to the output file;
+//! the formats are defined by the providers of the wrapper found for the file extensions.
+//!
+//! Every worker owns a copy of the wrapper made by DE_Wrapper::Copy(),
+//! so that the configuration nodes (DE_ConfigurationNode::Copy()) and the providers
+//! are never shared between threads. A job may define its own configuration file,
+//! which is loaded into a copy of the worker's wrapper once per worker.
+//!
+//! Jobs are interrupted cooperatively through the progress indicator:
+//! the provider stops at the next progress check when the timeout of the job is exceeded
+//! or when the memory of the process exceeds the limit.
+//! The timeout is not enforced otherwise, so that a provider which does not check
+//! the progress indicator (or a long operation between two checks) runs beyond it.
+//! As all jobs share the heap of the process, the memory of a single job cannot be measured:
+//! the limit applies to the growth of the private memory of the whole process
+//! since the start of the job, including allocations of the jobs running at the same time.
+//! The base is taken per job, as the heap freed by previous jobs is rarely returned
+//! to the system and would otherwise be counted against every next job.
+//!
+//! Providers may use multithreading themselves (e.g. OSD_Parallel),
+//! in which case their tasks share the threads of the process with the workers.
+class DE_BatchConverter : public Standard_Transient
+{
+  DEFINE_STANDARD_RTTIEXT(DE_BatchConverter, Standard_Transient)
+public:
+  //! Status of the job.
+  enum Status
+  {
+    Status_NotStarted = 0, //!< job has not been executed
+    Status_Done,           //!< output file has been written
+    Status_ReadFailed,     //!< input file cannot be read
+    Status_WriteFailed,    //!< output file cannot be written
+    Status_Timeout,        //!< job has been interrupted by timeout
+    Status_MemoryLimit,    //!< job has been interrupted by memory limit of the process
+    Status_ConfigFailed    //!< configuration file of the job cannot be loaded
+  };
+
+  //! Conversion job.
+  struct Job
+  {
+    TCollection_AsciiString Input;  //!< path to the input file
+    TCollection_AsciiString Output; //!< path to the output file defining the output format
+    TCollection_AsciiString Config; //!< configuration file of the job, empty - configuration of the batch
+    Status                  State = Status_NotStarted; //!< result of the job
+    Standard_Real           ReadTime  = 0.0; //!< time of reading in seconds
+    Standard_Real           WriteTime = 0.0; //!< time of writing in seconds
+    Standard_Size           MemoryPeak = 0;  //!< peak private memory of the process during the job
+    TCollection_AsciiString Message;         //!< description of the failure
+  };
+
+public:
+  //! Creates the converter.
+  //! @param[in] theWrapper wrapper with the configuration of the batch; the wrapper is copied by every worker
+  Standard_EXPORT DE_BatchConverter(const Handle(DE_Wrapper)& theWrapper);
+
+  //! Returns the number of worker threads, 0 - number of logical processors.
+  Standard_Integer NbThreads() const { return myNbThreads; }
+
+  //! Sets the number of worker threads, 0 - number of logical processors.
+  void SetNbThreads(const Standard_Integer theNbThreads) { myNbThreads = theNbThreads; }
+
+  //! Returns the timeout of a job in seconds, 0 - no timeout.
+  Standard_Real Timeout() const { return myTimeout; }
+
+  //! Sets the timeout of a job in seconds, 0 - no timeout.
+  //! The timeout is checked only when the provider polls the progress indicator.
+  void SetTimeout(const Standard_Real theTimeout) { myTimeout = theTimeout; }
+
+  //! Returns the limit of the private memory growth of the process in bytes, 0 - no limit.
+  Standard_Size ProcessMemoryLimit() const { return myProcessMemoryLimit; }
+
+  //! Sets the limit of the private memory growth of the process since the start of a job
+  //! in bytes, 0 - no limit; when it is exceeded, the job is interrupted.
+  void SetProcessMemoryLimit(const Standard_Size theLimit) { myProcessMemoryLimit = theLimit; }
+
+  //! Adds the job.
+  //! @param[in] theInput path to the input file
+  //! @param[in] theOutput path to the output file
+  //! @param[in] theConfig configuration file of the job, empty - configuration of the batch
+  Standard_EXPORT void AddJob(const TCollection_AsciiString& theInput,
+                              const TCollection_AsciiString& theOutput,
+                              const TCollection_AsciiString& theConfig = TCollection_AsciiString());
+
+  //! Adds the jobs listed in the manifest file.
+  //! Each line of the manifest defines one job by tab-separated input path, output path
+  //! and optional configuration file; empty lines and lines starting with '#' are skipped.
+  //! @param[in] thePath path to the manifest file
+  //! @return FALSE if the file cannot be read or contains lines without output path
+  Standard_EXPORT bool LoadManifest(const TCollection_AsciiString& thePath);
+
+  //! Removes all jobs.
+  void Clear() { myJobs.Clear(); }
+
+  //! Returns the jobs with their results.
+  const NCollection_Sequence<Job>& Jobs() const { return myJobs; }
+
+  //! Executes all jobs.
+  //! @param[in] theProgress progress indicator; its interruption stops the remaining jobs
+  //! @return number of successfully converted files
+  Standard_EXPORT Standard_Integer Perform(const Message_ProgressRange& theProgress = Message_ProgressRange());
+
+  //! Returns the elapsed time of the last Perform() call in seconds.
+  Standard_Real ElapsedTime() const { return myElapsedTime; }
+
+  //! Returns the report of the last Perform() call in JSON format.
+  Standard_EXPORT TCollection_AsciiString Report() const;
+
+  //! Writes the report of the last Perform() call in JSON format.
+  //! @param[in] thePath path to the report file
+  //! @return FALSE if the file cannot be written
+  Standard_EXPORT bool WriteReport(const TCollection_AsciiString& thePath) const;
+
+  //! Returns the string name of the status used by the report.
+  Standard_EXPORT static Standard_CString StatusName(const Status theStatus);
+
+private:
+  Handle(DE_Wrapper)        myWrapper;            //!< configuration of the batch
+  NCollection_Sequence<Job> myJobs;               //!< jobs
+  Standard_Integer          myNbThreads;          //!< number of worker threads
+  Standard_Real             myTimeout;            //!< timeout of a job in seconds
+  Standard_Size             myProcessMemoryLimit; //!< memory growth limit of the process in bytes
+  Standard_Real             myElapsedTime;        //!< elapsed time of the last batch
+};
+
+#endif // _DE_BatchConverter_HeaderFile
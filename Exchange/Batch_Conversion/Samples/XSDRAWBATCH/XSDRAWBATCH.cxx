@@ -0,0 +1,246 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#include <XSDRAWBATCH.hxx>
+
+#include <DE_BatchConverter.hxx>
+#include <DE_ConfigurationNode.hxx>
+#include <DE_Provider.hxx>
+#include <DE_Wrapper.hxx>
+#include <Draw.hxx>
+#include <Draw_PluginMacro.hxx>
+#include <Message_ProgressScope.hxx>
+#include <NCollection_Buffer.hxx>
+#include <NCollection_Sequence.hxx>
+#include <OSD.hxx>
+#include <OSD_Path.hxx>
+#include <OSD_Timer.hxx>
+
+#include <cstring>
+
+namespace
+{
+//! Blocks allocated by the jobs of the memory check; they are kept until the end of the check
+//! to emulate the heap which is not returned to the system after the job.
+static NCollection_Sequence<Handle(NCollection_Buffer)>& retainedBlocks()
+{
+  static NCollection_Sequence<Handle(NCollection_Buffer)> THE_BLOCKS;
+  return THE_BLOCKS;
+}
+
+//! Provider of the memory check: reading of the file "<size>.bmem" allocates <size> MiB,
+//! keeps them allocated and polls the progress indicator for 1.2 seconds.
+//! Files are never opened, writing does nothing.
+class XSDRAWBATCH_MemoryProvider : public DE_Provider
+{
+  DEFINE_STANDARD_RTTI_INLINE(XSDRAWBATCH_MemoryProvider, DE_Provider)
+public:
+  XSDRAWBATCH_MemoryProvider(const Handle(DE_ConfigurationNode)& theNode)
+      : DE_Provider(theNode)
+  {
+  }
+
+  virtual bool Read(const TCollection_AsciiString&  thePath,
+                    const Handle(TDocStd_Document)& theDocument,
+                    Handle(XSControl_WorkSession)&,
+                    const Message_ProgressRange& theProgress) Standard_OVERRIDE
+  {
+    return Read(thePath, theDocument, theProgress);
+  }
+
+  virtual bool Read(const TCollection_AsciiString& thePath,
+                    const Handle(TDocStd_Document)&,
+                    const Message_ProgressRange& theProgress) Standard_OVERRIDE
+  {
+    const TCollection_AsciiString aSize = OSD_Path(thePath).Name();
+    if (!aSize.IsIntegerValue())
+    {
+      return false;
+    }
+    const Standard_Size        aNbBytes = Standard_Size(aSize.IntegerValue()) * 1024 * 1024;
+    Handle(NCollection_Buffer) aBlock =
+      new NCollection_Buffer(NCollection_BaseAllocator::CommonBaseAllocator(), aNbBytes);
+    if (aBlock->IsEmpty())
+    {
+      return false;
+    }
+    // pages are touched to be committed by the system
+    memset(aBlock->ChangeData(), 1, aNbBytes);
+    retainedBlocks().Append(aBlock);
+
+    Message_ProgressScope aPS(theProgress, "Allocating", 60);
+    for (; aPS.More(); aPS.Next())
+    {
+      if (aPS.UserBreak())
+      {
+        return false;
+      }
+      OSD::MilliSecSleep(20);
+    }
+    return true;
+  }
+
+  virtual bool Write(const TCollection_AsciiString&,
+                     const Handle(TDocStd_Document)&,
+                     Handle(XSControl_WorkSession)&,
+                     const Message_ProgressRange&) Standard_OVERRIDE
+  {
+    return true;
+  }
+
+  virtual bool Write(const TCollection_AsciiString&,
+                     const Handle(TDocStd_Document)&,
+                     const Message_ProgressRange&) Standard_OVERRIDE
+  {
+    return true;
+  }
+
+  virtual TCollection_AsciiString GetFormat() const Standard_OVERRIDE { return "BMEM"; }
+
+  virtual TCollection_AsciiString GetVendor() const Standard_OVERRIDE { return "OCC"; }
+};
+
+//! Configuration node of XSDRAWBATCH_MemoryProvider.
+class XSDRAWBATCH_MemoryNode : public DE_ConfigurationNode
+{
+  DEFINE_STANDARD_RTTI_INLINE(XSDRAWBATCH_MemoryNode, DE_ConfigurationNode)
+public:
+  virtual bool Load(const Handle(DE_ConfigurationContext)&) Standard_OVERRIDE { return true; }
+
+  virtual TCollection_AsciiString Save() const Standard_OVERRIDE
+  {
+    return TCollection_AsciiString();
+  }
+
+  virtual Handle(DE_ConfigurationNode) Copy() const Standard_OVERRIDE
+  {
+    return new XSDRAWBATCH_MemoryNode();
+  }
+
+  virtual Handle(DE_Provider) BuildProvider() Standard_OVERRIDE
+  {
+    return new XSDRAWBATCH_MemoryProvider(this);
+  }
+
+  virtual bool IsImportSupported() const Standard_OVERRIDE { return true; }
+
+  virtual bool IsExportSupported() const Standard_OVERRIDE { return true; }
+
+  virtual TCollection_AsciiString GetFormat() const Standard_OVERRIDE { return "BMEM"; }
+
+  virtual TCollection_AsciiString GetVendor() const Standard_OVERRIDE { return "OCC"; }
+
+  virtual TColStd_ListOfAsciiString GetExtensions() const Standard_OVERRIDE
+  {
+    TColStd_ListOfAsciiString anExt;
+    anExt.Append("bmem");
+    return anExt;
+  }
+};
+} // namespace
+
+//=======================================================================
+// function : BatchTestMemoryBase
+// purpose  :
+//=======================================================================
+static Standard_Integer BatchTestMemoryBase(Draw_Interpretor& theDI,
+                                            Standard_Integer  theNbArgs,
+                                            const char**      theArgVec)
+{
+  Standard_Integer aLimitMiB = 256;
+  if (theNbArgs == 2)
+  {
+    aLimitMiB = Draw::Atoi(theArgVec[1]);
+  }
+  if (theNbArgs > 2 || aLimitMiB < 16)
+  {
+    theDI << "Syntax error: wrong arguments\n";
+    return 1;
+  }
+
+  Handle(DE_Wrapper) aWrapper = new DE_Wrapper();
+  aWrapper->Bind(new XSDRAWBATCH_MemoryNode());
+  Handle(DE_BatchConverter) aConverter = new DE_BatchConverter(aWrapper);
+  aConverter->SetNbThreads(1);
+  aConverter->SetProcessMemoryLimit(Standard_Size(aLimitMiB) * 1024 * 1024);
+
+  // a large job within the limit, a small job which exceeds the limit only together
+  // with the memory retained by the large one, and a job exceeding the limit by itself
+  const Standard_Integer aSizes[3] = {aLimitMiB * 3 / 4, aLimitMiB / 2, aLimitMiB * 5 / 4};
+  const DE_BatchConverter::Status anExpected[3] = {DE_BatchConverter::Status_Done,
+                                                   DE_BatchConverter::Status_Done,
+                                                   DE_BatchConverter::Status_MemoryLimit};
+  for (Standard_Integer aJobIter = 0; aJobIter < 3; ++aJobIter)
+  {
+    const TCollection_AsciiString aName = TCollection_AsciiString(aSizes[aJobIter]) + ".bmem";
+    aConverter->AddJob(aName, aName);
+  }
+  aConverter->Perform();
+  retainedBlocks().Clear();
+
+  bool             isOk     = true;
+  Standard_Integer aJobIter = 0;
+  for (NCollection_Sequence<DE_BatchConverter::Job>::Iterator aJobSeqIter(aConverter->Jobs());
+       aJobSeqIter.More();
+       aJobSeqIter.Next(), ++aJobIter)
+  {
+    const DE_BatchConverter::Job& aJob = aJobSeqIter.Value();
+    if (aJob.State != anExpected[aJobIter])
+    {
+      theDI << "Error: job of " << aSizes[aJobIter] << " MiB has status '"
+            << DE_BatchConverter::StatusName(aJob.State) << "' instead of '"
+            << DE_BatchConverter::StatusName(anExpected[aJobIter]) << "'\n";
+      isOk = false;
+    }
+  }
+  if (isOk)
+  {
+    theDI << "OK\n";
+  }
+  return 0;
+}
+
+//=======================================================================
+// function : InitCommands
+// purpose  :
+//=======================================================================
+void XSDRAWBATCH::InitCommands(Draw_Interpretor& theCommands)
+{
+  const char* aGroup = "DE_BatchConverter checks";
+  theCommands.Add("BatchTestMemoryBase",
+                  "BatchTestMemoryBase [limitMiB=256]"
+                  "\n\t\t: Runs a large job, a small one and a job exceeding the memory limit"
+                  "\n\t\t: in a single worker; memory of every job is kept allocated till the end."
+                  "\n\t\t: Checks that the small job is not interrupted by the memory retained"
+                  "\n\t\t: by the large one, while the last job is interrupted by the limit.",
+                  __FILE__,
+                  BatchTestMemoryBase,
+                  aGroup);
+}
+
+//==============================================================================
+// XSDRAWBATCH::Factory
+//==============================================================================
+void XSDRAWBATCH::Factory(Draw_Interpretor& theDI)
+{
+  XSDRAWBATCH::InitCommands(theDI);
+
+#ifdef DEB
+  std::cout << "Draw Plugin : All TKXSDRAWBATCH commands are loaded" << std::endl;
+#endif
+}
+
+// Declare entry point PLUGINFACTORY
+DPLUGIN(XSDRAWBATCH)
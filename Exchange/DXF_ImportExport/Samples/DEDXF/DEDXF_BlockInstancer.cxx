@@ -0,0 +1,543 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#include <DEDXF_BlockInstancer.hxx>
+
+#include <BRep_Tool.hxx>
+#include <BRepAdaptor_Curve.hxx>
+#include <BRepAdaptor_Surface.hxx>
+#include <BRepTools.hxx>
+#include <Message_ProgressScope.hxx>
+#include <NCollection_DataMap.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Precision.hxx>
+#include <Quantity_ColorRGBA.hxx>
+#include <TColStd_HSequenceOfExtendedString.hxx>
+#include <TDataStd_Name.hxx>
+#include <TDataStd_TreeNode.hxx>
+#include <TDF_LabelMap.hxx>
+#include <TDF_LabelSequence.hxx>
+#include <TDF_Tool.hxx>
+#include <TNaming_Builder.hxx>
+#include <TopExp.hxx>
+#include <TopoDS.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <XCAFDoc.hxx>
+#include <XCAFDoc_ColorTool.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_LayerTool.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+
+namespace
+{
+//! Number of intervals sampled along curves and in each direction of surfaces.
+static const int THE_NB_SAMPLES = 8;
+
+//! Returns the name of the label as UTF-8 string.
+static TCollection_AsciiString labelName(const TDF_Label& theLabel)
+{
+  Handle(TDataStd_Name) aName;
+  return theLabel.FindAttribute(TDataStd_Name::GetID(), aName)
+           ? TCollection_AsciiString(aName->Get())
+           : TCollection_AsciiString();
+}
+
+//! Checks if two points coincide with the tolerance.
+static bool isSamePoint(const gp_Pnt& thePnt1, const gp_Pnt& thePnt2, const Standard_Real theTol)
+{
+  return thePnt1.SquareDistance(thePnt2) <= theTol * theTol;
+}
+
+//! Checks if two locations define the same transformation with the tolerance.
+static bool isSameLocation(const TopLoc_Location& theLoc1,
+                           const TopLoc_Location& theLoc2,
+                           const Standard_Real    theTol)
+{
+  if (theLoc1.IsEqual(theLoc2))
+  {
+    return true;
+  }
+  const gp_Trsf aTrsf1 = theLoc1.Transformation();
+  const gp_Trsf aTrsf2 = theLoc2.Transformation();
+  for (int aRow = 1; aRow <= 3; ++aRow)
+  {
+    for (int aCol = 1; aCol <= 4; ++aCol)
+    {
+      if (Abs(aTrsf1.Value(aRow, aCol) - aTrsf2.Value(aRow, aCol)) > theTol)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//! Checks if two sub-shapes of the same type have the same geometry with the tolerance.
+static bool isSameSubShape(const TopoDS_Shape& theShape1,
+                           const TopoDS_Shape& theShape2,
+                           const Standard_Real theTol)
+{
+  if (theShape1.ShapeType() != theShape2.ShapeType()
+      || theShape1.Orientation() != theShape2.Orientation())
+  {
+    return false;
+  }
+  switch (theShape1.ShapeType())
+  {
+    case TopAbs_VERTEX: {
+      return isSamePoint(BRep_Tool::Pnt(TopoDS::Vertex(theShape1)),
+                         BRep_Tool::Pnt(TopoDS::Vertex(theShape2)),
+                         theTol);
+    }
+    case TopAbs_EDGE: {
+      const TopoDS_Edge& anEdge1 = TopoDS::Edge(theShape1);
+      const TopoDS_Edge& anEdge2 = TopoDS::Edge(theShape2);
+      if (BRep_Tool::Degenerated(anEdge1) || BRep_Tool::Degenerated(anEdge2))
+      {
+        return BRep_Tool::Degenerated(anEdge1) == BRep_Tool::Degenerated(anEdge2);
+      }
+      if (!BRep_Tool::IsGeometric(anEdge1) || !BRep_Tool::IsGeometric(anEdge2))
+      {
+        return BRep_Tool::IsGeometric(anEdge1) == BRep_Tool::IsGeometric(anEdge2);
+      }
+      const BRepAdaptor_Curve aCurve1(anEdge1);
+      const BRepAdaptor_Curve aCurve2(anEdge2);
+      if (aCurve1.GetType() != aCurve2.GetType())
+      {
+        return false;
+      }
+      const Standard_Real aStep1 =
+        (aCurve1.LastParameter() - aCurve1.FirstParameter()) / THE_NB_SAMPLES;
+      const Standard_Real aStep2 =
+        (aCurve2.LastParameter() - aCurve2.FirstParameter()) / THE_NB_SAMPLES;
+      for (int aSampleIter = 0; aSampleIter <= THE_NB_SAMPLES; ++aSampleIter)
+      {
+        if (!isSamePoint(aCurve1.Value(aCurve1.FirstParameter() + aSampleIter * aStep1),
+                         aCurve2.Value(aCurve2.FirstParameter() + aSampleIter * aStep2),
+                         theTol))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+    case TopAbs_FACE: {
+      const TopoDS_Face& aFace1 = TopoDS::Face(theShape1);
+      const TopoDS_Face& aFace2 = TopoDS::Face(theShape2);
+      TopLoc_Location    aLoc1, aLoc2;
+      if (BRep_Tool::Surface(aFace1, aLoc1).IsNull()
+          || BRep_Tool::Surface(aFace2, aLoc2).IsNull())
+      {
+        // mesh-only faces are compared node by node and triangle by triangle
+        const Handle(Poly_Triangulation)& aTris1 = BRep_Tool::Triangulation(aFace1, aLoc1);
+        const Handle(Poly_Triangulation)& aTris2 = BRep_Tool::Triangulation(aFace2, aLoc2);
+        if (aTris1.IsNull() || aTris2.IsNull() || aTris1->NbNodes() != aTris2->NbNodes()
+            || aTris1->NbTriangles() != aTris2->NbTriangles())
+        {
+          return false;
+        }
+        const gp_Trsf aTrsf1 = aLoc1.Transformation();
+        const gp_Trsf aTrsf2 = aLoc2.Transformation();
+        for (int aNodeIter = 1; aNodeIter <= aTris1->NbNodes(); ++aNodeIter)
+        {
+          if (!isSamePoint(aTris1->Node(aNodeIter).Transformed(aTrsf1),
+                           aTris2->Node(aNodeIter).Transformed(aTrsf2),
+                           theTol))
+          {
+            return false;
+          }
+        }
+        for (int aTriIter = 1; aTriIter <= aTris1->NbTriangles(); ++aTriIter)
+        {
+          int aNodes1[3], aNodes2[3];
+          aTris1->Triangle(aTriIter).Get(aNodes1[0], aNodes1[1], aNodes1[2]);
+          aTris2->Triangle(aTriIter).Get(aNodes2[0], aNodes2[1], aNodes2[2]);
+          if (aNodes1[0] != aNodes2[0] || aNodes1[1] != aNodes2[1] || aNodes1[2] != aNodes2[2])
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+      Standard_Real aUMin1, aUMax1, aVMin1, aVMax1, aUMin2, aUMax2, aVMin2, aVMax2;
+      BRepTools::UVBounds(aFace1, aUMin1, aUMax1, aVMin1, aVMax1);
+      BRepTools::UVBounds(aFace2, aUMin2, aUMax2, aVMin2, aVMax2);
+      const BRepAdaptor_Surface aSurf1(aFace1, Standard_False);
+      const BRepAdaptor_Surface aSurf2(aFace2, Standard_False);
+      if (aSurf1.GetType() != aSurf2.GetType())
+      {
+        return false;
+      }
+      // the boundaries are compared as edges, the grid covers the interior of the surface
+      for (int aUIter = 0; aUIter <= THE_NB_SAMPLES; ++aUIter)
+      {
+        const Standard_Real aU1 = aUMin1 + (aUMax1 - aUMin1) * aUIter / THE_NB_SAMPLES;
+        const Standard_Real aU2 = aUMin2 + (aUMax2 - aUMin2) * aUIter / THE_NB_SAMPLES;
+        for (int aVIter = 0; aVIter <= THE_NB_SAMPLES; ++aVIter)
+        {
+          const Standard_Real aV1 = aVMin1 + (aVMax1 - aVMin1) * aVIter / THE_NB_SAMPLES;
+          const Standard_Real aV2 = aVMin2 + (aVMax2 - aVMin2) * aVIter / THE_NB_SAMPLES;
+          if (!isSamePoint(aSurf1.Value(aU1, aV1), aSurf2.Value(aU2, aV2), theTol))
+          {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+    default: {
+      // wires, shells, solids and compounds are compared through their sub-shapes
+      return true;
+    }
+  }
+}
+} // namespace
+
+//=======================================================================
+// function : DEDXF_BlockInstancer
+// purpose  :
+//=======================================================================
+DEDXF_BlockInstancer::DEDXF_BlockInstancer()
+    : myTolerance(Precision::Confusion()),
+      myNbRedirected(0)
+{
+}
+
+//=======================================================================
+// function : Perform
+// purpose  :
+//=======================================================================
+int DEDXF_BlockInstancer::Perform(const Handle(TDocStd_Document)& theDocument,
+                                  const Message_ProgressRange&    theProgress)
+{
+  myDuplicates.Clear();
+  myNbRedirected = 0;
+  myShapeTool    = XCAFDoc_DocumentTool::ShapeTool(theDocument->Main());
+  myColorTool    = XCAFDoc_DocumentTool::ColorTool(theDocument->Main());
+  myLayerTool    = XCAFDoc_DocumentTool::LayerTool(theDocument->Main());
+
+  Message_ProgressScope aPS(theProgress, "Sharing DXF blocks", 4);
+  TDF_LabelSequence     aShapes;
+  myShapeTool->GetShapes(aShapes);
+
+  // only prototypes referenced by components are candidates, free shapes are kept as is
+  TDF_LabelMap aReferenced;
+  for (TDF_LabelSequence::Iterator aShapeIter(aShapes); aShapeIter.More(); aShapeIter.Next())
+  {
+    TDF_LabelSequence aComponents;
+    myShapeTool->GetComponents(aShapeIter.Value(), aComponents, Standard_False);
+    for (TDF_LabelSequence::Iterator aCompIter(aComponents); aCompIter.More(); aCompIter.Next())
+    {
+      TDF_Label aReferred;
+      if (XCAFDoc_ShapeTool::GetReferredShape(aCompIter.Value(), aReferred))
+      {
+        aReferenced.Add(aReferred);
+      }
+    }
+  }
+
+  // parts are grouped by name and number of sub-shapes, then compared with the group
+  NCollection_DataMap<TCollection_AsciiString, TDF_LabelSequence> aGroups;
+  for (TDF_LabelSequence::Iterator aShapeIter(aShapes); aShapeIter.More() && aPS.More();
+       aShapeIter.Next())
+  {
+    const TDF_Label& aLabel = aShapeIter.Value();
+    if (!aReferenced.Contains(aLabel) || XCAFDoc_ShapeTool::IsAssembly(aLabel))
+    {
+      continue;
+    }
+    const TopoDS_Shape aShape = XCAFDoc_ShapeTool::GetShape(aLabel);
+    if (aShape.IsNull())
+    {
+      continue;
+    }
+    TopTools_IndexedMapOfShape aSubShapes;
+    TopExp::MapShapes(aShape, aSubShapes);
+    const TCollection_AsciiString aKey = labelName(aLabel) + "|" + (int)aShape.ShapeType() + "|"
+                                         + aSubShapes.Extent();
+    if (!aGroups.IsBound(aKey))
+    {
+      aGroups.Bind(aKey, TDF_LabelSequence());
+    }
+    TDF_LabelSequence& aGroup  = aGroups.ChangeFind(aKey);
+    bool               isFound = false;
+    for (TDF_LabelSequence::Iterator aRepIter(aGroup); aRepIter.More() && !isFound;
+         aRepIter.Next())
+    {
+      if (isSamePart(aRepIter.Value(), aLabel))
+      {
+        myDuplicates.Bind(aLabel, aRepIter.Value());
+        isFound = true;
+      }
+    }
+    if (!isFound)
+    {
+      aGroup.Append(aLabel);
+    }
+  }
+  aPS.Next();
+
+  // assemblies of nested blocks become identical once their components are shared
+  for (bool isChanged = !aShapes.IsEmpty(); isChanged && aPS.More();)
+  {
+    isChanged = false;
+    aGroups.Clear();
+    for (TDF_LabelSequence::Iterator aShapeIter(aShapes); aShapeIter.More(); aShapeIter.Next())
+    {
+      const TDF_Label& aLabel = aShapeIter.Value();
+      if (!aReferenced.Contains(aLabel) || !XCAFDoc_ShapeTool::IsAssembly(aLabel)
+          || myDuplicates.IsBound(aLabel))
+      {
+        continue;
+      }
+      TDF_LabelSequence aComponents;
+      myShapeTool->GetComponents(aLabel, aComponents, Standard_False);
+      TCollection_AsciiString aKey = labelName(aLabel) + "|" + aComponents.Length();
+      for (TDF_LabelSequence::Iterator aCompIter(aComponents); aCompIter.More(); aCompIter.Next())
+      {
+        TDF_Label               aReferred;
+        TCollection_AsciiString anEntry;
+        XCAFDoc_ShapeTool::GetReferredShape(aCompIter.Value(), aReferred);
+        TDF_Tool::Entry(representative(aReferred), anEntry);
+        aKey += TCollection_AsciiString("|") + anEntry;
+      }
+      if (!aGroups.IsBound(aKey))
+      {
+        aGroups.Bind(aKey, TDF_LabelSequence());
+      }
+      TDF_LabelSequence& aGroup  = aGroups.ChangeFind(aKey);
+      bool               isFound = false;
+      for (TDF_LabelSequence::Iterator aRepIter(aGroup); aRepIter.More() && !isFound;
+           aRepIter.Next())
+      {
+        if (isSameAssembly(aRepIter.Value(), aLabel))
+        {
+          myDuplicates.Bind(aLabel, aRepIter.Value());
+          isFound = isChanged = true;
+        }
+      }
+      if (!isFound)
+      {
+        aGroup.Append(aLabel);
+      }
+    }
+  }
+  aPS.Next();
+  if (myDuplicates.IsEmpty() || !aPS.More())
+  {
+    return 0;
+  }
+
+  // redirect components of kept assemblies keeping their locations,
+  // the shapes of the components are rebuilt from the representatives
+  for (TDF_LabelSequence::Iterator aShapeIter(aShapes); aShapeIter.More(); aShapeIter.Next())
+  {
+    if (myDuplicates.IsBound(aShapeIter.Value()))
+    {
+      continue;
+    }
+    TDF_LabelSequence aComponents;
+    myShapeTool->GetComponents(aShapeIter.Value(), aComponents, Standard_False);
+    for (TDF_LabelSequence::Iterator aCompIter(aComponents); aCompIter.More(); aCompIter.Next())
+    {
+      TDF_Label                 aReferred;
+      Handle(TDataStd_TreeNode) aRefNode;
+      if (!XCAFDoc_ShapeTool::GetReferredShape(aCompIter.Value(), aReferred)
+          || !myDuplicates.IsBound(aReferred)
+          || !aCompIter.Value().FindAttribute(XCAFDoc::ShapeRefGUID(), aRefNode))
+      {
+        continue;
+      }
+      const TDF_Label           aRepresentative = representative(aReferred);
+      const TopLoc_Location     aLocation = XCAFDoc_ShapeTool::GetLocation(aCompIter.Value());
+      Handle(TDataStd_TreeNode) aMainNode =
+        TDataStd_TreeNode::Set(aRepresentative, XCAFDoc::ShapeRefGUID());
+      aRefNode->Remove();
+      aMainNode->Append(aRefNode);
+      TNaming_Builder aBuilder(aCompIter.Value());
+      aBuilder.Generated(XCAFDoc_ShapeTool::GetShape(aRepresentative).Located(aLocation));
+      ++myNbRedirected;
+    }
+  }
+  aPS.Next();
+
+  // duplicated assemblies are removed before the prototypes referenced by them
+  int          aNbRemoved = 0;
+  TDF_LabelMap aRemoved;
+  for (bool isRemoved = true; isRemoved;)
+  {
+    isRemoved = false;
+    for (TDF_LabelSequence::Iterator aShapeIter(aShapes); aShapeIter.More(); aShapeIter.Next())
+    {
+      const TDF_Label& aLabel = aShapeIter.Value();
+      if (myDuplicates.IsBound(aLabel) && !aRemoved.Contains(aLabel)
+          && myShapeTool->RemoveShape(aLabel, Standard_False))
+      {
+        aRemoved.Add(aLabel);
+        isRemoved = true;
+        ++aNbRemoved;
+      }
+    }
+  }
+  myShapeTool->UpdateAssemblies();
+  aPS.Next();
+  return aNbRemoved;
+}
+
+//=======================================================================
+// function : representative
+// purpose  :
+//=======================================================================
+TDF_Label DEDXF_BlockInstancer::representative(const TDF_Label& theLabel) const
+{
+  TDF_Label aLabel = theLabel;
+  while (const TDF_Label* aRep = myDuplicates.Seek(aLabel))
+  {
+    aLabel = *aRep;
+  }
+  return aLabel;
+}
+
+//=======================================================================
+// function : isSamePart
+// purpose  :
+//=======================================================================
+bool DEDXF_BlockInstancer::isSamePart(const TDF_Label& theLabel1, const TDF_Label& theLabel2) const
+{
+  if (!isSameAttributes(theLabel1, theLabel2))
+  {
+    return false;
+  }
+  const TopoDS_Shape aShape1 = XCAFDoc_ShapeTool::GetShape(theLabel1);
+  const TopoDS_Shape aShape2 = XCAFDoc_ShapeTool::GetShape(theLabel2);
+  TopTools_IndexedMapOfShape aSubShapes1, aSubShapes2;
+  TopExp::MapShapes(aShape1, aSubShapes1);
+  TopExp::MapShapes(aShape2, aSubShapes2);
+  if (aSubShapes1.Extent() != aSubShapes2.Extent())
+  {
+    return false;
+  }
+  if (!aShape1.IsEqual(aShape2))
+  {
+    for (int aSubIter = 1; aSubIter <= aSubShapes1.Extent(); ++aSubIter)
+    {
+      if (!isSameSubShape(aSubShapes1(aSubIter), aSubShapes2(aSubIter), myTolerance))
+      {
+        return false;
+      }
+    }
+  }
+
+  // colors and layers assigned to the entities of the block
+  TDF_LabelSequence aSubLabels1, aSubLabels2;
+  XCAFDoc_ShapeTool::GetSubShapes(theLabel1, aSubLabels1);
+  XCAFDoc_ShapeTool::GetSubShapes(theLabel2, aSubLabels2);
+  if (aSubLabels1.Length() != aSubLabels2.Length())
+  {
+    return false;
+  }
+  for (TDF_LabelSequence::Iterator aSubIter(aSubLabels1); aSubIter.More(); aSubIter.Next())
+  {
+    const int anIndex = aSubShapes1.FindIndex(XCAFDoc_ShapeTool::GetShape(aSubIter.Value()));
+    TDF_Label aSubLabel2;
+    if (anIndex == 0 || !myShapeTool->FindSubShape(theLabel2, aSubShapes2(anIndex), aSubLabel2)
+        || !isSameAttributes(aSubIter.Value(), aSubLabel2))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//=======================================================================
+// function : isSameAssembly
+// purpose  :
+//=======================================================================
+bool DEDXF_BlockInstancer::isSameAssembly(const TDF_Label& theLabel1,
+                                          const TDF_Label& theLabel2) const
+{
+  if (!isSameAttributes(theLabel1, theLabel2))
+  {
+    return false;
+  }
+  TDF_LabelSequence aComponents1, aComponents2;
+  myShapeTool->GetComponents(theLabel1, aComponents1, Standard_False);
+  myShapeTool->GetComponents(theLabel2, aComponents2, Standard_False);
+  if (aComponents1.Length() != aComponents2.Length())
+  {
+    return false;
+  }
+  for (int aCompIter = 1; aCompIter <= aComponents1.Length(); ++aCompIter)
+  {
+    const TDF_Label& aComponent1 = aComponents1.Value(aCompIter);
+    const TDF_Label& aComponent2 = aComponents2.Value(aCompIter);
+    TDF_Label        aReferred1, aReferred2;
+    XCAFDoc_ShapeTool::GetReferredShape(aComponent1, aReferred1);
+    XCAFDoc_ShapeTool::GetReferredShape(aComponent2, aReferred2);
+    if (representative(aReferred1) != representative(aReferred2)
+        || !isSameLocation(XCAFDoc_ShapeTool::GetLocation(aComponent1),
+                           XCAFDoc_ShapeTool::GetLocation(aComponent2),
+                           myTolerance)
+        || !isSameAttributes(aComponent1, aComponent2))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//=======================================================================
+// function : isSameAttributes
+// purpose  :
+//=======================================================================
+bool DEDXF_BlockInstancer::isSameAttributes(const TDF_Label& theLabel1,
+                                            const TDF_Label& theLabel2) const
+{
+  if (labelName(theLabel1) != labelName(theLabel2)
+      || myColorTool->IsVisible(theLabel1) != myColorTool->IsVisible(theLabel2))
+  {
+    return false;
+  }
+
+  const XCAFDoc_ColorType aColorTypes[3] = {XCAFDoc_ColorGen, XCAFDoc_ColorSurf, XCAFDoc_ColorCurv};
+  for (int aTypeIter = 0; aTypeIter < 3; ++aTypeIter)
+  {
+    Quantity_ColorRGBA aColor1, aColor2;
+    const bool hasColor1 = myColorTool->GetColor(theLabel1, aColorTypes[aTypeIter], aColor1);
+    const bool hasColor2 = myColorTool->GetColor(theLabel2, aColorTypes[aTypeIter], aColor2);
+    if (hasColor1 != hasColor2 || (hasColor1 && !aColor1.IsEqual(aColor2)))
+    {
+      return false;
+    }
+  }
+
+  Handle(TColStd_HSequenceOfExtendedString) aLayers1, aLayers2;
+  myLayerTool->GetLayers(theLabel1, aLayers1);
+  myLayerTool->GetLayers(theLabel2, aLayers2);
+  const int aNbLayers1 = aLayers1.IsNull() ? 0 : aLayers1->Length();
+  const int aNbLayers2 = aLayers2.IsNull() ? 0 : aLayers2->Length();
+  if (aNbLayers1 != aNbLayers2)
+  {
+    return false;
+  }
+  for (int aLayerIter = 1; aLayerIter <= aNbLayers1; ++aLayerIter)
+  {
+    if (aLayers1->Value(aLayerIter) != aLayers2->Value(aLayerIter))
+    {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#ifndef _DEDXF_BlockInstancer_HeaderFile
+#define _DEDXF_BlockInstancer_HeaderFile
+
+#include <Message_ProgressRange.hxx>
+#include <TDF_LabelDataMap.hxx>
+#include <TDocStd_Document.hxx>
+
+class XCAFDoc_ColorTool;
+class XCAFDoc_LayerTool;
+class XCAFDoc_ShapeTool;
+
+//! Shares the shapes translated from the same DXF BLOCK between all its INSERTs.
+//! DXFCAFControl_Reader reads every INSERT as a component of an assembly;
+//! when the BLOCK is translated again for another INSERT (or for another batch of
+//! DEDXF_ParallelReader), the document contains several identical prototypes.
+//! The instancer finds referenced prototypes with the same name, geometry and attributes,
+//! redirects all components to a single prototype keeping their locations
+//! and removes the duplicates. Geometry is compared by sampling curves and surfaces
+//! with the tolerance, triangulations are compared node by node. Assemblies produced by nested BLOCKs and MINSERT arrays
+//! are merged bottom-up once their components refer to the same prototypes.
+//! Free shapes of the document are never removed.
+//! Shapes of redirected components and their assemblies are rebuilt.
+class DEDXF_BlockInstancer
+{
+public:
+  //! Creates the instancer.
+  Standard_EXPORT DEDXF_BlockInstancer();
+
+  //! Sets the tolerance of the comparison of geometry and locations.
+  void SetTolerance(const Standard_Real theTolerance) { myTolerance = theTolerance; }
+
+  //! Returns the tolerance of the comparison of geometry and locations.
+  Standard_Real Tolerance() const { return myTolerance; }
+
+  //! Merges duplicated prototypes of the document.
+  //! @param[in] theDocument document to process
+  //! @param[in] theProgress progress indicator
+  //! @return number of removed prototypes
+  Standard_EXPORT int Perform(const Handle(TDocStd_Document)& theDocument,
+                              const Message_ProgressRange& theProgress = Message_ProgressRange());
+
+  //! Returns the number of components redirected by the last Perform().
+  int NbRedirected() const { return myNbRedirected; }
+
+private:
+  //! Returns the representative of the label.
+  TDF_Label representative(const TDF_Label& theLabel) const;
+
+  //! Checks if the simple shapes of the labels have the same geometry and sub-shape attributes.
+  bool isSamePart(const TDF_Label& theLabel1, const TDF_Label& theLabel2) const;
+
+  //! Checks if the assemblies have components with the same prototypes, locations and attributes.
+  bool isSameAssembly(const TDF_Label& theLabel1, const TDF_Label& theLabel2) const;
+
+  //! Checks if the labels have the same name, colors and layers.
+  bool isSameAttributes(const TDF_Label& theLabel1, const TDF_Label& theLabel2) const;
+
+private:
+  Handle(XCAFDoc_ShapeTool) myShapeTool;    //!< shape tool of the processed document
+  Handle(XCAFDoc_ColorTool) myColorTool;    //!< color tool of the processed document
+  Handle(XCAFDoc_LayerTool) myLayerTool;    //!< layer tool of the processed document
+  TDF_LabelDataMap          myDuplicates;   //!< map of duplicates to their representatives
+  Standard_Real             myTolerance;    //!< tolerance of the comparison
+  int                       myNbRedirected; //!< number of redirected components
+};
+
+#endif // _DEDXF_BlockInstancer_HeaderFile
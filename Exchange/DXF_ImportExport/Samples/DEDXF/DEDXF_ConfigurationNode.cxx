@@ -17,10 +17,13 @@
 #include <DE_ConfigurationContext.hxx>
 #include <DE_PluginHolder.hxx>
 #include <DEDXF_Provider.hxx>
+#include <DEDXF_Tokenizer.hxx>
 #include <Standard_Version.hxx>
 
 #include <TKDEDXF.hxx>
 
+#include <string.h>
+
 IMPLEMENT_STANDARD_RTTIEXT(DEDXF_ConfigurationNode, DE_ConfigurationNode)
 
 namespace
@@ -33,6 +36,26 @@ static const TCollection_AsciiString& THE_CONFIGURATION_SCOPE()
 
 // Wrapper to auto-load DE component
 DE_PluginHolder<DEDXF_ConfigurationNode> THE_OCCT_IGES_COMPONENT_PLUGIN;
+
+//! Reads the next line of ASCII content trimmed from spaces.
+//! @return false if the line is not complete within the buffer
+static bool nextLine(const char*              theData,
+                     const size_t             theSize,
+                     size_t&                  thePos,
+                     TCollection_AsciiString& theLine)
+{
+  const char* anEnd = static_cast<const char*>(memchr(theData + thePos, '\n', theSize - thePos));
+  if (anEnd == NULL)
+  {
+    return false;
+  }
+  const size_t aLineEnd = (size_t)(anEnd - theData);
+  theLine               = TCollection_AsciiString(theData + thePos, (int)(aLineEnd - thePos));
+  theLine.LeftAdjust();
+  theLine.RightAdjust();
+  thePos = aLineEnd + 1;
+  return true;
+}
 } // namespace
 
 //=======================================================================
@@ -42,6 +65,7 @@ DE_PluginHolder<DEDXF_ConfigurationNode> THE_OCCT_IGES_COMPONENT_PLUGIN;
 DEDXF_ConfigurationNode::DEDXF_ConfigurationNode()
     : DE_ConfigurationNode(),
       InternalParameters(DxfSection_ConfParameters()),
+      ProviderParameters(DEDXF_ProviderSection()),
       myIsValidReadLicense(Standard_True),
       myIsValidWriteLicense(Standard_True)
 {
@@ -54,6 +78,7 @@ DEDXF_ConfigurationNode::DEDXF_ConfigurationNode()
 DEDXF_ConfigurationNode::DEDXF_ConfigurationNode(const Handle(DEDXF_ConfigurationNode)& theNode)
     : DE_ConfigurationNode(theNode),
       InternalParameters(theNode->InternalParameters),
+      ProviderParameters(theNode->ProviderParameters),
       myIsValidReadLicense(theNode->myIsValidReadLicense),
       myIsValidWriteLicense(theNode->myIsValidWriteLicense)
 {
@@ -84,6 +109,16 @@ bool DEDXF_ConfigurationNode::Load(const Handle(DE_ConfigurationContext)& theRes
     theResource->StringVal("read.dxf.resource.name", InternalParameters.ReadResourceName, aScope);
   InternalParameters.ReadSequence =
     theResource->StringVal("read.dxf.sequence", InternalParameters.ReadSequence, aScope);
+  ProviderParameters.ReadParallelTokenizer =
+    theResource->BooleanVal("read.dxf.parallel.tokenizer",
+                            ProviderParameters.ReadParallelTokenizer,
+                            aScope);
+  ProviderParameters.ReadParallelMode =
+    theResource->BooleanVal("read.dxf.parallel.mode", ProviderParameters.ReadParallelMode, aScope);
+  ProviderParameters.ReadInstanceBlocks =
+    theResource->BooleanVal("read.dxf.instance.blocks",
+                            ProviderParameters.ReadInstanceBlocks,
+                            aScope);
 
   InternalParameters.WriteColorMode =
     theResource->BooleanVal("write.color.mode", InternalParameters.WriteColorMode, aScope);
@@ -98,6 +133,10 @@ bool DEDXF_ConfigurationNode::Load(const Handle(DE_ConfigurationContext)& theRes
     theResource->RealVal("write.dxf.deflection.factor",
                          InternalParameters.WriteDeflectionFactor,
                          aScope);
+  ProviderParameters.WriteStreaming =
+    theResource->BooleanVal("write.dxf.streaming", ProviderParameters.WriteStreaming, aScope);
+  ProviderParameters.WriteBinary =
+    theResource->BooleanVal("write.dxf.binary", ProviderParameters.WriteBinary, aScope);
   InternalParameters.WriteResourceName =
     theResource->StringVal("write.dxf.resource.name", InternalParameters.WriteResourceName, aScope);
   InternalParameters.WriteSequence =
@@ -166,6 +205,27 @@ TCollection_AsciiString DEDXF_ConfigurationNode::Save() const
   aResult += aScope + "read.dxf.sequence :\t " + InternalParameters.ReadSequence + "\n";
   aResult += "!\n";
 
+  aResult += "!\n";
+  aResult += "!Set read.dxf.parallel.tokenizer to tokenize the file in parallel and drop\n";
+  aResult += "!the content skipped by the reader (comments, thumbnail, disabled text and hatch)\n";
+  aResult += "!Default value: 0. Available values: 0, 1\n";
+  aResult += aScope + "read.dxf.parallel.tokenizer :\t " + ProviderParameters.ReadParallelTokenizer
+             + "\n";
+  aResult += "!\n";
+
+  aResult += "!\n";
+  aResult += "!Setting up parallel processing mode of entities transfer\n";
+  aResult += "!Default value: 0. Available values: 0, 1\n";
+  aResult += aScope + "read.dxf.parallel.mode :\t " + ProviderParameters.ReadParallelMode + "\n";
+  aResult += "!\n";
+
+  aResult += "!\n";
+  aResult += "!Set read.dxf.instance.blocks to share identical BLOCK prototypes between INSERTs\n";
+  aResult += "!Default value: 0. Available values: 0, 1\n";
+  aResult +=
+    aScope + "read.dxf.instance.blocks :\t " + ProviderParameters.ReadInstanceBlocks + "\n";
+  aResult += "!\n";
+
   aResult += "!\n";
   aResult += "!Write parameters:\n";
   aResult += "!\n";
@@ -202,6 +262,19 @@ TCollection_AsciiString DEDXF_ConfigurationNode::Save() const
     aScope + "write.dxf.deflection.factor :\t " + InternalParameters.WriteDeflectionFactor + "\n";
   aResult += "!\n";
 
+  aResult += "!\n";
+  aResult += "!Set write.dxf.streaming to write entities directly into the file (DXF R12)\n";
+  aResult += "!without building the intermediate model\n";
+  aResult += "!Default value: 0. Available values: 0, 1\n";
+  aResult += aScope + "write.dxf.streaming :\t " + ProviderParameters.WriteStreaming + "\n";
+  aResult += "!\n";
+
+  aResult += "!\n";
+  aResult += "!Set write.dxf.binary to write binary DXF\n";
+  aResult += "!Default value: 0. Available values: 0, 1\n";
+  aResult += aScope + "write.dxf.binary :\t " + ProviderParameters.WriteBinary + "\n";
+  aResult += "!\n";
+
   aResult += "!\n";
   aResult += "!Defines the name of the resource file\n";
   aResult += "!Default value: DXF. Available values: <string>\n";
@@ -310,3 +383,38 @@ TColStd_ListOfAsciiString DEDXF_ConfigurationNode::GetExtensions() const
   anExt.Append("dxf");
   return anExt;
 }
+
+//=======================================================================
+// function : CheckContent
+// purpose  :
+//=======================================================================
+bool DEDXF_ConfigurationNode::CheckContent(const Handle(NCollection_Buffer)& theBuffer) const
+{
+  if (theBuffer.IsNull() || theBuffer->Size() < 10)
+  {
+    return false;
+  }
+  const char*  aBytes = (const char*)theBuffer->Data();
+  const size_t aSize  = theBuffer->Size();
+  if (DEDXF_Tokenizer::IsBinaryContent(aBytes, aSize))
+  {
+    return true;
+  }
+  size_t aPos = 0;
+  if ((unsigned char)aBytes[0] == 0xEF && (unsigned char)aBytes[1] == 0xBB
+      && (unsigned char)aBytes[2] == 0xBF)
+  {
+    // UTF-8 byte order mark
+    aPos = 3;
+  }
+  // ASCII DXF starts with the first SECTION, optionally preceded by comments
+  TCollection_AsciiString aCode, aValue;
+  while (nextLine(aBytes, aSize, aPos, aCode) && nextLine(aBytes, aSize, aPos, aValue))
+  {
+    if (!aCode.IsEqual("999"))
+    {
+      return aCode.IsEqual("0") && aValue.IsEqual("SECTION");
+    }
+  }
+  return false;
+}
@@ -97,8 +97,29 @@ public:
   //! @return list of extensions
   Standard_EXPORT virtual TColStd_ListOfAsciiString GetExtensions() const Standard_OVERRIDE;
 
+  //! Checks the file content to verify a format:
+  //! the sentinel of binary DXF or the first SECTION of ASCII DXF
+  //! @param[in] theBuffer read stream buffer to check content
+  //! @return Standard_True if file is supported by a current provider
+  Standard_EXPORT virtual bool CheckContent(const Handle(NCollection_Buffer)& theBuffer) const
+    Standard_OVERRIDE;
+
+public:
+  //! Parameters of the processing performed by DEDXF_Provider around DxfSection_ConfParameters
+  struct DEDXF_ProviderSection
+  {
+    // Read parameters
+    bool ReadParallelTokenizer = false; //<! Set if the content should be tokenized and filtered in parallel before reading
+    bool ReadParallelMode = false; //<! Set if entities should be transferred in parallel batches
+    bool ReadInstanceBlocks = false; //<! Set if identical prototypes of BLOCKs should be shared by INSERTs
+    // Write parameters
+    bool WriteStreaming = false; //<! Set if the document should be streamed without DxfSection_Model
+    bool WriteBinary = false; //<! Set if the file should be written in binary form
+  };
+
 public:
   DxfSection_ConfParameters InternalParameters; //<! Customize transfer process parameters
+  DEDXF_ProviderSection     ProviderParameters; //<! Customize processing performed by the provider
 
 private:
   Standard_Boolean myIsValidReadLicense;  //!< Valid flag of the license to read
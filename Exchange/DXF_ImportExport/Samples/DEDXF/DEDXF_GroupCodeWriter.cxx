@@ -0,0 +1,246 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#include <DEDXF_GroupCodeWriter.hxx>
+
+#include <Standard_CString.hxx>
+
+#include <string.h>
+
+namespace
+{
+//! Maximal length of the binary chunk.
+static const size_t THE_MAX_CHUNK_SIZE = 127;
+} // namespace
+
+//=======================================================================
+// function : Type
+// purpose  :
+//=======================================================================
+DEDXF_GroupCodeWriter::ValueType DEDXF_GroupCodeWriter::Type(const int theCode)
+{
+  if ((theCode >= 10 && theCode <= 59) || (theCode >= 110 && theCode <= 149)
+      || (theCode >= 210 && theCode <= 239) || (theCode >= 460 && theCode <= 469)
+      || (theCode >= 1010 && theCode <= 1059))
+  {
+    return ValueType_Real;
+  }
+  if ((theCode >= 60 && theCode <= 79) || (theCode >= 170 && theCode <= 179)
+      || (theCode >= 270 && theCode <= 289) || (theCode >= 370 && theCode <= 389)
+      || (theCode >= 400 && theCode <= 409) || (theCode >= 1060 && theCode <= 1070))
+  {
+    return ValueType_Int16;
+  }
+  if ((theCode >= 90 && theCode <= 99) || (theCode >= 420 && theCode <= 429)
+      || (theCode >= 440 && theCode <= 459) || theCode == 1071)
+  {
+    return ValueType_Int32;
+  }
+  if (theCode >= 160 && theCode <= 169)
+  {
+    return ValueType_Int64;
+  }
+  if (theCode >= 290 && theCode <= 299)
+  {
+    return ValueType_Bool;
+  }
+  if ((theCode >= 310 && theCode <= 319) || theCode == 1004)
+  {
+    return ValueType_Binary;
+  }
+  // 0-9, 100-109, 300-309, 320-369, 390-399, 410-419, 430-439, 470-481, 999, 1000-1009
+  return ValueType_String;
+}
+
+//=======================================================================
+// function : DEDXF_GroupCodeWriter
+// purpose  :
+//=======================================================================
+DEDXF_GroupCodeWriter::DEDXF_GroupCodeWriter(std::ostream& theStream,
+                                             const bool    theIsBinary,
+                                             const bool    theIsShortCodes)
+    : myStream(theStream),
+      myIsBinary(theIsBinary),
+      myIsShortCodes(theIsShortCodes)
+{
+}
+
+//=======================================================================
+// function : WriteSentinel
+// purpose  :
+//=======================================================================
+void DEDXF_GroupCodeWriter::WriteSentinel()
+{
+  if (myIsBinary)
+  {
+    myStream.write(BinarySentinel(), (std::streamsize)BinarySentinelLength());
+  }
+}
+
+//=======================================================================
+// function : String
+// purpose  :
+//=======================================================================
+void DEDXF_GroupCodeWriter::String(const int theCode, const char* theValue)
+{
+  code(theCode);
+  if (myIsBinary)
+  {
+    myStream.write(theValue, (std::streamsize)strlen(theValue) + 1);
+  }
+  else
+  {
+    myStream << theValue << "\n";
+  }
+}
+
+//=======================================================================
+// function : Real
+// purpose  :
+//=======================================================================
+void DEDXF_GroupCodeWriter::Real(const int theCode, const double theValue)
+{
+  code(theCode);
+  if (myIsBinary)
+  {
+    uint64_t aBits = 0;
+    memcpy(&aBits, &theValue, sizeof(aBits));
+    bytes(aBits, 8);
+    return;
+  }
+
+  char aBuffer[64];
+  Sprintf(aBuffer, "%.16g", theValue);
+  if (strpbrk(aBuffer, ".eEn") == NULL)
+  {
+    // keep the value recognizable as real
+    strcat(aBuffer, ".0");
+  }
+  myStream << aBuffer << "\n";
+}
+
+//=======================================================================
+// function : Integer
+// purpose  :
+//=======================================================================
+void DEDXF_GroupCodeWriter::Integer(const int theCode, const int64_t theValue)
+{
+  code(theCode);
+  if (!myIsBinary)
+  {
+    char aBuffer[32];
+    Sprintf(aBuffer, "%6lld", (long long)theValue);
+    myStream << aBuffer << "\n";
+    return;
+  }
+  switch (Type(theCode))
+  {
+    case ValueType_Bool:
+      bytes((uint64_t)theValue, 1);
+      break;
+    case ValueType_Int32:
+      bytes((uint64_t)theValue, 4);
+      break;
+    case ValueType_Int64:
+      bytes((uint64_t)theValue, 8);
+      break;
+    default:
+      bytes((uint64_t)theValue, 2);
+      break;
+  }
+}
+
+//=======================================================================
+// function : Point
+// purpose  :
+//=======================================================================
+void DEDXF_GroupCodeWriter::Point(const int theCode, const gp_XYZ& theValue)
+{
+  Real(theCode, theValue.X());
+  Real(theCode + 10, theValue.Y());
+  Real(theCode + 20, theValue.Z());
+}
+
+//=======================================================================
+// function : Binary
+// purpose  :
+//=======================================================================
+void DEDXF_GroupCodeWriter::Binary(const int theCode, const uint8_t* theData, const size_t theSize)
+{
+  static const char THE_HEX_DIGITS[] = "0123456789ABCDEF";
+  for (size_t anOffset = 0; anOffset < theSize; anOffset += THE_MAX_CHUNK_SIZE)
+  {
+    const size_t aSize =
+      theSize - anOffset < THE_MAX_CHUNK_SIZE ? theSize - anOffset : THE_MAX_CHUNK_SIZE;
+    code(theCode);
+    if (myIsBinary)
+    {
+      bytes(aSize, 1);
+      myStream.write(reinterpret_cast<const char*>(theData + anOffset), (std::streamsize)aSize);
+      continue;
+    }
+    char aBuffer[2 * THE_MAX_CHUNK_SIZE + 2];
+    for (size_t aByteIter = 0; aByteIter < aSize; ++aByteIter)
+    {
+      aBuffer[2 * aByteIter]     = THE_HEX_DIGITS[theData[anOffset + aByteIter] >> 4];
+      aBuffer[2 * aByteIter + 1] = THE_HEX_DIGITS[theData[anOffset + aByteIter] & 0x0F];
+    }
+    aBuffer[2 * aSize]     = '\n';
+    aBuffer[2 * aSize + 1] = '\0';
+    myStream << aBuffer;
+  }
+}
+
+//=======================================================================
+// function : code
+// purpose  :
+//=======================================================================
+void DEDXF_GroupCodeWriter::code(const int theCode)
+{
+  if (!myIsBinary)
+  {
+    char aBuffer[16];
+    Sprintf(aBuffer, "%3d\n", theCode);
+    myStream << aBuffer;
+  }
+  else if (!myIsShortCodes)
+  {
+    bytes((uint64_t)theCode, 2);
+  }
+  else if (theCode >= 0 && theCode < 255)
+  {
+    bytes((uint64_t)theCode, 1);
+  }
+  else
+  {
+    // extended group code of R12 binary files
+    bytes(255, 1);
+    bytes((uint64_t)theCode, 2);
+  }
+}
+
+//=======================================================================
+// function : bytes
+// purpose  :
+//=======================================================================
+void DEDXF_GroupCodeWriter::bytes(const uint64_t theValue, const int theNbBytes)
+{
+  char aBuffer[8];
+  for (int aByteIter = 0; aByteIter < theNbBytes; ++aByteIter)
+  {
+    aBuffer[aByteIter] = (char)((theValue >> (8 * aByteIter)) & 0xFF);
+  }
+  myStream.write(aBuffer, theNbBytes);
+}
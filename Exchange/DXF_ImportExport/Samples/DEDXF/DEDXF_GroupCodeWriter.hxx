@@ -0,0 +1,106 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#ifndef _DEDXF_GroupCodeWriter_HeaderFile
+#define _DEDXF_GroupCodeWriter_HeaderFile
+
+#include <gp_XYZ.hxx>
+#include <TCollection_AsciiString.hxx>
+
+#include <ostream>
+
+//! Writes DXF group code / value pairs into the stream in ASCII or binary form.
+//! The binary form starts with the sentinel "AutoCAD Binary DXF" and stores
+//! group codes as 1 byte (R12, codes above 254 are escaped by 255 and 2 bytes)
+//! or 2 bytes (R13 and later); values are stored according to the type of the group code:
+//! null-terminated strings, little-endian integers of 1, 2, 4 or 8 bytes and doubles,
+//! binary chunks prefixed by their length.
+class DEDXF_GroupCodeWriter
+{
+public:
+  //! Type of the value defined by the group code.
+  enum ValueType
+  {
+    ValueType_String, //!< text string
+    ValueType_Real,   //!< double-precision floating-point value
+    ValueType_Int16,  //!< 16-bit integer value
+    ValueType_Int32,  //!< 32-bit integer value
+    ValueType_Int64,  //!< 64-bit integer value
+    ValueType_Bool,   //!< boolean flag value stored as 1 byte
+    ValueType_Binary  //!< binary chunk, hexadecimal string in ASCII form
+  };
+
+  //! Returns the type of the value of the group code.
+  Standard_EXPORT static ValueType Type(const int theCode);
+
+  //! Returns the sentinel starting binary DXF files.
+  static const char* BinarySentinel() { return "AutoCAD Binary DXF\r\n\x1a"; }
+
+  //! Returns the length of the sentinel including the terminating null character.
+  static size_t BinarySentinelLength() { return 22; }
+
+public:
+  //! Creates the writer.
+  //! @param[in] theStream output stream, should be opened in binary mode
+  //! @param[in] theIsBinary flag to write binary DXF
+  //! @param[in] theIsShortCodes flag to write group codes as 1 byte (binary R12 files)
+  Standard_EXPORT DEDXF_GroupCodeWriter(std::ostream& theStream,
+                                        const bool    theIsBinary,
+                                        const bool    theIsShortCodes = false);
+
+  //! Returns true if binary DXF is written.
+  bool IsBinary() const { return myIsBinary; }
+
+  //! Writes the binary sentinel, does nothing for ASCII form.
+  Standard_EXPORT void WriteSentinel();
+
+  //! Writes the string value.
+  Standard_EXPORT void String(const int theCode, const char* theValue);
+
+  //! Writes the string value.
+  void String(const int theCode, const TCollection_AsciiString& theValue)
+  {
+    String(theCode, theValue.ToCString());
+  }
+
+  //! Writes the real value.
+  Standard_EXPORT void Real(const int theCode, const double theValue);
+
+  //! Writes the integer value with the size defined by the group code.
+  Standard_EXPORT void Integer(const int theCode, const int64_t theValue);
+
+  //! Writes the point as three pairs with codes theCode, theCode + 10 and theCode + 20.
+  Standard_EXPORT void Point(const int theCode, const gp_XYZ& theValue);
+
+  //! Writes the binary chunk, long data is split into several chunks with the same code.
+  Standard_EXPORT void Binary(const int theCode, const uint8_t* theData, const size_t theSize);
+
+  //! Returns true if all values have been written successfully.
+  bool IsDone() const { return !myStream.fail(); }
+
+private:
+  //! Writes the group code.
+  void code(const int theCode);
+
+  //! Writes little-endian bytes of the unsigned value.
+  void bytes(const uint64_t theValue, const int theNbBytes);
+
+private:
+  std::ostream& myStream;       //!< output stream
+  bool          myIsBinary;     //!< binary form flag
+  bool          myIsShortCodes; //!< 1-byte group codes flag
+};
+
+#endif // _DEDXF_GroupCodeWriter_HeaderFile
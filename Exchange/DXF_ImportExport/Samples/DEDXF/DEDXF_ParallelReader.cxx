@@ -0,0 +1,324 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#include <DEDXF_ParallelReader.hxx>
+
+#include <DEDXF_Preprocessor.hxx>
+#include <DXFCAFControl_Reader.hxx>
+#include <DxfControl_Controller.hxx>
+#include <DxfSection_ConfParameters.hxx>
+#include <Message.hxx>
+#include <Message_ProgressScope.hxx>
+#include <NCollection_Array1.hxx>
+#include <NCollection_DataMap.hxx>
+#include <NCollection_Map.hxx>
+#include <OSD_ThreadPool.hxx>
+#include <Standard_Failure.hxx>
+#include <TDataStd_Name.hxx>
+#include <TDocStd_Application.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_Editor.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+#include <XCAFDoc_VisMaterial.hxx>
+#include <XSControl_WorkSession.hxx>
+
+namespace
+{
+//! Batch of entities read by a single reader.
+struct DEDXF_Batch
+{
+  TCollection_AsciiString  Path;          //!< path of the batch file
+  Handle(TDocStd_Document) Document;      //!< document receiving the batch
+  IFSelect_ReturnStatus    ReadStatus;    //!< status of loading the batch file
+  bool                     IsTransferred; //!< flag indicating that the batch has been transferred
+  TCollection_AsciiString  Message;       //!< failure description
+
+  DEDXF_Batch()
+      : ReadStatus(IFSelect_RetVoid),
+        IsTransferred(false)
+  {
+  }
+};
+
+//! Collects the prototypes referred by components of the assemblies of the document.
+static void collectPrototypes(const Handle(XCAFDoc_ShapeTool)& theShapeTool,
+                              TDF_LabelSequence&               thePrototypes)
+{
+  NCollection_Map<TDF_Label> aPrototypes;
+  TDF_LabelSequence          aShapes;
+  theShapeTool->GetShapes(aShapes);
+  for (TDF_LabelSequence::Iterator aShapeIter(aShapes); aShapeIter.More(); aShapeIter.Next())
+  {
+    TDF_LabelSequence aComponents;
+    XCAFDoc_ShapeTool::GetComponents(aShapeIter.Value(), aComponents);
+    for (TDF_LabelSequence::Iterator aCompIter(aComponents); aCompIter.More(); aCompIter.Next())
+    {
+      TDF_Label aPrototype;
+      if (XCAFDoc_ShapeTool::GetReferredShape(aCompIter.Value(), aPrototype)
+          && aPrototypes.Add(aPrototype))
+      {
+        thePrototypes.Append(aPrototype);
+      }
+    }
+  }
+}
+
+//! Returns the key identifying the translated block across batches,
+//! empty string for unnamed prototypes which are never shared.
+static TCollection_AsciiString prototypeKey(const TDF_Label& thePrototype)
+{
+  Handle(TDataStd_Name) aName;
+  if (!thePrototype.FindAttribute(TDataStd_Name::GetID(), aName) || aName->Get().IsEmpty())
+  {
+    return TCollection_AsciiString();
+  }
+  // all batches translate the same BLOCKS section, so that the shapes differ only by identity
+  const TopoDS_Shape         aShape = XCAFDoc_ShapeTool::GetShape(thePrototype);
+  TopTools_IndexedMapOfShape aVertices;
+  if (!aShape.IsNull())
+  {
+    TopExp::MapShapes(aShape, TopAbs_VERTEX, aVertices);
+  }
+  return TCollection_AsciiString(aName->Get(), '?') + "|"
+         + (aShape.IsNull() ? -1 : (Standard_Integer)aShape.ShapeType()) + "|"
+         + aVertices.Extent();
+}
+
+//! Functor reading and transferring a single batch.
+class DEDXF_BatchFunctor
+{
+public:
+  DEDXF_BatchFunctor(NCollection_Array1<DEDXF_Batch>&                 theBatches,
+                     const NCollection_Array1<Message_ProgressRange>& theRanges,
+                     const Handle(DEDXF_ConfigurationNode)&           theNode)
+      : myBatches(theBatches),
+        myRanges(theRanges),
+        myNode(theNode)
+  {
+  }
+
+  void operator()(int theThreadIndex, int theIndex) const
+  {
+    (void)theThreadIndex;
+    DEDXF_Batch&          aBatch = myBatches.ChangeValue(theIndex);
+    Message_ProgressScope aPS(myRanges.Value(theIndex), NULL, 1);
+    if (aPS.UserBreak())
+    {
+      return;
+    }
+
+    try
+    {
+      // every batch has its own session and model, parameters are copied to not share them
+      Handle(XSControl_WorkSession) aWS = new XSControl_WorkSession();
+      aWS->SelectNorm("DXF");
+      DXFCAFControl_Reader aReader;
+      aReader.SetWS(aWS);
+      aReader.SetColorMode(myNode->InternalParameters.ReadColorMode);
+      aReader.SetNameMode(myNode->InternalParameters.ReadNameMode);
+      DxfSection_ConfParameters aParameters = myNode->InternalParameters;
+      aBatch.ReadStatus = aReader.ReadFile(aBatch.Path.ToCString(), aParameters);
+      if (aBatch.ReadStatus != IFSelect_RetDone)
+      {
+        aBatch.Message = "abandon, no model loaded";
+        return;
+      }
+      aReader.ClearShapes();
+      aReader.NbRootsForTransfer();
+      aBatch.IsTransferred = aReader.Transfer(aBatch.Document, aPS.Next());
+    }
+    catch (const Standard_Failure& theFailure)
+    {
+      aBatch.ReadStatus    = IFSelect_RetFail;
+      aBatch.IsTransferred = false;
+      aBatch.Message       = theFailure.GetMessageString();
+    }
+  }
+
+private:
+  NCollection_Array1<DEDXF_Batch>&                 myBatches;
+  const NCollection_Array1<Message_ProgressRange>& myRanges;
+  Handle(DEDXF_ConfigurationNode)                  myNode;
+};
+} // namespace
+
+//=======================================================================
+// function : DEDXF_ParallelReader
+// purpose  :
+//=======================================================================
+DEDXF_ParallelReader::DEDXF_ParallelReader(const Handle(DEDXF_ConfigurationNode)& theNode)
+    : myNode(theNode),
+      myNbBatches(0),
+      myNbReadBatches(0)
+{
+}
+
+//=======================================================================
+// function : Perform
+// purpose  :
+//=======================================================================
+bool DEDXF_ParallelReader::Perform(const TCollection_AsciiString&  thePath,
+                                   const Handle(TDocStd_Document)& theDocument,
+                                   const Message_ProgressRange&    theProgress)
+{
+  myNbReadBatches = 0;
+  Message_ProgressScope aPS(theProgress, "Reading DXF file in parallel", 10);
+
+  const Handle(OSD_ThreadPool)& aPool       = OSD_ThreadPool::DefaultPool();
+  const int                     aMaxBatches = myNbBatches > 0 ? myNbBatches
+                                                              : aPool->NbDefaultThreadsToLaunch();
+  DEDXF_Preprocessor            aPreprocessor;
+  TColStd_SequenceOfAsciiString aPaths;
+  if (aMaxBatches > 1 && aPreprocessor.Split(thePath, myNode, aMaxBatches, aPS.Next(2)))
+  {
+    aPaths = aPreprocessor.PartPaths();
+  }
+  else
+  {
+    if (DEDXF_Tokenizer::IsBinaryFile(thePath))
+    {
+      // the single batch still needs ASCII content
+      aPreprocessor.Perform(thePath, myNode);
+    }
+    aPaths.Append(aPreprocessor.ReadPath().IsEmpty() ? thePath : aPreprocessor.ReadPath());
+  }
+  aPreprocessor.ReleaseContent();
+  if (!aPS.More())
+  {
+    return false;
+  }
+
+  const int                                 aNbBatches = aPaths.Length();
+  NCollection_Array1<DEDXF_Batch>           aBatches(0, aNbBatches - 1);
+  NCollection_Array1<Message_ProgressRange> aRanges(0, aNbBatches - 1);
+  Handle(TDocStd_Application)               anApp = new TDocStd_Application();
+  Standard_Real                             aLengthUnit = 1.0;
+  XCAFDoc_DocumentTool::GetLengthUnit(theDocument, aLengthUnit);
+  Message_ProgressScope aTransferPS(aPS.Next(7), "Transferring batches", aNbBatches);
+  for (int aBatchIter = 0; aBatchIter < aNbBatches; ++aBatchIter)
+  {
+    DEDXF_Batch& aBatch = aBatches.ChangeValue(aBatchIter);
+    aBatch.Path         = aPaths.Value(aBatchIter + 1);
+    if (aNbBatches == 1)
+    {
+      aBatch.Document = theDocument;
+    }
+    else
+    {
+      anApp->NewDocument("BinXCAF", aBatch.Document);
+      XCAFDoc_DocumentTool::SetLengthUnit(aBatch.Document, aLengthUnit);
+    }
+    aRanges.SetValue(aBatchIter, aTransferPS.Next());
+  }
+
+  // registration of the norm is not thread-safe
+  DxfControl_Controller::Init();
+  const DEDXF_BatchFunctor aFunctor(aBatches, aRanges, myNode);
+  if (aNbBatches == 1)
+  {
+    aFunctor(0, 0);
+  }
+  else
+  {
+    OSD_ThreadPool::Launcher aLauncher(*aPool, aNbBatches);
+    aLauncher.Perform(0, aNbBatches, aFunctor);
+  }
+  aPreprocessor.RemoveTemporaryFiles();
+
+  // batch documents are merged in the file order, prototypes of blocks are copied once
+  bool                      isFailed  = !aTransferPS.More();
+  bool                      hasResult = false;
+  Handle(XCAFDoc_ShapeTool) aDstTool  = XCAFDoc_DocumentTool::ShapeTool(theDocument->Main());
+  NCollection_DataMap<TCollection_AsciiString, TDF_Label> aPrototypes;
+  NCollection_DataMap<Handle(XCAFDoc_VisMaterial), Handle(XCAFDoc_VisMaterial)> aVisMatMap;
+  Message_ProgressScope aMergePS(aPS.Next(), "Merging batches", aNbBatches);
+  for (int aBatchIter = 0; aBatchIter < aNbBatches; ++aBatchIter, aMergePS.Next())
+  {
+    DEDXF_Batch& aBatch = aBatches.ChangeValue(aBatchIter);
+    if (aBatch.ReadStatus != IFSelect_RetDone && !isFailed)
+    {
+      Message::SendFail() << "Error in the DEDXF_ParallelReader during reading the file "
+                          << thePath << "\t: batch " << (aBatchIter + 1) << " of " << aNbBatches
+                          << ", " << aBatch.Message;
+      isFailed = true;
+    }
+    if (aNbBatches == 1)
+    {
+      hasResult = aBatch.IsTransferred;
+      continue;
+    }
+    if (!isFailed && aBatch.IsTransferred)
+    {
+      Handle(XCAFDoc_ShapeTool) aSrcTool =
+        XCAFDoc_DocumentTool::ShapeTool(aBatch.Document->Main());
+
+      // prototypes copied from previous batches are reused by the cloned assemblies
+      NCollection_DataMap<TDF_Label, TDF_Label> aLabelMap;
+      NCollection_Map<TDF_Label>                aReused;
+      TDF_LabelSequence                         aBatchPrototypes;
+      collectPrototypes(aSrcTool, aBatchPrototypes);
+      for (TDF_LabelSequence::Iterator aProtoIter(aBatchPrototypes); aProtoIter.More();
+           aProtoIter.Next())
+      {
+        const TDF_Label* aTarget = aPrototypes.Seek(prototypeKey(aProtoIter.Value()));
+        if (aTarget != NULL)
+        {
+          aLabelMap.Bind(aProtoIter.Value(), *aTarget);
+          aReused.Add(aProtoIter.Value());
+        }
+      }
+
+      TDF_LabelSequence aLabels;
+      aSrcTool->GetFreeShapes(aLabels);
+      for (TDF_LabelSequence::Iterator aLabelIter(aLabels); aLabelIter.More(); aLabelIter.Next())
+      {
+        if (!XCAFDoc_Editor::CloneShapeLabel(aLabelIter.Value(), aSrcTool, aDstTool, aLabelMap)
+               .IsNull())
+        {
+          hasResult = true;
+        }
+      }
+      for (NCollection_DataMap<TDF_Label, TDF_Label>::Iterator aMapIter(aLabelMap);
+           aMapIter.More();
+           aMapIter.Next())
+      {
+        if (!aReused.Contains(aMapIter.Key()))
+        {
+          XCAFDoc_Editor::CloneMetaData(aMapIter.Key(), aMapIter.Value(), &aVisMatMap);
+        }
+      }
+      for (TDF_LabelSequence::Iterator aProtoIter(aBatchPrototypes); aProtoIter.More();
+           aProtoIter.Next())
+      {
+        const TCollection_AsciiString aKey    = prototypeKey(aProtoIter.Value());
+        const TDF_Label*              aTarget = aLabelMap.Seek(aProtoIter.Value());
+        if (!aKey.IsEmpty() && aTarget != NULL && !aPrototypes.IsBound(aKey))
+        {
+          aPrototypes.Bind(aKey, *aTarget);
+        }
+      }
+    }
+    anApp->Close(aBatch.Document);
+  }
+  if (isFailed)
+  {
+    return false;
+  }
+  aDstTool->UpdateAssemblies();
+  myNbReadBatches = aNbBatches;
+  return hasResult;
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#ifndef _DEDXF_ParallelReader_HeaderFile
+#define _DEDXF_ParallelReader_HeaderFile
+
+#include <DEDXF_ConfigurationNode.hxx>
+#include <Message_ProgressRange.hxx>
+#include <TDocStd_Document.hxx>
+
+//! Reads the DXF file into XDE document transferring entities in parallel.
+//! DEDXF_Preprocessor splits ENTITIES section of the file into contiguous batches
+//! of independent entities sharing HEADER, TABLES, BLOCKS and OBJECTS sections.
+//! Every batch is read and transferred by its own DXFCAFControl_Reader and work session
+//! into a separate document on the thread pool; the free shapes of the batch documents
+//! are then copied into the target document with their names, colors and layers
+//! in the order of batches, so that the result does not depend on the scheduling of threads.
+//! Blocks are translated by every batch referring to them, but their prototypes are copied
+//! into the target document only once: a prototype of a later batch with the same name,
+//! shape type and number of vertices as an already copied one is replaced by the latter.
+//! Files which cannot be split are read sequentially.
+class DEDXF_ParallelReader
+{
+public:
+  //! Creates the reader.
+  //! @param[in] theNode configuration of the reading
+  Standard_EXPORT DEDXF_ParallelReader(const Handle(DEDXF_ConfigurationNode)& theNode);
+
+  //! Sets the maximal number of batches, 0 means the number of threads of the default pool.
+  void SetNbBatches(const int theNbBatches) { myNbBatches = theNbBatches; }
+
+  //! Reads the file into the document.
+  //! @param[in] thePath path to the DXF file
+  //! @param[in] theDocument document to fill
+  //! @param[in] theProgress progress indicator
+  //! @return false if the file cannot be read or no data has been transferred
+  Standard_EXPORT bool Perform(const TCollection_AsciiString&  thePath,
+                               const Handle(TDocStd_Document)& theDocument,
+                               const Message_ProgressRange& theProgress = Message_ProgressRange());
+
+  //! Returns the number of batches read by the last Perform(), 1 for sequential reading.
+  int NbReadBatches() const { return myNbReadBatches; }
+
+private:
+  Handle(DEDXF_ConfigurationNode) myNode;          //!< configuration of the reading
+  int                             myNbBatches;     //!< maximal number of batches
+  int                             myNbReadBatches; //!< number of batches of the last Perform()
+};
+
+#endif // _DEDXF_ParallelReader_HeaderFile
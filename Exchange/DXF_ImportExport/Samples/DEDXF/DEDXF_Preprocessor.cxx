@@ -0,0 +1,428 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#include <DEDXF_Preprocessor.hxx>
+
+#include <Message.hxx>
+#include <Message_ProgressScope.hxx>
+#include <OSD_Directory.hxx>
+#include <OSD_File.hxx>
+#include <OSD_OpenFile.hxx>
+#include <OSD_Parallel.hxx>
+#include <OSD_Path.hxx>
+#include <OSD_Process.hxx>
+#include <OSD_Thread.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+
+namespace
+{
+//! Section of the DXF file.
+enum DEDXF_SectionKind
+{
+  DEDXF_SectionKind_None,      //!< outside of sections
+  DEDXF_SectionKind_Geometry,  //!< ENTITIES or BLOCKS section
+  DEDXF_SectionKind_Thumbnail, //!< THUMBNAILIMAGE section
+  DEDXF_SectionKind_Other      //!< any other section
+};
+
+//! Counter making the names of temporary files unique within the process.
+static std::atomic<unsigned int> THE_TMP_COUNTER(0);
+} // namespace
+
+//=======================================================================
+// function : DEDXF_Preprocessor
+// purpose  :
+//=======================================================================
+DEDXF_Preprocessor::DEDXF_Preprocessor()
+    : myNbDropped(0)
+{
+}
+
+//=======================================================================
+// function : ~DEDXF_Preprocessor
+// purpose  :
+//=======================================================================
+DEDXF_Preprocessor::~DEDXF_Preprocessor()
+{
+  RemoveTemporaryFiles();
+}
+
+//=======================================================================
+// function : IsRequired
+// purpose  :
+//=======================================================================
+bool DEDXF_Preprocessor::IsRequired(const TCollection_AsciiString&         thePath,
+                                    const Handle(DEDXF_ConfigurationNode)& theNode)
+{
+  if (DEDXF_Tokenizer::IsBinaryFile(thePath))
+  {
+    return true;
+  }
+  return theNode->ProviderParameters.ReadParallelTokenizer
+         && (!theNode->InternalParameters.ReadTextEntities
+             || !theNode->InternalParameters.ReadHatchEntities);
+}
+
+//=======================================================================
+// function : Perform
+// purpose  :
+//=======================================================================
+bool DEDXF_Preprocessor::Perform(const TCollection_AsciiString&         thePath,
+                                 const Handle(DEDXF_ConfigurationNode)& theNode,
+                                 const Message_ProgressRange&           theProgress)
+{
+  Message_ProgressScope aPS(theProgress, "Preprocessing DXF file", 10);
+  if (!prepare(thePath, theNode, aPS.Next(7)))
+  {
+    return false;
+  }
+  if (myNbDropped == 0 && !myTokenizer.IsBinary())
+  {
+    return true;
+  }
+
+  const TCollection_AsciiString aReducedPath = temporaryFile("reduced.dxf");
+  if (aReducedPath.IsEmpty())
+  {
+    return false;
+  }
+  std::ofstream aStream;
+  OSD_OpenStream(aStream, aReducedPath, std::ios::out | std::ios::binary);
+  if (!aStream.is_open())
+  {
+    Message::SendWarning() << "Warning in the DEDXF_Preprocessor: unable to create file "
+                           << aReducedPath;
+    RemoveTemporaryFiles();
+    return false;
+  }
+  writeKept(aStream, 0, myTokenizer.NbTokens());
+  aStream.close();
+  if (aStream.fail())
+  {
+    Message::SendWarning() << "Warning in the DEDXF_Preprocessor: unable to write file "
+                           << aReducedPath;
+    RemoveTemporaryFiles();
+    return false;
+  }
+  aPS.Next(3);
+  myReadPath = aReducedPath;
+  return true;
+}
+
+//=======================================================================
+// function : Split
+// purpose  :
+//=======================================================================
+bool DEDXF_Preprocessor::Split(const TCollection_AsciiString&         thePath,
+                               const Handle(DEDXF_ConfigurationNode)& theNode,
+                               const int                              theNbParts,
+                               const Message_ProgressRange&           theProgress)
+{
+  Message_ProgressScope aPS(theProgress, "Splitting DXF file", 10);
+  if (!prepare(thePath, theNode, aPS.Next(6)))
+  {
+    return false;
+  }
+
+  // locate the body of ENTITIES section
+  const size_t aNbTokens  = myTokenizer.NbTokens();
+  size_t       aBodyStart = aNbTokens, aBodyEnd = aNbTokens;
+  for (size_t aTokIter = 0; aTokIter + 1 < aNbTokens; ++aTokIter)
+  {
+    if (myTokenizer.Code(aTokIter) == 0 && myTokenizer.IsValue(aTokIter, "SECTION")
+        && myTokenizer.Code(aTokIter + 1) == 2 && myTokenizer.IsValue(aTokIter + 1, "ENTITIES"))
+    {
+      aBodyStart = aTokIter + 2;
+      break;
+    }
+  }
+  for (size_t aTokIter = aBodyStart; aTokIter < aNbTokens; ++aTokIter)
+  {
+    if (myTokenizer.Code(aTokIter) == 0 && myTokenizer.IsValue(aTokIter, "ENDSEC"))
+    {
+      aBodyEnd = aTokIter;
+      break;
+    }
+  }
+  if (aBodyEnd >= aNbTokens)
+  {
+    return false;
+  }
+
+  // vertices and attributes belong to the preceding POLYLINE or INSERT up to SEQEND
+  std::vector<size_t> anEntityStarts;
+  for (size_t aTokIter = aBodyStart; aTokIter < aBodyEnd; ++aTokIter)
+  {
+    if (myTokenizer.Code(aTokIter) == 0 && !myTokenizer.IsValue(aTokIter, "VERTEX")
+        && !myTokenizer.IsValue(aTokIter, "ATTRIB") && !myTokenizer.IsValue(aTokIter, "SEQEND"))
+    {
+      anEntityStarts.push_back(aTokIter);
+    }
+  }
+  const int aNbParts = (int)std::min((size_t)theNbParts, anEntityStarts.size());
+  if (aNbParts < 2)
+  {
+    return false;
+  }
+
+  // contiguous parts of similar size keep the order of entities in the file
+  std::vector<size_t> aBounds(1, aBodyStart);
+  for (int aPartIter = 1; aPartIter < aNbParts; ++aPartIter)
+  {
+    const size_t aTarget = aBodyStart + (aBodyEnd - aBodyStart) * aPartIter / aNbParts;
+    const std::vector<size_t>::const_iterator aStartIter =
+      std::lower_bound(anEntityStarts.begin(), anEntityStarts.end(), aTarget);
+    if (aStartIter != anEntityStarts.end() && *aStartIter > aBounds.back())
+    {
+      aBounds.push_back(*aStartIter);
+    }
+  }
+  aBounds.push_back(aBodyEnd);
+
+  const int aNbWritten = (int)aBounds.size() - 1;
+  for (int aPartIter = 0; aPartIter < aNbWritten; ++aPartIter)
+  {
+    const TCollection_AsciiString aPartPath =
+      temporaryFile(TCollection_AsciiString("part") + (aPartIter + 1) + ".dxf");
+    if (aPartPath.IsEmpty())
+    {
+      RemoveTemporaryFiles();
+      return false;
+    }
+    myPartPaths.Append(aPartPath);
+  }
+
+  Message_ProgressScope              aWritePS(aPS.Next(4), "Writing parts", aNbWritten);
+  std::vector<Message_ProgressRange> aRanges;
+  aRanges.reserve(aNbWritten);
+  for (int aPartIter = 0; aPartIter < aNbWritten; ++aPartIter)
+  {
+    aRanges.push_back(aWritePS.Next());
+  }
+  std::vector<char> aStatus(aNbWritten, 0);
+  OSD_Parallel::For(0, aNbWritten, [&](const int thePart) {
+    Message_ProgressScope aPartScope(aRanges[thePart], NULL, 1);
+    std::ofstream         aStream;
+    OSD_OpenStream(aStream, myPartPaths.Value(thePart + 1), std::ios::out | std::ios::binary);
+    if (!aPartScope.More() || !aStream.is_open())
+    {
+      return;
+    }
+    // shared HEADER, CLASSES, TABLES and BLOCKS, the entities of the part and shared OBJECTS
+    writeKept(aStream, 0, aBodyStart);
+    writeKept(aStream, aBounds[thePart], aBounds[thePart + 1]);
+    writeKept(aStream, aBodyEnd, aNbTokens);
+    aStream.close();
+    aStatus[thePart] = aStream.fail() ? 0 : 1;
+    aPartScope.Next();
+  });
+  for (int aPartIter = 0; aPartIter < aNbWritten; ++aPartIter)
+  {
+    if (aStatus[aPartIter] == 0)
+    {
+      Message::SendWarning() << "Warning in the DEDXF_Preprocessor: unable to write file "
+                             << myPartPaths.Value(aPartIter + 1);
+      RemoveTemporaryFiles();
+      return false;
+    }
+  }
+  return true;
+}
+
+//=======================================================================
+// function : prepare
+// purpose  :
+//=======================================================================
+bool DEDXF_Preprocessor::prepare(const TCollection_AsciiString&         thePath,
+                                 const Handle(DEDXF_ConfigurationNode)& theNode,
+                                 const Message_ProgressRange&           theProgress)
+{
+  RemoveTemporaryFiles();
+  myReadPath  = thePath;
+  myNbDropped = 0;
+  myRanges.clear();
+
+  const bool toParallel = theNode->ProviderParameters.ReadParallelTokenizer
+                          || theNode->ProviderParameters.ReadParallelMode;
+  if (!myTokenizer.Load(thePath) || !myTokenizer.Perform(toParallel, theProgress))
+  {
+    Message::SendWarning() << "Warning in the DEDXF_Preprocessor: " << myTokenizer.ErrorMessage();
+    return false;
+  }
+
+  const bool toDropText  = !theNode->InternalParameters.ReadTextEntities;
+  const bool toDropHatch = !theNode->InternalParameters.ReadHatchEntities;
+
+  // find the ranges of pairs to keep
+  DEDXF_SectionKind aSection     = DEDXF_SectionKind_None;
+  bool              toDropEntity = false;
+  size_t            aRangeStart  = 0;
+  const size_t      aNbTokens    = myTokenizer.NbTokens();
+  for (size_t aTokIter = 0; aTokIter < aNbTokens; ++aTokIter)
+  {
+    const int aCode  = myTokenizer.Code(aTokIter);
+    bool      toDrop = aCode == 999;
+    if (aCode == 0)
+    {
+      toDropEntity = false;
+      if (myTokenizer.IsValue(aTokIter, "SECTION") && aTokIter + 1 < aNbTokens
+          && myTokenizer.Code(aTokIter + 1) == 2)
+      {
+        if (myTokenizer.IsValue(aTokIter + 1, "ENTITIES")
+            || myTokenizer.IsValue(aTokIter + 1, "BLOCKS"))
+        {
+          aSection = DEDXF_SectionKind_Geometry;
+        }
+        else if (myTokenizer.IsValue(aTokIter + 1, "THUMBNAILIMAGE"))
+        {
+          aSection = DEDXF_SectionKind_Thumbnail;
+        }
+        else
+        {
+          aSection = DEDXF_SectionKind_Other;
+        }
+      }
+      else if (aSection == DEDXF_SectionKind_Geometry)
+      {
+        toDropEntity = (toDropText
+                        && (myTokenizer.IsValue(aTokIter, "TEXT")
+                            || myTokenizer.IsValue(aTokIter, "MTEXT")))
+                       || (toDropHatch && myTokenizer.IsValue(aTokIter, "HATCH"));
+      }
+    }
+    toDrop = toDrop || toDropEntity || aSection == DEDXF_SectionKind_Thumbnail;
+    if (aCode == 0 && myTokenizer.IsValue(aTokIter, "ENDSEC"))
+    {
+      aSection = DEDXF_SectionKind_None;
+    }
+    if (toDrop)
+    {
+      if (aRangeStart < aTokIter)
+      {
+        myRanges.push_back(std::make_pair(aRangeStart, aTokIter));
+      }
+      aRangeStart = aTokIter + 1;
+      ++myNbDropped;
+    }
+  }
+  if (aRangeStart < aNbTokens)
+  {
+    myRanges.push_back(std::make_pair(aRangeStart, aNbTokens));
+  }
+  return true;
+}
+
+//=======================================================================
+// function : writeKept
+// purpose  :
+//=======================================================================
+void DEDXF_Preprocessor::writeKept(std::ostream& theStream,
+                                   const size_t  theFirst,
+                                   const size_t  theLast) const
+{
+  for (std::vector<std::pair<size_t, size_t>>::const_iterator aRangeIter = myRanges.begin();
+       aRangeIter != myRanges.end() && aRangeIter->first < theLast;
+       ++aRangeIter)
+  {
+    const size_t aFirst = std::max(aRangeIter->first, theFirst);
+    const size_t aLast  = std::min(aRangeIter->second, theLast);
+    if (aFirst < aLast)
+    {
+      myTokenizer.WriteAscii(theStream, aFirst, aLast);
+    }
+  }
+}
+
+//=======================================================================
+// function : ReleaseContent
+// purpose  :
+//=======================================================================
+void DEDXF_Preprocessor::ReleaseContent()
+{
+  myTokenizer.SetContent(Handle(NCollection_Buffer)());
+  std::vector<std::pair<size_t, size_t>>().swap(myRanges);
+}
+
+//=======================================================================
+// function : temporaryFile
+// purpose  :
+//=======================================================================
+TCollection_AsciiString DEDXF_Preprocessor::temporaryFile(const TCollection_AsciiString& theName)
+{
+  if (myTmpDir.IsEmpty())
+  {
+    OSD_Directory aDir = OSD_Directory::BuildTemporary();
+    if (aDir.Failed())
+    {
+      Message::SendWarning()
+        << "Warning in the DEDXF_Preprocessor: unable to create temporary directory";
+      return TCollection_AsciiString();
+    }
+    OSD_Path aDirPath;
+    aDir.Path(aDirPath);
+    aDirPath.SystemName(myTmpDir);
+    if (!myTmpDir.IsEmpty() && myTmpDir.Value(myTmpDir.Length()) != '/'
+        && myTmpDir.Value(myTmpDir.Length()) != '\\')
+    {
+      myTmpDir += "/";
+    }
+  }
+  // the name is unique for the process, the thread and the call,
+  // so that concurrent readers never share the file even in a common directory
+  TCollection_AsciiString aPath;
+  do
+  {
+    char aPrefix[96];
+    Sprintf(aPrefix,
+            "dedxf.%d.%llx.%u.",
+            OSD_Process().ProcessId(),
+            (unsigned long long)OSD_Thread::Current(),
+            THE_TMP_COUNTER.fetch_add(1));
+    aPath = myTmpDir + aPrefix + theName;
+  } while (OSD_File(OSD_Path(aPath)).Exists());
+  myTmpFiles.Append(aPath);
+  return aPath;
+}
+
+//=======================================================================
+// function : RemoveTemporaryFiles
+// purpose  :
+//=======================================================================
+void DEDXF_Preprocessor::RemoveTemporaryFiles()
+{
+  for (TColStd_SequenceOfAsciiString::Iterator aFileIter(myTmpFiles); aFileIter.More();
+       aFileIter.Next())
+  {
+    OSD_File aFile(OSD_Path(aFileIter.Value()));
+    if (aFile.Exists())
+    {
+      aFile.Remove();
+    }
+  }
+  myTmpFiles.Clear();
+  myPartPaths.Clear();
+  if (!myTmpDir.IsEmpty())
+  {
+    OSD_Directory aDir(OSD_Path(myTmpDir));
+    if (aDir.Exists())
+    {
+      aDir.Remove();
+    }
+    myTmpDir.Clear();
+  }
+}
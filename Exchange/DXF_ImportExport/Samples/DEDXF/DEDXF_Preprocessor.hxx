@@ -0,0 +1,124 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#ifndef _DEDXF_Preprocessor_HeaderFile
+#define _DEDXF_Preprocessor_HeaderFile
+
+#include <DEDXF_ConfigurationNode.hxx>
+#include <DEDXF_Tokenizer.hxx>
+#include <TColStd_SequenceOfAsciiString.hxx>
+
+//! Prepares the DXF file for DXFCAFControl_Reader and DxfControl_Reader.
+//! The file is tokenized by DEDXF_Tokenizer (in parallel when enabled by
+//! DEDXF_ConfigurationNode::ProviderParameters) and the content which the reader
+//! would skip anyway is dropped before parsing:
+//! - comments (999 group code);
+//! - THUMBNAILIMAGE section;
+//! - TEXT and MTEXT entities when reading of text entities is disabled;
+//! - HATCH entities when reading of hatch entities is disabled.
+//! The reduced content is written into the temporary file with a unique name,
+//! which is removed on failure, by RemoveTemporaryFiles()
+//! or together with the preprocessor. Binary DXF is always written as ASCII DXF,
+//! since the reader supports ASCII group codes only.
+//!
+//! For parallel reading the ENTITIES section can be split into several temporary files
+//! sharing all other sections, so that every file is read by its own reader
+//! (see DEDXF_ParallelReader). POLYLINE and INSERT entities are never separated
+//! from their VERTEX, ATTRIB and SEQEND entities.
+class DEDXF_Preprocessor
+{
+public:
+  //! Creates the preprocessor.
+  Standard_EXPORT DEDXF_Preprocessor();
+
+  //! Removes the temporary files.
+  Standard_EXPORT ~DEDXF_Preprocessor();
+
+  //! Checks if the file should be preprocessed before reading:
+  //! binary DXF is always transcoded, while ASCII DXF is preprocessed only when
+  //! the preprocessing is enabled and TEXT, MTEXT or HATCH entities are filtered out,
+  //! as otherwise the pass would only add the tokenizing and writing time to the reading.
+  //! @param[in] thePath path to the DXF file
+  //! @param[in] theNode configuration of the reading
+  Standard_EXPORT static bool IsRequired(const TCollection_AsciiString&         thePath,
+                                         const Handle(DEDXF_ConfigurationNode)& theNode);
+
+  //! Tokenizes the file and writes the reduced content.
+  //! @param[in] thePath path to the DXF file
+  //! @param[in] theNode configuration of the reading
+  //! @param[in] theProgress progress indicator
+  //! @return false if the file cannot be tokenized, ReadPath() is the original file then
+  Standard_EXPORT bool Perform(const TCollection_AsciiString&         thePath,
+                               const Handle(DEDXF_ConfigurationNode)& theNode,
+                               const Message_ProgressRange& theProgress = Message_ProgressRange());
+
+  //! Tokenizes the file and splits the reduced content into several files with
+  //! contiguous parts of ENTITIES section.
+  //! @param[in] thePath path to the DXF file
+  //! @param[in] theNode configuration of the reading
+  //! @param[in] theNbParts maximal number of parts
+  //! @param[in] theProgress progress indicator
+  //! @return false if the file cannot be tokenized or has not enough entities to split
+  Standard_EXPORT bool Split(const TCollection_AsciiString&         thePath,
+                             const Handle(DEDXF_ConfigurationNode)& theNode,
+                             const int                              theNbParts,
+                             const Message_ProgressRange& theProgress = Message_ProgressRange());
+
+  //! Returns the paths of the parts written by Split() in the file order.
+  const TColStd_SequenceOfAsciiString& PartPaths() const { return myPartPaths; }
+
+  //! Returns the path of the file to pass to the reader:
+  //! the temporary file with reduced content or the original file if nothing was dropped.
+  const TCollection_AsciiString& ReadPath() const { return myReadPath; }
+
+  //! Returns the number of dropped group code / value pairs.
+  size_t NbDropped() const { return myNbDropped; }
+
+  //! Returns the tokenizer holding the original content.
+  const DEDXF_Tokenizer& Tokenizer() const { return myTokenizer; }
+
+  //! Releases the original content, its tokens and their memory.
+  Standard_EXPORT void ReleaseContent();
+
+  //! Removes the temporary files and the temporary directory.
+  //! Should be called as soon as the reader has consumed ReadPath() or PartPaths(),
+  //! the paths of removed files must not be used after that.
+  Standard_EXPORT void RemoveTemporaryFiles();
+
+protected:
+  //! Tokenizes the file and finds the ranges of pairs to keep.
+  Standard_EXPORT bool prepare(const TCollection_AsciiString&         thePath,
+                               const Handle(DEDXF_ConfigurationNode)& theNode,
+                               const Message_ProgressRange&           theProgress);
+
+  //! Writes the kept pairs within the range [theFirst, theLast) of tokens.
+  Standard_EXPORT void writeKept(std::ostream& theStream,
+                                 const size_t  theFirst,
+                                 const size_t  theLast) const;
+
+  //! Returns the unique path of the new file in the temporary directory.
+  Standard_EXPORT TCollection_AsciiString temporaryFile(const TCollection_AsciiString& theName);
+
+private:
+  DEDXF_Tokenizer                        myTokenizer; //!< tokenizer of the original content
+  std::vector<std::pair<size_t, size_t>> myRanges;    //!< ranges of tokens to keep
+  TCollection_AsciiString                myReadPath;  //!< path of the file to read
+  TColStd_SequenceOfAsciiString          myPartPaths; //!< parts written by Split()
+  TCollection_AsciiString                myTmpDir;    //!< temporary directory, empty if not created
+  TColStd_SequenceOfAsciiString          myTmpFiles;  //!< created temporary files
+  size_t                                 myNbDropped; //!< number of dropped pairs
+};
+
+#endif // _DEDXF_Preprocessor_HeaderFile
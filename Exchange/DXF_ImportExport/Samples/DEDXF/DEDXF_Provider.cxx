@@ -15,6 +15,11 @@
 #include <DEDXF_Provider.hxx>
 
 #include <BinXCAFDrivers.hxx>
+#include <DEDXF_BlockInstancer.hxx>
+#include <DEDXF_GroupCodeWriter.hxx>
+#include <DEDXF_ParallelReader.hxx>
+#include <DEDXF_Preprocessor.hxx>
+#include <DEDXF_StreamWriter.hxx>
 #include <DXFCAFControl_Reader.hxx>
 #include <DXFCAFControl_Writer.hxx>
 #include <DxfControl_Controller.hxx>
@@ -22,7 +27,11 @@
 #include <DxfSection_ConfParameters.hxx>
 #include <DxfSection_Model.hxx>
 #include <Message.hxx>
+#include <Message_ProgressScope.hxx>
+#include <OSD_OpenFile.hxx>
+#include <TDocStd_Application.hxx>
 #include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
 #include <XSControl_WorkSession.hxx>
 
 IMPLEMENT_STANDARD_RTTIEXT(DEDXF_Provider, DE_Provider)
@@ -68,25 +77,59 @@ bool DEDXF_Provider::Read(const TCollection_AsciiString&  thePath,
   XCAFDoc_DocumentTool::SetLengthUnit(theDocument,
                                       aNode->GlobalParameters.LengthUnit,
                                       UnitsMethods_LengthUnit_Millimeter);
-  DXFCAFControl_Reader aReader;
-  aReader.SetWS(theWS);
-  aReader.SetColorMode(aNode->InternalParameters.ReadColorMode);
-  aReader.SetNameMode(aNode->InternalParameters.WriteColorMode);
-  IFSelect_ReturnStatus aReadStat = IFSelect_RetVoid;
-  aReadStat = aReader.ReadFile(thePath.ToCString(), aNode->InternalParameters);
-  if (aReadStat != IFSelect_RetDone)
+  Message_ProgressScope aPS(theProgress, "Reading DXF file", 10);
+  if (aNode->ProviderParameters.ReadParallelMode)
   {
-    Message::SendFail() << "Error in the DEDXF_Provider during reading the file " << thePath
-                        << "\t: abandon, no model loaded";
-    return false;
+    // batches are read by own sessions, theWS keeps only the norm
+    DEDXF_ParallelReader aParallelReader(aNode);
+    if (!aParallelReader.Perform(thePath, theDocument, aPS.Next(9)))
+    {
+      Message::SendFail() << "Error in the DEDXF_Provider during reading the file " << thePath
+                          << "\t: Cannot read any relevant data from the DXF file";
+      return false;
+    }
   }
-  aReader.ClearShapes();
-  aReader.NbRootsForTransfer();
-  if (!aReader.Transfer(theDocument, theProgress))
+  else
   {
-    Message::SendFail() << "Error in the DEDXF_Provider during reading the file " << thePath
-                        << "\t: Cannot read any relevant data from the DXF file";
-    return false;
+    // binary content is transcoded for the reader
+    DEDXF_Preprocessor aPreprocessor;
+    const bool         toPreprocess = DEDXF_Preprocessor::IsRequired(thePath, aNode);
+    if (toPreprocess)
+    {
+      if (!aPreprocessor.Perform(thePath, aNode, aPS.Next(2))
+          && !checkPreprocessing(thePath, aPreprocessor))
+      {
+        return false;
+      }
+      aPreprocessor.ReleaseContent();
+    }
+    DXFCAFControl_Reader aReader;
+    aReader.SetWS(theWS);
+    aReader.SetColorMode(aNode->InternalParameters.ReadColorMode);
+    aReader.SetNameMode(aNode->InternalParameters.WriteColorMode);
+    IFSelect_ReturnStatus          aReadStat = IFSelect_RetVoid;
+    const TCollection_AsciiString& aReadPath = toPreprocess ? aPreprocessor.ReadPath() : thePath;
+    aReadStat = aReader.ReadFile(aReadPath.ToCString(), aNode->InternalParameters);
+    aPreprocessor.RemoveTemporaryFiles();
+    if (aReadStat != IFSelect_RetDone)
+    {
+      Message::SendFail() << "Error in the DEDXF_Provider during reading the file " << thePath
+                          << "\t: abandon, no model loaded";
+      return false;
+    }
+    aReader.ClearShapes();
+    aReader.NbRootsForTransfer();
+    if (!aReader.Transfer(theDocument, aPS.Next(7)))
+    {
+      Message::SendFail() << "Error in the DEDXF_Provider during reading the file " << thePath
+                          << "\t: Cannot read any relevant data from the DXF file";
+      return false;
+    }
+  }
+  if (aNode->ProviderParameters.ReadInstanceBlocks)
+  {
+    DEDXF_BlockInstancer anInstancer;
+    anInstancer.Perform(theDocument, aPS.Next());
   }
   return true;
 }
@@ -100,7 +143,6 @@ bool DEDXF_Provider::Write(const TCollection_AsciiString&  thePath,
                            Handle(XSControl_WorkSession)&  theWS,
                            const Message_ProgressRange&    theProgress)
 {
-  (void)theProgress;
   if (!GetNode()->IsKind(STANDARD_TYPE(DEDXF_ConfigurationNode)))
   {
     Message::SendFail() << "Error in the DEDXF_Provider during reading the file " << thePath
@@ -115,6 +157,10 @@ bool DEDXF_Provider::Write(const TCollection_AsciiString&  thePath,
       << "Warning in the DEDXF_Provider during writing the file " << thePath
       << "\t: Target Units for writing were changed, but writer doesn't currently support scaling";
   }
+  if (aNode->ProviderParameters.WriteStreaming)
+  {
+    return writeStreaming(thePath, theDocument, theProgress);
+  }
   DXFCAFControl_Writer aWriter;
   aWriter.SetWS(theWS);
   Handle(DxfSection_Model) aDxfModel = Handle(DxfSection_Model)::DownCast(aWriter.Model());
@@ -136,7 +182,7 @@ bool DEDXF_Provider::Write(const TCollection_AsciiString&  thePath,
     return false;
   }
   aDxfModel->GetConfParameters().Reset();
-  return true;
+  return !aNode->ProviderParameters.WriteBinary || convertToBinary(thePath, theProgress);
 }
 
 //=======================================================================
@@ -172,7 +218,6 @@ bool DEDXF_Provider::Read(const TCollection_AsciiString& thePath,
                           Handle(XSControl_WorkSession)& theWS,
                           const Message_ProgressRange&   theProgress)
 {
-  (void)theProgress;
   if (!GetNode()->IsKind(STANDARD_TYPE(DEDXF_ConfigurationNode)))
   {
     Message::SendFail() << "Error in the DEDXF_Provider during reading the file " << thePath
@@ -181,9 +226,22 @@ bool DEDXF_Provider::Read(const TCollection_AsciiString& thePath,
   }
   Handle(DEDXF_ConfigurationNode) aNode = Handle(DEDXF_ConfigurationNode)::DownCast(GetNode());
   personizeWS(theWS);
+  DEDXF_Preprocessor aPreprocessor;
+  const bool         toPreprocess = DEDXF_Preprocessor::IsRequired(thePath, aNode);
+  if (toPreprocess)
+  {
+    if (!aPreprocessor.Perform(thePath, aNode, theProgress)
+        && !checkPreprocessing(thePath, aPreprocessor))
+    {
+      return false;
+    }
+    aPreprocessor.ReleaseContent();
+  }
+  const TCollection_AsciiString& aReadPath = toPreprocess ? aPreprocessor.ReadPath() : thePath;
   DxfControl_Reader aReader;
   aReader.SetWS(theWS);
-  IFSelect_ReturnStatus    aStat = aReader.ReadFile(thePath.ToCString(), aNode->InternalParameters);
+  IFSelect_ReturnStatus aStat = aReader.ReadFile(aReadPath.ToCString(), aNode->InternalParameters);
+  aPreprocessor.RemoveTemporaryFiles();
   Handle(DxfSection_Model) aDxfModel = Handle(DxfSection_Model)::DownCast(aReader.Model());
   switch (aStat)
   {
@@ -239,7 +297,6 @@ bool DEDXF_Provider::Write(const TCollection_AsciiString& thePath,
                            Handle(XSControl_WorkSession)& theWS,
                            const Message_ProgressRange&   theProgress)
 {
-  (void)theProgress;
   personizeWS(theWS);
   DxfControl_Writer aWriter;
   aWriter.SetWS(theWS);
@@ -251,6 +308,17 @@ bool DEDXF_Provider::Write(const TCollection_AsciiString& thePath,
       << "Warning in the DEDXF_Provider during writing the file " << thePath
       << "\t: Target Units for writing were changed, but writer doesn't currently support scaling";
   }
+  if (aNode->ProviderParameters.WriteStreaming)
+  {
+    // the streaming writer works on XDE document only
+    Handle(TDocStd_Application) anApp = new TDocStd_Application();
+    Handle(TDocStd_Document)    aDocument;
+    anApp->NewDocument("BinXCAF", aDocument);
+    XCAFDoc_DocumentTool::ShapeTool(aDocument->Main())->AddShape(theShape);
+    const bool isDone = writeStreaming(thePath, aDocument, theProgress);
+    anApp->Close(aDocument);
+    return isDone;
+  }
 
   Handle(DxfSection_Model)  aDxfModel = Handle(DxfSection_Model)::DownCast(aWriter.Model());
   DxfSection_ConfParameters aParameters;
@@ -263,7 +331,7 @@ bool DEDXF_Provider::Write(const TCollection_AsciiString& thePath,
     return false;
   }
   aDxfModel->GetConfParameters().Reset();
-  return true;
+  return !aNode->ProviderParameters.WriteBinary || convertToBinary(thePath, theProgress);
 }
 
 //=======================================================================
@@ -328,3 +396,85 @@ void DEDXF_Provider::personizeWS(Handle(XSControl_WorkSession)& theWS)
     theWS->SelectNorm("DXF");
   }
 }
+
+//=======================================================================
+// function : checkPreprocessing
+// purpose  :
+//=======================================================================
+bool DEDXF_Provider::checkPreprocessing(const TCollection_AsciiString& thePath,
+                                        const DEDXF_Preprocessor&      thePreprocessor) const
+{
+  // the reader supports ASCII group codes only
+  if (thePreprocessor.Tokenizer().IsBinary() || DEDXF_Tokenizer::IsBinaryFile(thePath))
+  {
+    Message::SendFail() << "Error in the DEDXF_Provider during reading the file " << thePath
+                        << "\t: binary DXF content cannot be transcoded";
+    return false;
+  }
+  Message::SendWarning() << "Warning in the DEDXF_Provider during reading the file " << thePath
+                         << "\t: preprocessing failed, the original file is read";
+  return true;
+}
+
+//=======================================================================
+// function : writeStreaming
+// purpose  :
+//=======================================================================
+bool DEDXF_Provider::writeStreaming(const TCollection_AsciiString&  thePath,
+                                    const Handle(TDocStd_Document)& theDocument,
+                                    const Message_ProgressRange&    theProgress)
+{
+  Handle(DEDXF_ConfigurationNode) aNode = Handle(DEDXF_ConfigurationNode)::DownCast(GetNode());
+  DEDXF_StreamWriter              aWriter;
+  aWriter.SetBinary(aNode->ProviderParameters.WriteBinary);
+  aWriter.SetDeflection(aNode->InternalParameters.WriteDeflectionFactor);
+  aWriter.SetColorMode(aNode->InternalParameters.WriteColorMode);
+  aWriter.SetNameMode(aNode->InternalParameters.WriteNameMode);
+  if (!aWriter.Perform(theDocument, thePath, theProgress))
+  {
+    Message::SendFail() << "Error in the DEDXF_Provider during writing the file " << thePath
+                        << "\t: Writing error";
+    return false;
+  }
+  return true;
+}
+
+//=======================================================================
+// function : convertToBinary
+// purpose  :
+//=======================================================================
+bool DEDXF_Provider::convertToBinary(const TCollection_AsciiString& thePath,
+                                     const Message_ProgressRange&   theProgress)
+{
+  Handle(DEDXF_ConfigurationNode) aNode = Handle(DEDXF_ConfigurationNode)::DownCast(GetNode());
+  DEDXF_Tokenizer                 aTokenizer;
+  if (!aTokenizer.Load(thePath) || !aTokenizer.Perform(true, theProgress))
+  {
+    Message::SendFail() << "Error in the DEDXF_Provider during writing the file " << thePath
+                        << "\t: " << aTokenizer.ErrorMessage();
+    return false;
+  }
+  // the content is kept in memory, so the file is rewritten in place
+  std::ofstream aStream;
+  OSD_OpenStream(aStream, thePath, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!aStream.is_open())
+  {
+    Message::SendFail() << "Error in the DEDXF_Provider during writing the file " << thePath
+                        << "\t: Cannot open the file for binary output";
+    return false;
+  }
+  // group codes of DXF R12 are stored in a single byte
+  const bool isShortCodes = (int)aNode->InternalParameters.WriteVersion == 12;
+  DEDXF_GroupCodeWriter aWriter(aStream, true, isShortCodes);
+  aWriter.WriteSentinel();
+  aTokenizer.Write(aWriter, 0, aTokenizer.NbTokens());
+  const bool isDone = aWriter.IsDone();
+  aStream.close();
+  if (!isDone || aStream.fail())
+  {
+    Message::SendFail() << "Error in the DEDXF_Provider during writing the file " << thePath
+                        << "\t: Binary writing error";
+    return false;
+  }
+  return true;
+}
@@ -18,6 +18,8 @@
 #include <DE_Provider.hxx>
 #include <DEDXF_ConfigurationNode.hxx>
 
+class DEDXF_Preprocessor;
+
 //! The class to transfer DXF files.
 //! Reads and Writes any DXF files into/from OCCT.
 //! Each operation needs configuration node.
@@ -142,6 +144,30 @@ public:
   //! Creates new temporary session if current session is null
   //! @param[in] theWS current work session
   void personizeWS(Handle(XSControl_WorkSession)& theWS);
+
+  //! Handles the failure of DEDXF_Preprocessor::Perform():
+  //! binary DXF cannot be read without transcoding, ASCII DXF is read from the original file.
+  //! @param[in] thePath path to the DXF file
+  //! @param[in] thePreprocessor failed preprocessor
+  //! @return true if the original file can be read instead
+  bool checkPreprocessing(const TCollection_AsciiString& thePath,
+                          const DEDXF_Preprocessor&      thePreprocessor) const;
+
+  //! Writes the document by DEDXF_StreamWriter without building DxfSection_Model
+  //! @param[in] thePath path to the export CAD file
+  //! @param[in] theDocument document to export
+  //! @param[in] theProgress progress indicator
+  //! @return true if Write operation has ended correctly
+  bool writeStreaming(const TCollection_AsciiString&  thePath,
+                      const Handle(TDocStd_Document)& theDocument,
+                      const Message_ProgressRange&    theProgress);
+
+  //! Rewrites ASCII DXF file produced by the writer as binary DXF
+  //! @param[in] thePath path to the written file
+  //! @param[in] theProgress progress indicator
+  //! @return true if the file has been converted
+  bool convertToBinary(const TCollection_AsciiString& thePath,
+                       const Message_ProgressRange&   theProgress);
 };
 
 #endif // _DEDXF_Provider_HeaderFile
@@ -0,0 +1,751 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#include <DEDXF_StreamWriter.hxx>
+
+#include <Bnd_Box.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepAdaptor_Curve.hxx>
+#include <BRepBndLib.hxx>
+#include <BRepBuilderAPI_Copy.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <DEDXF_GroupCodeWriter.hxx>
+#include <gp.hxx>
+#include <gp_Circ.hxx>
+#include <GCPnts_TangentialDeflection.hxx>
+#include <Message.hxx>
+#include <Message_ProgressScope.hxx>
+#include <NCollection_IndexedMap.hxx>
+#include <NCollection_Vector.hxx>
+#include <OSD_OpenFile.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Precision.hxx>
+#include <TColStd_HSequenceOfExtendedString.hxx>
+#include <TDataStd_Name.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <TopTools_IndexedDataMapOfShapeListOfShape.hxx>
+#include <TopTools_ShapeMapHasher.hxx>
+#include <XCAFDoc_ColorTool.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_LayerTool.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+
+#include <fstream>
+#include <vector>
+
+#include <string.h>
+
+namespace
+{
+//! Size of the buffer of the output file.
+static const size_t THE_STREAM_BUFFER_SIZE = 64 * 1024;
+
+//! Angular deflection of discretization of curves.
+static const Standard_Real THE_ANGULAR_DEFLECTION = 0.1;
+
+//! Table of colors of AutoCAD color index as sRGB bytes.
+struct DEDXF_AciPalette
+{
+  unsigned char Colors[256][3];
+
+  DEDXF_AciPalette()
+  {
+    static const unsigned char THE_STANDARD_COLORS[10][3] = {{0, 0, 0},
+                                                             {255, 0, 0},
+                                                             {255, 255, 0},
+                                                             {0, 255, 0},
+                                                             {0, 255, 255},
+                                                             {0, 0, 255},
+                                                             {255, 0, 255},
+                                                             {255, 255, 255},
+                                                             {128, 128, 128},
+                                                             {192, 192, 192}};
+    static const double        THE_LEVELS[5]  = {1.0, 0.8, 0.6, 0.5, 0.3};
+    static const unsigned char THE_GRAYS[6]   = {51, 91, 132, 173, 214, 255};
+    memcpy(Colors, THE_STANDARD_COLORS, sizeof(THE_STANDARD_COLORS));
+
+    // 24 hues by 15 degrees, 5 levels of brightness, full and half saturation
+    for (int anIndex = 10; anIndex < 250; ++anIndex)
+    {
+      const double aHue   = ((anIndex - 10) / 10) * 15.0 / 60.0;
+      const double aX     = 1.0 - Abs(fmod(aHue, 2.0) - 1.0);
+      const double aLevel = THE_LEVELS[((anIndex - 10) % 10) / 2];
+      const bool   isPale = ((anIndex - 10) % 2) == 1;
+      double       aRgb[3] = {0.0, 0.0, 0.0};
+      switch ((int)aHue)
+      {
+        case 0: aRgb[0] = 1.0; aRgb[1] = aX; break;
+        case 1: aRgb[0] = aX; aRgb[1] = 1.0; break;
+        case 2: aRgb[1] = 1.0; aRgb[2] = aX; break;
+        case 3: aRgb[1] = aX; aRgb[2] = 1.0; break;
+        case 4: aRgb[0] = aX; aRgb[2] = 1.0; break;
+        default: aRgb[0] = 1.0; aRgb[2] = aX; break;
+      }
+      for (int aCompIter = 0; aCompIter < 3; ++aCompIter)
+      {
+        const double aValue = isPale ? 1.0 - 0.5 * (1.0 - aRgb[aCompIter]) : aRgb[aCompIter];
+        Colors[anIndex][aCompIter] = (unsigned char)(aValue * aLevel * 255.0);
+      }
+    }
+    for (int anIndex = 250; anIndex < 256; ++anIndex)
+    {
+      Colors[anIndex][0] = Colors[anIndex][1] = Colors[anIndex][2] = THE_GRAYS[anIndex - 250];
+    }
+  }
+};
+
+//! Object coordinate system defined by the extrusion direction (arbitrary axis algorithm).
+struct DEDXF_Ocs
+{
+  gp_Dir XDir;   //!< X axis of the system in world coordinates
+  gp_Dir YDir;   //!< Y axis of the system in world coordinates
+  gp_Dir Normal; //!< extrusion direction
+
+  DEDXF_Ocs(const gp_Dir& theNormal)
+      : Normal(theNormal)
+  {
+    const bool isNearZ = Abs(theNormal.X()) < 1.0 / 64.0 && Abs(theNormal.Y()) < 1.0 / 64.0;
+    XDir               = (isNearZ ? gp::DY() : gp::DZ()).Crossed(theNormal);
+    YDir               = theNormal.Crossed(XDir);
+  }
+
+  //! Returns coordinates of the world point in the system.
+  gp_XYZ Transform(const gp_XYZ& thePnt) const
+  {
+    return gp_XYZ(thePnt.Dot(XDir.XYZ()), thePnt.Dot(YDir.XYZ()), thePnt.Dot(Normal.XYZ()));
+  }
+
+  //! Returns the angle in degrees of the direction projected on XY plane of the system.
+  Standard_Real Angle(const gp_Dir& theDir) const
+  {
+    return atan2(theDir.XYZ().Dot(YDir.XYZ()), theDir.XYZ().Dot(XDir.XYZ())) * 180.0 / M_PI;
+  }
+
+  //! Returns true if the system coincides with the world one.
+  bool IsWorld() const { return Normal.IsEqual(gp::DZ(), Precision::Angular()); }
+};
+
+//! Writes the extrusion direction of the entity if it is not the world Z axis.
+static void writeExtrusion(DEDXF_GroupCodeWriter& theWriter, const DEDXF_Ocs& theOcs)
+{
+  if (!theOcs.IsWorld())
+  {
+    theWriter.Point(210, theOcs.Normal.XYZ());
+  }
+}
+
+//! Normalizes the angle in degrees into [0, 360).
+static Standard_Real normalizeDegrees(const Standard_Real theAngle)
+{
+  Standard_Real anAngle = fmod(theAngle, 360.0);
+  return anAngle < 0.0 ? anAngle + 360.0 : anAngle;
+}
+
+//! Replaces characters not allowed in DXF symbol table names.
+static TCollection_AsciiString dxfName(const TCollection_AsciiString& theName)
+{
+  TCollection_AsciiString aName = theName;
+  aName.LeftAdjust();
+  aName.RightAdjust();
+  for (int aCharIter = 1; aCharIter <= aName.Length(); ++aCharIter)
+  {
+    const unsigned char aChar = (unsigned char)aName.Value(aCharIter);
+    if (aChar < 0x20 || aChar >= 0x7F || strchr("<>/\\\":;?*|=,`", aChar) != NULL)
+    {
+      aName.SetValue(aCharIter, '_');
+    }
+  }
+  return aName;
+}
+
+//! Returns the name of the label.
+static TCollection_AsciiString labelName(const TDF_Label& theLabel)
+{
+  Handle(TDataStd_Name) aName;
+  return theLabel.FindAttribute(TDataStd_Name::GetID(), aName)
+           ? TCollection_AsciiString(aName->Get())
+           : TCollection_AsciiString();
+}
+} // namespace
+
+//=======================================================================
+// function : ColorIndex
+// purpose  :
+//=======================================================================
+int DEDXF_StreamWriter::ColorIndex(const Quantity_Color& theColor)
+{
+  static const DEDXF_AciPalette THE_PALETTE;
+  Standard_Real                 aRed = 0.0, aGreen = 0.0, aBlue = 0.0;
+  theColor.Values(aRed, aGreen, aBlue, Quantity_TOC_sRGB);
+
+  int           aBestIndex    = 7;
+  Standard_Real aBestDistance = RealLast();
+  for (int anIndex = 1; anIndex < 256; ++anIndex)
+  {
+    const Standard_Real aDeltaR  = aRed - THE_PALETTE.Colors[anIndex][0] / 255.0;
+    const Standard_Real aDeltaG  = aGreen - THE_PALETTE.Colors[anIndex][1] / 255.0;
+    const Standard_Real aDeltaB  = aBlue - THE_PALETTE.Colors[anIndex][2] / 255.0;
+    const Standard_Real aDistance = aDeltaR * aDeltaR + aDeltaG * aDeltaG + aDeltaB * aDeltaB;
+    if (aDistance < aBestDistance)
+    {
+      aBestDistance = aDistance;
+      aBestIndex    = anIndex;
+    }
+  }
+  return aBestIndex;
+}
+
+//=======================================================================
+// function : DEDXF_StreamWriter
+// purpose  :
+//=======================================================================
+DEDXF_StreamWriter::DEDXF_StreamWriter()
+    : myDeflection(0.05),
+      myIsBinary(false),
+      myToWriteColors(true),
+      myToWriteNames(true)
+{
+}
+
+//=======================================================================
+// function : Perform
+// purpose  :
+//=======================================================================
+bool DEDXF_StreamWriter::Perform(const Handle(TDocStd_Document)& theDocument,
+                                 const TCollection_AsciiString&  thePath,
+                                 const Message_ProgressRange&    theProgress)
+{
+  // the buffer is set before opening to take effect
+  std::vector<char> aBuffer(THE_STREAM_BUFFER_SIZE);
+  std::ofstream     aStream;
+  aStream.rdbuf()->pubsetbuf(aBuffer.data(), (std::streamsize)aBuffer.size());
+  OSD_OpenStream(aStream, thePath, std::ios::out | std::ios::binary);
+  if (!aStream.is_open())
+  {
+    Message::SendFail() << "Error in the DEDXF_StreamWriter: unable to create file " << thePath;
+    return false;
+  }
+  const bool isDone = Perform(theDocument, aStream, theProgress);
+  aStream.close();
+  return isDone && !aStream.fail();
+}
+
+//=======================================================================
+// function : Perform
+// purpose  :
+//=======================================================================
+bool DEDXF_StreamWriter::Perform(const Handle(TDocStd_Document)& theDocument,
+                                 std::ostream&                   theStream,
+                                 const Message_ProgressRange&    theProgress)
+{
+  myShapeTool = XCAFDoc_DocumentTool::ShapeTool(theDocument->Main());
+  myColorTool = XCAFDoc_DocumentTool::ColorTool(theDocument->Main());
+  myLayerTool = XCAFDoc_DocumentTool::LayerTool(theDocument->Main());
+  myBlockNames.Clear();
+  myUsedNames.Clear();
+
+  // free assemblies and all prototypes referenced by components become BLOCKs
+  TDF_LabelSequence aRoots, aPrototypes;
+  TDF_LabelMap      aVisited;
+  myShapeTool->GetFreeShapes(aRoots);
+  for (TDF_LabelSequence::Iterator aRootIter(aRoots); aRootIter.More(); aRootIter.Next())
+  {
+    if (XCAFDoc_ShapeTool::IsAssembly(aRootIter.Value()))
+    {
+      collectPrototypes(aRootIter.Value(), aPrototypes, aVisited);
+    }
+  }
+  for (TDF_LabelSequence::Iterator aProtoIter(aPrototypes); aProtoIter.More(); aProtoIter.Next())
+  {
+    registerBlock(aProtoIter.Value());
+  }
+
+  Message_ProgressScope aPS(theProgress,
+                            "Writing DXF file",
+                            aPrototypes.Length() + aRoots.Length() + 1);
+  DEDXF_GroupCodeWriter aWriter(theStream, myIsBinary, true);
+  aWriter.WriteSentinel();
+  writeHeader(aWriter);
+  aPS.Next();
+
+  aWriter.String(0, "SECTION");
+  aWriter.String(2, "BLOCKS");
+  for (TDF_LabelSequence::Iterator aProtoIter(aPrototypes); aProtoIter.More() && aPS.More();
+       aProtoIter.Next())
+  {
+    writeBlock(aWriter, aProtoIter.Value());
+    aPS.Next();
+  }
+  aWriter.String(0, "ENDSEC");
+
+  aWriter.String(0, "SECTION");
+  aWriter.String(2, "ENTITIES");
+  for (TDF_LabelSequence::Iterator aRootIter(aRoots); aRootIter.More() && aPS.More();
+       aRootIter.Next())
+  {
+    if (XCAFDoc_ShapeTool::IsAssembly(aRootIter.Value()))
+    {
+      writeInsert(aWriter, aRootIter.Value(), aRootIter.Value(), TopLoc_Location());
+    }
+    else
+    {
+      writePart(aWriter, aRootIter.Value(), false);
+    }
+    aPS.Next();
+  }
+  aWriter.String(0, "ENDSEC");
+  aWriter.String(0, "EOF");
+  if (!aPS.More())
+  {
+    return false;
+  }
+  if (!aWriter.IsDone())
+  {
+    Message::SendFail() << "Error in the DEDXF_StreamWriter: unable to write the stream";
+    return false;
+  }
+  return true;
+}
+
+//=======================================================================
+// function : collectPrototypes
+// purpose  :
+//=======================================================================
+void DEDXF_StreamWriter::collectPrototypes(const TDF_Label&   theLabel,
+                                           TDF_LabelSequence& thePrototypes,
+                                           TDF_LabelMap&      theVisited) const
+{
+  if (!theVisited.Add(theLabel))
+  {
+    return;
+  }
+  TDF_LabelSequence aComponents;
+  myShapeTool->GetComponents(theLabel, aComponents, Standard_False);
+  for (TDF_LabelSequence::Iterator aCompIter(aComponents); aCompIter.More(); aCompIter.Next())
+  {
+    TDF_Label aReferred;
+    if (XCAFDoc_ShapeTool::GetReferredShape(aCompIter.Value(), aReferred))
+    {
+      collectPrototypes(aReferred, thePrototypes, theVisited);
+    }
+  }
+  // nested BLOCKs are defined before the BLOCKs inserting them
+  thePrototypes.Append(theLabel);
+}
+
+//=======================================================================
+// function : registerBlock
+// purpose  :
+//=======================================================================
+void DEDXF_StreamWriter::registerBlock(const TDF_Label& theLabel)
+{
+  TCollection_AsciiString aBaseName = myToWriteNames ? dxfName(labelName(theLabel)) : "";
+  if (aBaseName.IsEmpty() || aBaseName.Value(1) == '*')
+  {
+    // names starting with '*' are reserved for anonymous blocks
+    aBaseName = "BLOCK";
+  }
+  TCollection_AsciiString aName = aBaseName;
+  for (int aSuffix = 1; myUsedNames.Contains(aName); ++aSuffix)
+  {
+    aName = aBaseName + "_" + aSuffix;
+  }
+  myUsedNames.Add(aName);
+  myBlockNames.Bind(theLabel, aName);
+}
+
+//=======================================================================
+// function : writeHeader
+// purpose  :
+//=======================================================================
+void DEDXF_StreamWriter::writeHeader(DEDXF_GroupCodeWriter& theWriter)
+{
+  theWriter.String(0, "SECTION");
+  theWriter.String(2, "HEADER");
+  theWriter.String(9, "$ACADVER");
+  theWriter.String(1, "AC1009");
+  theWriter.String(0, "ENDSEC");
+
+  theWriter.String(0, "SECTION");
+  theWriter.String(2, "TABLES");
+  theWriter.String(0, "TABLE");
+  theWriter.String(2, "LTYPE");
+  theWriter.Integer(70, 1);
+  theWriter.String(0, "LTYPE");
+  theWriter.String(2, "CONTINUOUS");
+  theWriter.Integer(70, 0);
+  theWriter.String(3, "Solid line");
+  theWriter.Integer(72, 65);
+  theWriter.Integer(73, 0);
+  theWriter.Real(40, 0.0);
+  theWriter.String(0, "ENDTAB");
+
+  // layer "0" always exists
+  NCollection_IndexedMap<TCollection_AsciiString> aLayers;
+  NCollection_Vector<int>                         aLayerColors;
+  aLayers.Add("0");
+  aLayerColors.Append(7);
+  TDF_LabelSequence aLayerLabels;
+  myLayerTool->GetLayerLabels(aLayerLabels);
+  for (TDF_LabelSequence::Iterator aLayerIter(aLayerLabels); aLayerIter.More(); aLayerIter.Next())
+  {
+    TCollection_ExtendedString aLayerName;
+    myLayerTool->GetLayer(aLayerIter.Value(), aLayerName);
+    const TCollection_AsciiString aName = dxfName(TCollection_AsciiString(aLayerName));
+    if (aName.IsEmpty() || aLayers.Contains(aName))
+    {
+      continue;
+    }
+    Quantity_Color aColor;
+    int            aColorIndex = 7;
+    if (myToWriteColors && myColorTool->GetColor(aLayerIter.Value(), XCAFDoc_ColorGen, aColor))
+    {
+      aColorIndex = ColorIndex(aColor);
+    }
+    // negative color index marks switched off layer
+    aLayers.Add(aName);
+    aLayerColors.Append(myLayerTool->IsVisible(aLayerIter.Value()) ? aColorIndex : -aColorIndex);
+  }
+
+  theWriter.String(0, "TABLE");
+  theWriter.String(2, "LAYER");
+  theWriter.Integer(70, aLayers.Extent());
+  for (int aLayerIter = 1; aLayerIter <= aLayers.Extent(); ++aLayerIter)
+  {
+    theWriter.String(0, "LAYER");
+    theWriter.String(2, aLayers.FindKey(aLayerIter));
+    theWriter.Integer(70, 0);
+    theWriter.Integer(62, aLayerColors.Value(aLayerIter - 1));
+    theWriter.String(6, "CONTINUOUS");
+  }
+  theWriter.String(0, "ENDTAB");
+  theWriter.String(0, "ENDSEC");
+}
+
+//=======================================================================
+// function : writeBlock
+// purpose  :
+//=======================================================================
+void DEDXF_StreamWriter::writeBlock(DEDXF_GroupCodeWriter& theWriter, const TDF_Label& theLabel)
+{
+  const TCollection_AsciiString& aName = myBlockNames.Find(theLabel);
+  theWriter.String(0, "BLOCK");
+  theWriter.String(8, "0");
+  theWriter.String(2, aName);
+  theWriter.Integer(70, 0);
+  theWriter.Point(10, gp_XYZ(0.0, 0.0, 0.0));
+  theWriter.String(3, aName);
+  if (XCAFDoc_ShapeTool::IsAssembly(theLabel))
+  {
+    writeComponents(theWriter, theLabel);
+  }
+  else
+  {
+    writePart(theWriter, theLabel, true);
+  }
+  theWriter.String(0, "ENDBLK");
+  theWriter.String(8, "0");
+}
+
+//=======================================================================
+// function : writeComponents
+// purpose  :
+//=======================================================================
+void DEDXF_StreamWriter::writeComponents(DEDXF_GroupCodeWriter& theWriter,
+                                         const TDF_Label&       theLabel)
+{
+  TDF_LabelSequence aComponents;
+  myShapeTool->GetComponents(theLabel, aComponents, Standard_False);
+  for (TDF_LabelSequence::Iterator aCompIter(aComponents); aCompIter.More(); aCompIter.Next())
+  {
+    TDF_Label aReferred;
+    if (XCAFDoc_ShapeTool::GetReferredShape(aCompIter.Value(), aReferred))
+    {
+      writeInsert(theWriter,
+                  aCompIter.Value(),
+                  aReferred,
+                  XCAFDoc_ShapeTool::GetLocation(aCompIter.Value()));
+    }
+  }
+}
+
+//=======================================================================
+// function : writeInsert
+// purpose  :
+//=======================================================================
+void DEDXF_StreamWriter::writeInsert(DEDXF_GroupCodeWriter& theWriter,
+                                     const TDF_Label&       theInstance,
+                                     const TDF_Label&       thePrototype,
+                                     const TopLoc_Location& theLocation)
+{
+  const TCollection_AsciiString* aName = myBlockNames.Seek(thePrototype);
+  if (aName == NULL)
+  {
+    return;
+  }
+
+  // decompose the transformation into scales, rotation around the extrusion and insertion point
+  const gp_Trsf aTrsf   = theLocation.Transformation();
+  const gp_Mat  aMatrix = aTrsf.VectorialPart();
+  const gp_XYZ  aColX   = aMatrix.Column(1);
+  const gp_XYZ  aColY   = aMatrix.Column(2);
+  const gp_XYZ  aColZ   = aMatrix.Column(3);
+  const gp_Dir  aDirX(aColX);
+  const gp_Dir  aDirY(aColY);
+  const DEDXF_Ocs     anOcs(aDirX.Crossed(aDirY));
+  const Standard_Real aScaleX = aColX.Modulus();
+  const Standard_Real aScaleY = aColY.Modulus();
+  const Standard_Real aScaleZ =
+    aColZ.Dot(anOcs.Normal.XYZ()) < 0.0 ? -aColZ.Modulus() : aColZ.Modulus();
+  const Standard_Real aRotation = normalizeDegrees(anOcs.Angle(aDirX));
+
+  writeEntityStart(theWriter,
+                   "INSERT",
+                   labelLayer(theInstance, "0"),
+                   labelColor(theInstance, false, 256));
+  theWriter.String(2, *aName);
+  theWriter.Point(10, anOcs.Transform(aTrsf.TranslationPart()));
+  if (Abs(aScaleX - 1.0) > Precision::Confusion() || Abs(aScaleY - 1.0) > Precision::Confusion()
+      || Abs(aScaleZ - 1.0) > Precision::Confusion())
+  {
+    theWriter.Real(41, aScaleX);
+    theWriter.Real(42, aScaleY);
+    theWriter.Real(43, aScaleZ);
+  }
+  if (aRotation > Precision::Angular() && aRotation < 360.0 - Precision::Angular())
+  {
+    theWriter.Real(50, aRotation);
+  }
+  writeExtrusion(theWriter, anOcs);
+}
+
+//=======================================================================
+// function : writePart
+// purpose  :
+//=======================================================================
+void DEDXF_StreamWriter::writePart(DEDXF_GroupCodeWriter& theWriter,
+                                   const TDF_Label&       theLabel,
+                                   const bool             theIsInBlock)
+{
+  const TopoDS_Shape aShape = XCAFDoc_ShapeTool::GetShape(theLabel);
+  if (aShape.IsNull())
+  {
+    return;
+  }
+  // entities without own color inside BLOCKs take the color of the INSERT
+  const TCollection_AsciiString aLayer       = labelLayer(theLabel, "0");
+  const int                     aDefault     = theIsInBlock ? 0 : 256;
+  const int                     aFaceColor   = labelColor(theLabel, false, aDefault);
+  const int                     anEdgeColor  = labelColor(theLabel, true, aDefault);
+
+  NCollection_DataMap<TopoDS_Shape, TDF_Label, TopTools_ShapeMapHasher> aSubLabels;
+  TDF_LabelSequence                                                     aSubShapes;
+  XCAFDoc_ShapeTool::GetSubShapes(theLabel, aSubShapes);
+  for (TDF_LabelSequence::Iterator aSubIter(aSubShapes); aSubIter.More(); aSubIter.Next())
+  {
+    aSubLabels.Bind(XCAFDoc_ShapeTool::GetShape(aSubIter.Value()), aSubIter.Value());
+  }
+
+  bool toMesh = false;
+  for (TopExp_Explorer aFaceIter(aShape, TopAbs_FACE); aFaceIter.More() && !toMesh;
+       aFaceIter.Next())
+  {
+    TopLoc_Location aLoc;
+    toMesh = BRep_Tool::Triangulation(TopoDS::Face(aFaceIter.Current()), aLoc).IsNull();
+  }
+  // the triangulation is computed on a copy, the shapes of the document are kept untouched
+  BRepBuilderAPI_Copy aCopier;
+  if (toMesh)
+  {
+    aCopier.Perform(aShape, Standard_False, Standard_False);
+    BRepMesh_IncrementalMesh aMesher(aCopier.Shape(), myDeflection, Standard_True);
+  }
+
+  for (TopExp_Explorer aFaceIter(aShape, TopAbs_FACE); aFaceIter.More(); aFaceIter.Next())
+  {
+    const TopoDS_Face& aFace = TopoDS::Face(aFaceIter.Current());
+    const TopoDS_Face  aMeshedFace =
+      toMesh ? TopoDS::Face(aCopier.ModifiedShape(aFace)) : aFace;
+    TopLoc_Location                   aLoc;
+    const Handle(Poly_Triangulation)& aTris = BRep_Tool::Triangulation(aMeshedFace, aLoc);
+    if (aTris.IsNull())
+    {
+      continue;
+    }
+    const TDF_Label*              aSubLabel = aSubLabels.Seek(aFace);
+    const TCollection_AsciiString aFaceLayer =
+      aSubLabel != NULL ? labelLayer(*aSubLabel, aLayer) : aLayer;
+    const int aColor = aSubLabel != NULL ? labelColor(*aSubLabel, false, aFaceColor) : aFaceColor;
+    const gp_Trsf aTrsf       = aLoc.Transformation();
+    const bool    isReversed  = aFace.Orientation() == TopAbs_REVERSED;
+    for (int aTriIter = 1; aTriIter <= aTris->NbTriangles(); ++aTriIter)
+    {
+      int aNode1 = 0, aNode2 = 0, aNode3 = 0;
+      aTris->Triangle(aTriIter).Get(aNode1, aNode2, aNode3);
+      if (isReversed)
+      {
+        std::swap(aNode2, aNode3);
+      }
+      const gp_Pnt aPnt3 = aTris->Node(aNode3).Transformed(aTrsf);
+      writeEntityStart(theWriter, "3DFACE", aFaceLayer, aColor);
+      theWriter.Point(10, aTris->Node(aNode1).Transformed(aTrsf).XYZ());
+      theWriter.Point(11, aTris->Node(aNode2).Transformed(aTrsf).XYZ());
+      theWriter.Point(12, aPnt3.XYZ());
+      theWriter.Point(13, aPnt3.XYZ());
+    }
+  }
+
+  // edges bounding faces are represented by the triangulation
+  TopTools_IndexedDataMapOfShapeListOfShape anEdgeFaces;
+  TopExp::MapShapesAndAncestors(aShape, TopAbs_EDGE, TopAbs_FACE, anEdgeFaces);
+  for (int anEdgeIter = 1; anEdgeIter <= anEdgeFaces.Extent(); ++anEdgeIter)
+  {
+    const TopoDS_Edge& anEdge = TopoDS::Edge(anEdgeFaces.FindKey(anEdgeIter));
+    if (!anEdgeFaces.FindFromIndex(anEdgeIter).IsEmpty() || BRep_Tool::Degenerated(anEdge)
+        || !BRep_Tool::IsGeometric(anEdge))
+    {
+      continue;
+    }
+    const TDF_Label* aSubLabel = aSubLabels.Seek(anEdge);
+    writeEdge(theWriter,
+              anEdge,
+              aSubLabel != NULL ? labelLayer(*aSubLabel, aLayer) : aLayer,
+              aSubLabel != NULL ? labelColor(*aSubLabel, true, anEdgeColor) : anEdgeColor);
+  }
+}
+
+//=======================================================================
+// function : writeEdge
+// purpose  :
+//=======================================================================
+void DEDXF_StreamWriter::writeEdge(DEDXF_GroupCodeWriter&         theWriter,
+                                   const TopoDS_Edge&             theEdge,
+                                   const TCollection_AsciiString& theLayer,
+                                   const int                      theColor)
+{
+  const BRepAdaptor_Curve aCurve(theEdge);
+  const Standard_Real     aFirst = aCurve.FirstParameter();
+  const Standard_Real     aLast  = aCurve.LastParameter();
+  switch (aCurve.GetType())
+  {
+    case GeomAbs_Line: {
+      writeEntityStart(theWriter, "LINE", theLayer, theColor);
+      theWriter.Point(10, aCurve.Value(aFirst).XYZ());
+      theWriter.Point(11, aCurve.Value(aLast).XYZ());
+      return;
+    }
+    case GeomAbs_Circle: {
+      const gp_Circ   aCircle = aCurve.Circle();
+      const DEDXF_Ocs anOcs(aCircle.Axis().Direction());
+      const bool      isClosed = aLast - aFirst >= 2.0 * M_PI - Precision::PConfusion();
+      writeEntityStart(theWriter, isClosed ? "CIRCLE" : "ARC", theLayer, theColor);
+      theWriter.Point(10, anOcs.Transform(aCircle.Location().XYZ()));
+      theWriter.Real(40, aCircle.Radius());
+      if (!isClosed)
+      {
+        // parameters of the circle are counted from its X axis
+        const Standard_Real anOffset = anOcs.Angle(aCircle.XAxis().Direction());
+        theWriter.Real(50, normalizeDegrees(anOffset + aFirst * 180.0 / M_PI));
+        theWriter.Real(51, normalizeDegrees(anOffset + aLast * 180.0 / M_PI));
+      }
+      writeExtrusion(theWriter, anOcs);
+      return;
+    }
+    default: {
+      break;
+    }
+  }
+
+  Bnd_Box aBox;
+  BRepBndLib::Add(theEdge, aBox);
+  Standard_Real aXmin = 0.0, aYmin = 0.0, aZmin = 0.0, aXmax = 0.0, aYmax = 0.0, aZmax = 0.0;
+  aBox.Get(aXmin, aYmin, aZmin, aXmax, aYmax, aZmax);
+  const Standard_Real aSize = Max(aXmax - aXmin, Max(aYmax - aYmin, aZmax - aZmin));
+  const Standard_Real aDeflection = Max(aSize * myDeflection, Precision::Confusion());
+  const GCPnts_TangentialDeflection aPoints(aCurve, THE_ANGULAR_DEFLECTION, aDeflection);
+  if (aPoints.NbPoints() < 2)
+  {
+    return;
+  }
+  writeEntityStart(theWriter, "POLYLINE", theLayer, theColor);
+  theWriter.Integer(66, 1);
+  theWriter.Point(10, gp_XYZ(0.0, 0.0, 0.0));
+  theWriter.Integer(70, 8);
+  for (int aPntIter = 1; aPntIter <= aPoints.NbPoints(); ++aPntIter)
+  {
+    writeEntityStart(theWriter, "VERTEX", theLayer, theColor);
+    theWriter.Point(10, aPoints.Value(aPntIter).XYZ());
+    theWriter.Integer(70, 32);
+  }
+  writeEntityStart(theWriter, "SEQEND", theLayer, theColor);
+}
+
+//=======================================================================
+// function : writeEntityStart
+// purpose  :
+//=======================================================================
+void DEDXF_StreamWriter::writeEntityStart(DEDXF_GroupCodeWriter&         theWriter,
+                                          const char*                    theType,
+                                          const TCollection_AsciiString& theLayer,
+                                          const int                      theColor)
+{
+  theWriter.String(0, theType);
+  theWriter.String(8, theLayer);
+  if (theColor != 256)
+  {
+    theWriter.Integer(62, theColor);
+  }
+}
+
+//=======================================================================
+// function : labelColor
+// purpose  :
+//=======================================================================
+int DEDXF_StreamWriter::labelColor(const TDF_Label& theLabel,
+                                   const bool       theIsCurve,
+                                   const int        theDefault) const
+{
+  const XCAFDoc_ColorType aType = theIsCurve ? XCAFDoc_ColorCurv : XCAFDoc_ColorSurf;
+  Quantity_Color          aColor;
+  if (myToWriteColors
+      && (myColorTool->GetColor(theLabel, aType, aColor)
+          || myColorTool->GetColor(theLabel, XCAFDoc_ColorGen, aColor)))
+  {
+    return ColorIndex(aColor);
+  }
+  return theDefault;
+}
+
+//=======================================================================
+// function : labelLayer
+// purpose  :
+//=======================================================================
+TCollection_AsciiString DEDXF_StreamWriter::labelLayer(
+  const TDF_Label&               theLabel,
+  const TCollection_AsciiString& theDefault) const
+{
+  Handle(TColStd_HSequenceOfExtendedString) aLayers;
+  if (myLayerTool->GetLayers(theLabel, aLayers) && !aLayers.IsNull() && !aLayers->IsEmpty())
+  {
+    const TCollection_AsciiString aName = dxfName(TCollection_AsciiString(aLayers->First()));
+    if (!aName.IsEmpty())
+    {
+      return aName;
+    }
+  }
+  return theDefault;
+}
@@ -0,0 +1,153 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#ifndef _DEDXF_StreamWriter_HeaderFile
+#define _DEDXF_StreamWriter_HeaderFile
+
+#include <Message_ProgressRange.hxx>
+#include <NCollection_DataMap.hxx>
+#include <NCollection_Map.hxx>
+#include <Quantity_Color.hxx>
+#include <TDF_LabelMap.hxx>
+#include <TDF_LabelMapHasher.hxx>
+#include <TDF_LabelSequence.hxx>
+#include <TDocStd_Document.hxx>
+
+#include <ostream>
+
+class DEDXF_GroupCodeWriter;
+class TopoDS_Edge;
+class TopLoc_Location;
+class XCAFDoc_ColorTool;
+class XCAFDoc_LayerTool;
+class XCAFDoc_ShapeTool;
+
+//! Writes XDE document into DXF stream without building the intermediate DxfSection_Model.
+//! The document is walked once and every entity is emitted by DEDXF_GroupCodeWriter
+//! as soon as it is generated, so the memory does not depend on the size of the document:
+//! - prototypes referenced by components are written as BLOCKs, components as INSERTs
+//!   with their locations (nested assemblies produce nested BLOCKs);
+//! - free shapes which are not assemblies are written into ENTITIES section directly;
+//! - edges not bounding faces are written as LINE, CIRCLE, ARC or 3D POLYLINE entities;
+//! - faces are written as 3DFACE entities using their triangulation,
+//!   faces without triangulation are meshed with the given relative deflection;
+//! - layers are written into LAYER table, colors are mapped to the nearest AutoCAD color index.
+//! The output is DXF R12 (AC1009) in ASCII or binary form.
+class DEDXF_StreamWriter
+{
+public:
+  //! Returns the AutoCAD color index (1-255) nearest to the color.
+  Standard_EXPORT static int ColorIndex(const Quantity_Color& theColor);
+
+public:
+  //! Creates the writer.
+  Standard_EXPORT DEDXF_StreamWriter();
+
+  //! Sets the flag to write binary DXF.
+  void SetBinary(const bool theIsBinary) { myIsBinary = theIsBinary; }
+
+  //! Returns the flag to write binary DXF.
+  bool IsBinary() const { return myIsBinary; }
+
+  //! Sets the deflection factor used to discretize curves and to mesh faces without
+  //! triangulation: the deflection is the factor multiplied by the size of the edge or face.
+  void SetDeflection(const Standard_Real theDeflection) { myDeflection = theDeflection; }
+
+  //! Sets the flag to write colors.
+  void SetColorMode(const bool theToWrite) { myToWriteColors = theToWrite; }
+
+  //! Sets the flag to use names of the labels as names of BLOCKs.
+  void SetNameMode(const bool theToWrite) { myToWriteNames = theToWrite; }
+
+  //! Writes the document into the file.
+  //! @param[in] theDocument document to write
+  //! @param[in] thePath path to the output file
+  //! @param[in] theProgress progress indicator
+  //! @return false if the file cannot be written or the operation was aborted
+  Standard_EXPORT bool Perform(const Handle(TDocStd_Document)& theDocument,
+                               const TCollection_AsciiString&  thePath,
+                               const Message_ProgressRange& theProgress = Message_ProgressRange());
+
+  //! Writes the document into the stream opened in binary mode.
+  //! @param[in] theDocument document to write
+  //! @param[in] theStream output stream
+  //! @param[in] theProgress progress indicator
+  //! @return false if the stream cannot be written or the operation was aborted
+  Standard_EXPORT bool Perform(const Handle(TDocStd_Document)& theDocument,
+                               std::ostream&                   theStream,
+                               const Message_ProgressRange& theProgress = Message_ProgressRange());
+
+private:
+  //! Appends the prototypes referenced by the label to the sequence in the bottom-up order.
+  void collectPrototypes(const TDF_Label&   theLabel,
+                         TDF_LabelSequence& thePrototypes,
+                         TDF_LabelMap&      theVisited) const;
+
+  //! Registers unique BLOCK name of the prototype.
+  void registerBlock(const TDF_Label& theLabel);
+
+  //! Writes HEADER section and LAYER table.
+  void writeHeader(DEDXF_GroupCodeWriter& theWriter);
+
+  //! Writes the BLOCK of the prototype.
+  void writeBlock(DEDXF_GroupCodeWriter& theWriter, const TDF_Label& theLabel);
+
+  //! Writes the entities of the simple shape.
+  void writePart(DEDXF_GroupCodeWriter& theWriter,
+                 const TDF_Label&       theLabel,
+                 const bool             theIsInBlock);
+
+  //! Writes the entities of the components of the assembly.
+  void writeComponents(DEDXF_GroupCodeWriter& theWriter, const TDF_Label& theLabel);
+
+  //! Writes the INSERT of the prototype.
+  void writeInsert(DEDXF_GroupCodeWriter& theWriter,
+                   const TDF_Label&       theInstance,
+                   const TDF_Label&       thePrototype,
+                   const TopLoc_Location& theLocation);
+
+  //! Writes the edge as a curve entity.
+  void writeEdge(DEDXF_GroupCodeWriter&         theWriter,
+                 const TopoDS_Edge&             theEdge,
+                 const TCollection_AsciiString& theLayer,
+                 const int                      theColor);
+
+  //! Writes the common group codes of the entity.
+  void writeEntityStart(DEDXF_GroupCodeWriter&         theWriter,
+                        const char*                    theType,
+                        const TCollection_AsciiString& theLayer,
+                        const int                      theColor);
+
+  //! Returns the color index of the label, or theDefault if it has no color.
+  int labelColor(const TDF_Label& theLabel, const bool theIsCurve, const int theDefault) const;
+
+  //! Returns the layer of the label, or theDefault if it has no layer.
+  TCollection_AsciiString labelLayer(const TDF_Label&               theLabel,
+                                     const TCollection_AsciiString& theDefault) const;
+
+private:
+  Handle(XCAFDoc_ShapeTool)                myShapeTool;     //!< shape tool of the written document
+  Handle(XCAFDoc_ColorTool)                myColorTool;     //!< color tool of the written document
+  Handle(XCAFDoc_LayerTool)                myLayerTool;     //!< layer tool of the written document
+  NCollection_DataMap<TDF_Label, TCollection_AsciiString, TDF_LabelMapHasher>
+                                           myBlockNames;    //!< names of BLOCKs of prototypes
+  NCollection_Map<TCollection_AsciiString> myUsedNames;     //!< names of BLOCKs in use
+  Standard_Real                            myDeflection;    //!< deflection factor of discretization
+  bool                                     myIsBinary;      //!< binary output flag
+  bool                                     myToWriteColors; //!< flag to write colors
+  bool                                     myToWriteNames;  //!< flag to name BLOCKs by labels
+};
+
+#endif // _DEDXF_StreamWriter_HeaderFile
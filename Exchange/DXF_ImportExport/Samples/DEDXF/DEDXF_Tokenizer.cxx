@@ -0,0 +1,718 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#include <DEDXF_Tokenizer.hxx>
+
+#include <DEDXF_GroupCodeWriter.hxx>
+#include <Message_ProgressScope.hxx>
+#include <OSD_FileSystem.hxx>
+#include <OSD_Parallel.hxx>
+#include <Standard_CString.hxx>
+
+#include <algorithm>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace
+{
+//! Minimal size of the chunk tokenized by a single task.
+static const size_t THE_MIN_CHUNK_SIZE = 256 * 1024;
+
+//! Returns the end of the line starting at theFrom (position of '\n' or theTo).
+static size_t lineEnd(const char* theData, const size_t theFrom, const size_t theTo)
+{
+  size_t anEnd = theFrom;
+  while (anEnd < theTo && theData[anEnd] != '\n')
+  {
+    ++anEnd;
+  }
+  return anEnd;
+}
+
+//! Trims spaces, tabs and carriage returns around the range [theFrom, theTo).
+static void trimRange(const char* theData, size_t& theFrom, size_t& theTo)
+{
+  while (theFrom < theTo
+         && (theData[theFrom] == ' ' || theData[theFrom] == '\t' || theData[theFrom] == '\r'))
+  {
+    ++theFrom;
+  }
+  while (theTo > theFrom
+         && (theData[theTo - 1] == ' ' || theData[theTo - 1] == '\t'
+             || theData[theTo - 1] == '\r'))
+  {
+    --theTo;
+  }
+}
+
+//! Checks if the line may be a value of "0" group code: entity, table or section keyword.
+//! Group code lines never contain letters, so the keyword cannot be confused with them.
+static bool isKeywordLine(const char* theData, size_t theFrom, size_t theTo)
+{
+  trimRange(theData, theFrom, theTo);
+  bool hasLetter = false;
+  for (size_t aPos = theFrom; aPos < theTo; ++aPos)
+  {
+    const char aChar = theData[aPos];
+    if (aChar >= 'A' && aChar <= 'Z')
+    {
+      hasLetter = true;
+    }
+    else if (!(aChar >= '0' && aChar <= '9') && aChar != '_')
+    {
+      return false;
+    }
+  }
+  return hasLetter;
+}
+
+//! Copies the value into null-terminated buffer for numeric conversion.
+static void copyNumber(const char* theValue, const size_t theLength, char (&theBuffer)[64])
+{
+  const size_t aLength = theLength < sizeof(theBuffer) - 1 ? theLength : sizeof(theBuffer) - 1;
+  memcpy(theBuffer, theValue, aLength);
+  theBuffer[aLength] = '\0';
+}
+
+//! Returns the size of the binary value of the type, 0 for values of variable size.
+static size_t binaryValueSize(const DEDXF_GroupCodeWriter::ValueType theType)
+{
+  switch (theType)
+  {
+    case DEDXF_GroupCodeWriter::ValueType_Real:
+    case DEDXF_GroupCodeWriter::ValueType_Int64:
+      return 8;
+    case DEDXF_GroupCodeWriter::ValueType_Int32:
+      return 4;
+    case DEDXF_GroupCodeWriter::ValueType_Int16:
+      return 2;
+    case DEDXF_GroupCodeWriter::ValueType_Bool:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+//! Reads the little-endian unsigned integer of the given size.
+static uint64_t readLittleEndian(const char* theData, const size_t theSize)
+{
+  uint64_t aValue = 0;
+  for (size_t aByteIter = theSize; aByteIter > 0; --aByteIter)
+  {
+    aValue = (aValue << 8) | (unsigned char)theData[aByteIter - 1];
+  }
+  return aValue;
+}
+
+//! Returns the value of the hexadecimal digit, -1 for other characters.
+static int hexDigit(const char theChar)
+{
+  if (theChar >= '0' && theChar <= '9')
+  {
+    return theChar - '0';
+  }
+  if (theChar >= 'A' && theChar <= 'F')
+  {
+    return theChar - 'A' + 10;
+  }
+  if (theChar >= 'a' && theChar <= 'f')
+  {
+    return theChar - 'a' + 10;
+  }
+  return -1;
+}
+} // namespace
+
+//=======================================================================
+// function : IsBinaryContent
+// purpose  :
+//=======================================================================
+bool DEDXF_Tokenizer::IsBinaryContent(const char* theData, const size_t theSize)
+{
+  const size_t aLength = DEDXF_GroupCodeWriter::BinarySentinelLength();
+  return theData != NULL && theSize >= aLength
+         && memcmp(theData, DEDXF_GroupCodeWriter::BinarySentinel(), aLength) == 0;
+}
+
+//=======================================================================
+// function : IsBinaryFile
+// purpose  :
+//=======================================================================
+bool DEDXF_Tokenizer::IsBinaryFile(const TCollection_AsciiString& thePath)
+{
+  const Handle(OSD_FileSystem)& aFileSystem = OSD_FileSystem::DefaultFileSystem();
+  std::shared_ptr<std::istream> aStream =
+    aFileSystem->OpenIStream(thePath, std::ios::in | std::ios::binary);
+  if (aStream.get() == nullptr || !aStream->good())
+  {
+    return false;
+  }
+  char aSentinel[32];
+  aStream->read(aSentinel, (std::streamsize)DEDXF_GroupCodeWriter::BinarySentinelLength());
+  return IsBinaryContent(aSentinel, (size_t)aStream->gcount());
+}
+
+//=======================================================================
+// function : DEDXF_Tokenizer
+// purpose  :
+//=======================================================================
+DEDXF_Tokenizer::DEDXF_Tokenizer()
+    : myNbChunks(0),
+      myIsBinary(false)
+{
+}
+
+//=======================================================================
+// function : Load
+// purpose  :
+//=======================================================================
+bool DEDXF_Tokenizer::Load(const TCollection_AsciiString& thePath)
+{
+  myContent.Nullify();
+  myTokens.clear();
+  const Handle(OSD_FileSystem)& aFileSystem = OSD_FileSystem::DefaultFileSystem();
+  std::shared_ptr<std::istream> aStream =
+    aFileSystem->OpenIStream(thePath, std::ios::in | std::ios::binary);
+  if (aStream.get() == nullptr || !aStream->good())
+  {
+    myErrorMessage = TCollection_AsciiString("unable to open the file ") + thePath;
+    return false;
+  }
+  aStream->seekg(0, std::ios::end);
+  const std::streamoff aSize = aStream->tellg();
+  aStream->seekg(0, std::ios::beg);
+  if (aSize <= 0)
+  {
+    myErrorMessage = TCollection_AsciiString("empty file ") + thePath;
+    return false;
+  }
+
+  Handle(NCollection_Buffer) aContent =
+    new NCollection_Buffer(NCollection_BaseAllocator::CommonBaseAllocator(), (size_t)aSize);
+  if (aContent->IsEmpty() || !aStream->read((char*)aContent->ChangeData(), aSize))
+  {
+    myErrorMessage = TCollection_AsciiString("unable to read the file ") + thePath;
+    return false;
+  }
+  myContent = aContent;
+  return true;
+}
+
+//=======================================================================
+// function : SetContent
+// purpose  :
+//=======================================================================
+void DEDXF_Tokenizer::SetContent(const Handle(NCollection_Buffer)& theContent)
+{
+  myContent = theContent;
+  // clear() would keep the capacity of the vector
+  std::vector<Token>().swap(myTokens);
+}
+
+//=======================================================================
+// function : Perform
+// purpose  :
+//=======================================================================
+bool DEDXF_Tokenizer::Perform(const bool theToParallel, const Message_ProgressRange& theProgress)
+{
+  myTokens.clear();
+  myErrorMessage.Clear();
+  myNbChunks = 0;
+  myIsBinary = false;
+  if (myContent.IsNull() || myContent->IsEmpty())
+  {
+    myErrorMessage = "empty content";
+    return false;
+  }
+
+  const char*  aData = reinterpret_cast<const char*>(myContent->Data());
+  const size_t aSize = myContent->Size();
+  if (IsBinaryContent(aData, aSize))
+  {
+    // pairs of binary content cannot be located from an arbitrary position
+    myIsBinary = true;
+    myNbChunks = 1;
+    Message_ProgressScope aPS(theProgress, "Tokenizing binary DXF content", 1);
+    if (!tokenizeBinary(myTokens))
+    {
+      const size_t anOffset = myTokens.empty() ? 0 : myTokens.back().ValueOffset;
+      myErrorMessage = TCollection_AsciiString("invalid binary group code near offset ")
+                       + TCollection_AsciiString((double)anOffset);
+      myTokens.clear();
+      return false;
+    }
+    aPS.Next();
+    return !myTokens.empty();
+  }
+  size_t       aStart = 0;
+  if (aSize >= 3 && (unsigned char)aData[0] == 0xEF && (unsigned char)aData[1] == 0xBB
+      && (unsigned char)aData[2] == 0xBF)
+  {
+    // UTF-8 byte order mark
+    aStart = 3;
+  }
+
+  int aNbChunks = 1;
+  if (theToParallel && aSize >= 2 * THE_MIN_CHUNK_SIZE)
+  {
+    aNbChunks = (int)std::min((size_t)OSD_Parallel::NbLogicalProcessors() * 4,
+                              aSize / THE_MIN_CHUNK_SIZE);
+  }
+  std::vector<size_t> aBounds(aNbChunks + 1, aSize);
+  aBounds[0] = aStart;
+  for (int aChunkIter = 1; aChunkIter < aNbChunks; ++aChunkIter)
+  {
+    const size_t aFrom = aStart + (aSize - aStart) / aNbChunks * aChunkIter;
+    aBounds[aChunkIter] = std::max(aBounds[aChunkIter - 1], chunkStart(aFrom));
+  }
+
+  Message_ProgressScope              aPS(theProgress, "Tokenizing DXF content", aNbChunks);
+  std::vector<Message_ProgressRange> aRanges;
+  aRanges.reserve(aNbChunks);
+  for (int aChunkIter = 0; aChunkIter < aNbChunks; ++aChunkIter)
+  {
+    aRanges.push_back(aPS.Next());
+  }
+
+  std::vector<std::vector<Token>> aChunkTokens(aNbChunks);
+  std::vector<char>               aChunkStatus(aNbChunks, 0);
+  OSD_Parallel::For(
+    0,
+    aNbChunks,
+    [&](const int theChunk) {
+      Message_ProgressScope aChunkScope(aRanges[theChunk], NULL, 1);
+      if (!aChunkScope.More())
+      {
+        return;
+      }
+      aChunkStatus[theChunk] =
+        tokenize(aBounds[theChunk], aBounds[theChunk + 1], aChunkTokens[theChunk]) ? 1 : 0;
+      aChunkScope.Next();
+    },
+    aNbChunks == 1);
+  if (!aPS.More())
+  {
+    myErrorMessage = "operation aborted";
+    return false;
+  }
+
+  size_t aNbTokens = 0;
+  for (int aChunkIter = 0; aChunkIter < aNbChunks; ++aChunkIter)
+  {
+    if (aChunkStatus[aChunkIter] == 0)
+    {
+      const std::vector<Token>& aTokens = aChunkTokens[aChunkIter];
+      const size_t              anOffset =
+        aTokens.empty() ? aBounds[aChunkIter] : aTokens.back().ValueOffset;
+      myErrorMessage = TCollection_AsciiString("invalid group code near offset ")
+                       + TCollection_AsciiString((double)anOffset);
+      return false;
+    }
+    aNbTokens += aChunkTokens[aChunkIter].size();
+  }
+
+  myTokens.reserve(aNbTokens);
+  for (int aChunkIter = 0; aChunkIter < aNbChunks; ++aChunkIter)
+  {
+    myTokens.insert(myTokens.end(),
+                    aChunkTokens[aChunkIter].begin(),
+                    aChunkTokens[aChunkIter].end());
+    std::vector<Token>().swap(aChunkTokens[aChunkIter]);
+  }
+  myNbChunks = aNbChunks;
+  return !myTokens.empty();
+}
+
+//=======================================================================
+// function : chunkStart
+// purpose  :
+//=======================================================================
+size_t DEDXF_Tokenizer::chunkStart(const size_t theFrom) const
+{
+  const char*  aData = reinterpret_cast<const char*>(myContent->Data());
+  const size_t aSize = myContent->Size();
+  size_t       aLine = theFrom;
+  if (aLine > 0 && aData[aLine - 1] != '\n')
+  {
+    aLine = lineEnd(aData, aLine, aSize) + 1;
+  }
+  while (aLine < aSize)
+  {
+    const size_t aLineEnd = lineEnd(aData, aLine, aSize);
+    if (aLineEnd >= aSize)
+    {
+      break;
+    }
+    size_t aCodeFrom = aLine, aCodeTo = aLineEnd;
+    trimRange(aData, aCodeFrom, aCodeTo);
+    if (aCodeTo == aCodeFrom + 1 && aData[aCodeFrom] == '0'
+        && isKeywordLine(aData, aLineEnd + 1, lineEnd(aData, aLineEnd + 1, aSize)))
+    {
+      return aLine;
+    }
+    aLine = aLineEnd + 1;
+  }
+  return aSize;
+}
+
+//=======================================================================
+// function : tokenize
+// purpose  :
+//=======================================================================
+bool DEDXF_Tokenizer::tokenize(const size_t        theFrom,
+                               const size_t        theTo,
+                               std::vector<Token>& theTokens) const
+{
+  const char* aData = reinterpret_cast<const char*>(myContent->Data());
+  theTokens.reserve((theTo - theFrom) / 16);
+  size_t aPos = theFrom;
+  while (aPos < theTo)
+  {
+    const size_t aCodeEnd  = lineEnd(aData, aPos, theTo);
+    size_t       aCodeFrom = aPos, aCodeTo = aCodeEnd;
+    trimRange(aData, aCodeFrom, aCodeTo);
+    if (aCodeFrom == aCodeTo)
+    {
+      // tolerate empty lines after the last pair
+      aPos = aCodeEnd + 1;
+      continue;
+    }
+
+    int    aCode     = 0;
+    bool   isNegative = false;
+    size_t aDigitPos = aCodeFrom;
+    if (aData[aDigitPos] == '-')
+    {
+      isNegative = true;
+      ++aDigitPos;
+    }
+    if (aDigitPos == aCodeTo)
+    {
+      return false;
+    }
+    for (; aDigitPos < aCodeTo; ++aDigitPos)
+    {
+      if (aData[aDigitPos] < '0' || aData[aDigitPos] > '9')
+      {
+        return false;
+      }
+      aCode = aCode * 10 + (aData[aDigitPos] - '0');
+    }
+    if (aCodeEnd >= theTo)
+    {
+      // group code without value
+      return false;
+    }
+
+    Token aToken;
+    aToken.Code        = isNegative ? -aCode : aCode;
+    aToken.ValueOffset = aCodeEnd + 1;
+    const size_t aValueEnd = lineEnd(aData, aToken.ValueOffset, theTo);
+    aToken.ValueLength     = aValueEnd - aToken.ValueOffset;
+    if (aToken.ValueLength > 0 && aData[aValueEnd - 1] == '\r')
+    {
+      --aToken.ValueLength;
+    }
+    theTokens.push_back(aToken);
+    aPos = aValueEnd + 1;
+  }
+  return true;
+}
+
+//=======================================================================
+// function : tokenizeBinary
+// purpose  :
+//=======================================================================
+bool DEDXF_Tokenizer::tokenizeBinary(std::vector<Token>& theTokens) const
+{
+  const char*  aData = reinterpret_cast<const char*>(myContent->Data());
+  const size_t aSize = myContent->Size();
+  size_t       aPos  = DEDXF_GroupCodeWriter::BinarySentinelLength();
+  // the first group code is 0 (SECTION): its second byte is zero for 2-byte group codes
+  const bool isShortCodes = !(aPos + 1 < aSize && aData[aPos + 1] == '\0');
+  theTokens.reserve((aSize - aPos) / 12);
+  while (aPos < aSize)
+  {
+    int aCode = 0;
+    if (isShortCodes && (unsigned char)aData[aPos] != 255)
+    {
+      aCode = (unsigned char)aData[aPos];
+      ++aPos;
+    }
+    else
+    {
+      // 255 escapes 2-byte group code in DXF R12
+      const size_t aCodePos = isShortCodes ? aPos + 1 : aPos;
+      if (aCodePos + 2 > aSize)
+      {
+        return false;
+      }
+      aCode = (int16_t)readLittleEndian(aData + aCodePos, 2);
+      aPos  = aCodePos + 2;
+    }
+
+    Token aToken;
+    aToken.Code = aCode;
+    const DEDXF_GroupCodeWriter::ValueType aType = DEDXF_GroupCodeWriter::Type(aCode);
+    if (aType == DEDXF_GroupCodeWriter::ValueType_String)
+    {
+      const char* anEnd = static_cast<const char*>(memchr(aData + aPos, '\0', aSize - aPos));
+      if (anEnd == NULL)
+      {
+        return false;
+      }
+      aToken.ValueOffset = aPos;
+      aToken.ValueLength = (size_t)(anEnd - aData) - aPos;
+      aPos += aToken.ValueLength + 1;
+    }
+    else if (aType == DEDXF_GroupCodeWriter::ValueType_Binary)
+    {
+      if (aPos >= aSize)
+      {
+        return false;
+      }
+      aToken.ValueOffset = aPos + 1;
+      aToken.ValueLength = (unsigned char)aData[aPos];
+      aPos += aToken.ValueLength + 1;
+    }
+    else
+    {
+      aToken.ValueOffset = aPos;
+      aToken.ValueLength = binaryValueSize(aType);
+      aPos += aToken.ValueLength;
+    }
+    if (aPos > aSize)
+    {
+      return false;
+    }
+    theTokens.push_back(aToken);
+    if (aCode == 0 && aToken.ValueLength == 3 && memcmp(aData + aToken.ValueOffset, "EOF", 3) == 0)
+    {
+      // the data after EOF is not a part of DXF stream
+      break;
+    }
+  }
+  return true;
+}
+
+//=======================================================================
+// function : StringValue
+// purpose  :
+//=======================================================================
+TCollection_AsciiString DEDXF_Tokenizer::StringValue(const size_t theIndex) const
+{
+  const Token& aToken = myTokens[theIndex];
+  if (!myIsBinary)
+  {
+    return TCollection_AsciiString(valueData(theIndex), (int)aToken.ValueLength);
+  }
+  char aBuffer[64];
+  switch (DEDXF_GroupCodeWriter::Type(aToken.Code))
+  {
+    case DEDXF_GroupCodeWriter::ValueType_String:
+      return TCollection_AsciiString(valueData(theIndex), (int)aToken.ValueLength);
+    case DEDXF_GroupCodeWriter::ValueType_Real:
+      Sprintf(aBuffer, "%.16g", RealValue(theIndex));
+      return TCollection_AsciiString(aBuffer);
+    case DEDXF_GroupCodeWriter::ValueType_Binary: {
+      static const char       THE_HEX_DIGITS[] = "0123456789ABCDEF";
+      const char*             aData            = valueData(theIndex);
+      TCollection_AsciiString aHex;
+      for (size_t aByteIter = 0; aByteIter < aToken.ValueLength; ++aByteIter)
+      {
+        aHex += THE_HEX_DIGITS[(unsigned char)aData[aByteIter] >> 4];
+        aHex += THE_HEX_DIGITS[(unsigned char)aData[aByteIter] & 0x0F];
+      }
+      return aHex;
+    }
+    default:
+      Sprintf(aBuffer, "%lld", (long long)integerValue(theIndex));
+      return TCollection_AsciiString(aBuffer);
+  }
+}
+
+//=======================================================================
+// function : IntegerValue
+// purpose  :
+//=======================================================================
+int DEDXF_Tokenizer::IntegerValue(const size_t theIndex) const
+{
+  return (int)integerValue(theIndex);
+}
+
+//=======================================================================
+// function : integerValue
+// purpose  :
+//=======================================================================
+int64_t DEDXF_Tokenizer::integerValue(const size_t theIndex) const
+{
+  const Token& aToken = myTokens[theIndex];
+  const char*  aData  = valueData(theIndex);
+  if (myIsBinary)
+  {
+    switch (DEDXF_GroupCodeWriter::Type(aToken.Code))
+    {
+      case DEDXF_GroupCodeWriter::ValueType_Int16:
+        return (int16_t)readLittleEndian(aData, 2);
+      case DEDXF_GroupCodeWriter::ValueType_Int32:
+        return (int32_t)readLittleEndian(aData, 4);
+      case DEDXF_GroupCodeWriter::ValueType_Int64:
+        return (int64_t)readLittleEndian(aData, 8);
+      case DEDXF_GroupCodeWriter::ValueType_Bool:
+        return (unsigned char)aData[0];
+      case DEDXF_GroupCodeWriter::ValueType_Real:
+        return (int64_t)RealValue(theIndex);
+      case DEDXF_GroupCodeWriter::ValueType_Binary:
+        return 0;
+      default:
+        break;
+    }
+  }
+  char aBuffer[64];
+  copyNumber(aData, aToken.ValueLength, aBuffer);
+  return (int64_t)atoll(aBuffer);
+}
+
+//=======================================================================
+// function : RealValue
+// purpose  :
+//=======================================================================
+double DEDXF_Tokenizer::RealValue(const size_t theIndex) const
+{
+  const Token& aToken = myTokens[theIndex];
+  if (myIsBinary)
+  {
+    switch (DEDXF_GroupCodeWriter::Type(aToken.Code))
+    {
+      case DEDXF_GroupCodeWriter::ValueType_Real: {
+        const uint64_t aBits  = readLittleEndian(valueData(theIndex), 8);
+        double         aValue = 0.0;
+        memcpy(&aValue, &aBits, sizeof(aValue));
+        return aValue;
+      }
+      case DEDXF_GroupCodeWriter::ValueType_String:
+        break;
+      default:
+        return (double)integerValue(theIndex);
+    }
+  }
+  char aBuffer[64];
+  copyNumber(valueData(theIndex), aToken.ValueLength, aBuffer);
+  return Strtod(aBuffer, NULL);
+}
+
+//=======================================================================
+// function : BinaryValue
+// purpose  :
+//=======================================================================
+void DEDXF_Tokenizer::BinaryValue(const size_t theIndex, std::vector<uint8_t>& theBytes) const
+{
+  const Token& aToken = myTokens[theIndex];
+  const char*  aData  = valueData(theIndex);
+  theBytes.clear();
+  if (myIsBinary)
+  {
+    theBytes.assign(reinterpret_cast<const uint8_t*>(aData),
+                    reinterpret_cast<const uint8_t*>(aData) + aToken.ValueLength);
+    return;
+  }
+  theBytes.reserve(aToken.ValueLength / 2);
+  for (size_t aCharIter = 0; aCharIter + 1 < aToken.ValueLength; aCharIter += 2)
+  {
+    const int aHigh = hexDigit(aData[aCharIter]);
+    const int aLow  = hexDigit(aData[aCharIter + 1]);
+    if (aHigh < 0 || aLow < 0)
+    {
+      break;
+    }
+    theBytes.push_back((uint8_t)((aHigh << 4) | aLow));
+  }
+}
+
+//=======================================================================
+// function : IsValue
+// purpose  :
+//=======================================================================
+bool DEDXF_Tokenizer::IsValue(const size_t theIndex, const char* theKeyword) const
+{
+  if (myIsBinary
+      && DEDXF_GroupCodeWriter::Type(myTokens[theIndex].Code)
+           != DEDXF_GroupCodeWriter::ValueType_String)
+  {
+    return false;
+  }
+  const char* aData = valueData(theIndex);
+  size_t      aFrom = 0, aTo = myTokens[theIndex].ValueLength;
+  trimRange(aData, aFrom, aTo);
+  const size_t aLength = strlen(theKeyword);
+  return aTo - aFrom == aLength && memcmp(aData + aFrom, theKeyword, aLength) == 0;
+}
+
+//=======================================================================
+// function : WriteAscii
+// purpose  :
+//=======================================================================
+void DEDXF_Tokenizer::WriteAscii(std::ostream& theStream,
+                                 const size_t  theFirst,
+                                 const size_t  theLast) const
+{
+  if (myIsBinary)
+  {
+    DEDXF_GroupCodeWriter aWriter(theStream, false);
+    Write(aWriter, theFirst, theLast);
+    return;
+  }
+  char aCode[16];
+  for (size_t aTokIter = theFirst; aTokIter < theLast; ++aTokIter)
+  {
+    Sprintf(aCode, "%3d\n", myTokens[aTokIter].Code);
+    theStream << aCode;
+    theStream.write(valueData(aTokIter), (std::streamsize)myTokens[aTokIter].ValueLength);
+    theStream << "\n";
+  }
+}
+
+//=======================================================================
+// function : Write
+// purpose  :
+//=======================================================================
+void DEDXF_Tokenizer::Write(DEDXF_GroupCodeWriter& theWriter,
+                            const size_t           theFirst,
+                            const size_t           theLast) const
+{
+  std::vector<uint8_t> aBytes;
+  for (size_t aTokIter = theFirst; aTokIter < theLast; ++aTokIter)
+  {
+    const int aCode = myTokens[aTokIter].Code;
+    switch (DEDXF_GroupCodeWriter::Type(aCode))
+    {
+      case DEDXF_GroupCodeWriter::ValueType_String:
+        theWriter.String(aCode, StringValue(aTokIter));
+        break;
+      case DEDXF_GroupCodeWriter::ValueType_Real:
+        theWriter.Real(aCode, RealValue(aTokIter));
+        break;
+      case DEDXF_GroupCodeWriter::ValueType_Binary:
+        BinaryValue(aTokIter, aBytes);
+        theWriter.Binary(aCode, aBytes.data(), aBytes.size());
+        break;
+      default:
+        theWriter.Integer(aCode, integerValue(aTokIter));
+        break;
+    }
+  }
+}
@@ -0,0 +1,160 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#ifndef _DEDXF_Tokenizer_HeaderFile
+#define _DEDXF_Tokenizer_HeaderFile
+
+#include <Message_ProgressRange.hxx>
+#include <NCollection_Buffer.hxx>
+#include <TCollection_AsciiString.hxx>
+
+#include <ostream>
+#include <vector>
+
+class DEDXF_GroupCodeWriter;
+
+//! Splits the content of a DXF file into the sequence of group code / value pairs.
+//! The ASCII content is cut into chunks at "0" group codes followed by an entity
+//! or section keyword, so that no pair crosses the chunk boundary;
+//! the chunks are tokenized in parallel and the tokens are merged in the file order.
+//! The binary content (started by the "AutoCAD Binary DXF" sentinel) is tokenized
+//! sequentially; both 2-byte group codes and 1-byte group codes of DXF R12 are supported.
+//! Values are not copied: every token keeps the position of its value within the content,
+//! binary values are converted by the typed accessors according to the group code.
+//! @code
+//!   DEDXF_Tokenizer aTokenizer;
+//!   if (aTokenizer.Load (thePath) && aTokenizer.Perform (true))
+//!   {
+//!     for (size_t aTokIter = 0; aTokIter < aTokenizer.NbTokens(); ++aTokIter)
+//!     {
+//!       if (aTokenizer.Code (aTokIter) == 0 && aTokenizer.IsValue (aTokIter, "LINE")) { ... }
+//!     }
+//!   }
+//! @endcode
+class DEDXF_Tokenizer
+{
+public:
+  //! Group code / value pair.
+  struct Token
+  {
+    int    Code;        //!< group code
+    size_t ValueOffset; //!< offset of the value within the content in bytes
+    size_t ValueLength; //!< length of the value in bytes, without line ending or terminating zero
+  };
+
+public:
+  //! Checks if the data starts with the sentinel of binary DXF.
+  Standard_EXPORT static bool IsBinaryContent(const char* theData, const size_t theSize);
+
+  //! Checks if the file starts with the sentinel of binary DXF.
+  Standard_EXPORT static bool IsBinaryFile(const TCollection_AsciiString& thePath);
+
+public:
+  //! Creates an empty tokenizer.
+  Standard_EXPORT DEDXF_Tokenizer();
+
+  //! Reads the whole file into memory.
+  //! @param[in] thePath path to the DXF file
+  //! @return false if the file cannot be read
+  Standard_EXPORT bool Load(const TCollection_AsciiString& thePath);
+
+  //! Sets the content to tokenize; the memory of the previous tokens is released.
+  Standard_EXPORT void SetContent(const Handle(NCollection_Buffer)& theContent);
+
+  //! Returns the tokenized content.
+  const Handle(NCollection_Buffer)& Content() const { return myContent; }
+
+  //! Tokenizes the content.
+  //! @param[in] theToParallel flag to tokenize chunks of the content in parallel
+  //! @param[in] theProgress progress indicator
+  //! @return false if the content is not a valid DXF stream or the operation was aborted
+  Standard_EXPORT bool Perform(const bool                   theToParallel,
+                               const Message_ProgressRange& theProgress = Message_ProgressRange());
+
+  //! Returns the number of chunks used by the last Perform().
+  int NbChunks() const { return myNbChunks; }
+
+  //! Returns true if the content tokenized by the last Perform() is binary DXF.
+  bool IsBinary() const { return myIsBinary; }
+
+  //! Returns the message describing the failure of the last Perform().
+  const TCollection_AsciiString& ErrorMessage() const { return myErrorMessage; }
+
+public:
+  //! Returns the number of tokens.
+  size_t NbTokens() const { return myTokens.size(); }
+
+  //! Returns the token.
+  const Token& Value(const size_t theIndex) const { return myTokens[theIndex]; }
+
+  //! Returns the group code of the token.
+  int Code(const size_t theIndex) const { return myTokens[theIndex].Code; }
+
+  //! Returns the value of the token as a string.
+  Standard_EXPORT TCollection_AsciiString StringValue(const size_t theIndex) const;
+
+  //! Returns the value of the token as an integer, 0 if the value is not a number.
+  Standard_EXPORT int IntegerValue(const size_t theIndex) const;
+
+  //! Returns the value of the token as a real, 0.0 if the value is not a number.
+  Standard_EXPORT double RealValue(const size_t theIndex) const;
+
+  //! Returns the bytes of the binary chunk (310-319, 1004 group codes), decoding
+  //! the hexadecimal string of ASCII content.
+  Standard_EXPORT void BinaryValue(const size_t theIndex, std::vector<uint8_t>& theBytes) const;
+
+  //! Checks if the value of the token, trimmed from spaces, is equal to the keyword.
+  Standard_EXPORT bool IsValue(const size_t theIndex, const char* theKeyword) const;
+
+  //! Writes the tokens in the range [theFirst, theLast) as ASCII group code / value pairs.
+  //! The pairs of ASCII content are copied as is, the binary content is transcoded.
+  Standard_EXPORT void WriteAscii(std::ostream& theStream,
+                                  const size_t  theFirst,
+                                  const size_t  theLast) const;
+
+  //! Writes the tokens in the range [theFirst, theLast) by the group code writer
+  //! converting the values to the types of their group codes.
+  Standard_EXPORT void Write(DEDXF_GroupCodeWriter& theWriter,
+                             const size_t           theFirst,
+                             const size_t           theLast) const;
+
+private:
+  //! Returns the offset of the first pair of the chunk starting not before theFrom.
+  size_t chunkStart(const size_t theFrom) const;
+
+  //! Tokenizes the part [theFrom, theTo) of the content.
+  bool tokenize(const size_t theFrom, const size_t theTo, std::vector<Token>& theTokens) const;
+
+  //! Tokenizes the binary content.
+  bool tokenizeBinary(std::vector<Token>& theTokens) const;
+
+  //! Returns the value of the token as a 64-bit integer.
+  int64_t integerValue(const size_t theIndex) const;
+
+  //! Returns pointer to the value of the token.
+  const char* valueData(const size_t theIndex) const
+  {
+    return reinterpret_cast<const char*>(myContent->Data()) + myTokens[theIndex].ValueOffset;
+  }
+
+private:
+  Handle(NCollection_Buffer) myContent;      //!< content of the file
+  std::vector<Token>         myTokens;       //!< tokens in the file order
+  int                        myNbChunks;     //!< number of chunks of the last Perform()
+  bool                       myIsBinary;     //!< binary content flag of the last Perform()
+  TCollection_AsciiString    myErrorMessage; //!< failure description of the last Perform()
+};
+
+#endif // _DEDXF_Tokenizer_HeaderFile
@@ -0,0 +1,372 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#include <DEJT_AsyncPMIReader.hxx>
+
+#include <DEJT_Provider.hxx>
+#include <Message.hxx>
+#include <Message_ProgressIndicator.hxx>
+#include <NCollection_DataMap.hxx>
+#include <Standard_Failure.hxx>
+#include <TDataStd_Name.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <XCAFDoc_Datum.hxx>
+#include <XCAFDoc_DimTolTool.hxx>
+#include <XCAFDoc_Dimension.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_GeomTolerance.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+
+#include <chrono>
+
+IMPLEMENT_STANDARD_RTTIEXT(DEJT_AsyncPMIReader, Standard_Transient)
+
+namespace
+{
+//! Progress indicator interrupting the PMI pass on abort request.
+class DEJT_PMIAbortIndicator : public Message_ProgressIndicator
+{
+public:
+  DEJT_PMIAbortIndicator(const std::atomic<bool>& theToAbort)
+      : myToAbort(theToAbort)
+  {
+  }
+
+  virtual Standard_Boolean UserBreak() Standard_OVERRIDE { return myToAbort; }
+
+  virtual void Show(const Message_ProgressScope&, const Standard_Boolean) Standard_OVERRIDE {}
+
+private:
+  const std::atomic<bool>& myToAbort;
+};
+
+//! Copies the name of the PMI label.
+static void copyName(const TDF_Label& theSource, const TDF_Label& theTarget)
+{
+  Handle(TDataStd_Name) aName;
+  if (theSource.FindAttribute(TDataStd_Name::GetID(), aName))
+  {
+    TDataStd_Name::Set(theTarget, aName->Get());
+  }
+}
+} // namespace
+
+//=======================================================================
+// function : DEJT_AsyncPMIReader
+// purpose  :
+//=======================================================================
+DEJT_AsyncPMIReader::DEJT_AsyncPMIReader(const Handle(DEJT_ConfigurationNode)& theNode)
+    : myNode(Handle(DEJT_ConfigurationNode)::DownCast(theNode->Copy())),
+      myFirstTag(1),
+      myToAbort(false),
+      myIsDone(true)
+{
+  myFuture = myPromise.get_future().share();
+  myPromise.set_value(false);
+}
+
+//=======================================================================
+// function : ~DEJT_AsyncPMIReader
+// purpose  :
+//=======================================================================
+DEJT_AsyncPMIReader::~DEJT_AsyncPMIReader()
+{
+  Abort();
+}
+
+//=======================================================================
+// function : Perform
+// purpose  :
+//=======================================================================
+bool DEJT_AsyncPMIReader::Perform(const TCollection_AsciiString&  thePath,
+                                  const Handle(TDocStd_Document)& theDocument,
+                                  const Message_ProgressRange&    theProgress)
+{
+  Abort();
+  myPath     = thePath;
+  myDocument = theDocument;
+  myPMIDoc.Nullify();
+  myFirstTag = DEJT_Provider::NextShapeTag(theDocument);
+  myToAbort  = false;
+  myPromise  = std::promise<bool>();
+  myFuture   = myPromise.get_future().share();
+
+  Handle(DEJT_ConfigurationNode) aNode =
+    Handle(DEJT_ConfigurationNode)::DownCast(myNode->Copy());
+  aNode->InternalParameters.ReadTranslatePMI = false;
+  Handle(DEJT_Provider) aProvider            = new DEJT_Provider(aNode);
+  const bool            isDone               = aProvider->Read(thePath, theDocument, theProgress);
+  if (!isDone || !myNode->InternalParameters.ReadTranslatePMI)
+  {
+    myPromise.set_value(false);
+    return isDone;
+  }
+
+  myIsDone = false;
+  myThread = std::thread(&DEJT_AsyncPMIReader::performBackground, this);
+  return true;
+}
+
+//=======================================================================
+// function : performBackground
+// purpose  :
+//=======================================================================
+void DEJT_AsyncPMIReader::performBackground()
+{
+  Handle(DEJT_ConfigurationNode) aNode =
+    Handle(DEJT_ConfigurationNode)::DownCast(myNode->Copy());
+  // metadata and shared meshes are already in the target document
+  aNode->InternalParameters.ReadTranslateMetadata  = false;
+  aNode->InternalParameters.ReadLazyMetadata       = false;
+  aNode->InternalParameters.ReadDeduplicateMeshes  = false;
+  aNode->InternalParameters.ReadPrefetchPartitions = false;
+  aNode->InternalParameters.ReadCacheDir.Clear();
+
+  Handle(DEJT_PMIAbortIndicator) anIndicator = new DEJT_PMIAbortIndicator(myToAbort);
+  Handle(TDocStd_Document)       aDoc        = new TDocStd_Document("BinXCAF");
+  Handle(DEJT_Provider)          aProvider   = new DEJT_Provider(aNode);
+  bool                           isDone      = false;
+  try
+  {
+    isDone = aProvider->Read(myPath, aDoc, anIndicator->Start()) && !myToAbort;
+  }
+  catch (const Standard_Failure& theFailure)
+  {
+    Message::SendFail() << "Error in the DEJT_AsyncPMIReader during reading the file " << myPath
+                        << "\t: " << theFailure.GetMessageString();
+  }
+  catch (...)
+  {
+    // the promise is always satisfied, so that the waiting thread is never blocked
+    Message::SendFail() << "Error in the DEJT_AsyncPMIReader during reading the file " << myPath
+                        << "\t: unknown exception";
+  }
+  if (isDone)
+  {
+    myPMIDoc = aDoc;
+  }
+  myIsDone = true;
+  myPromise.set_value(isDone);
+}
+
+//=======================================================================
+// function : Apply
+// purpose  :
+//=======================================================================
+Standard_Integer DEJT_AsyncPMIReader::Apply()
+{
+  if (myFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready || !myFuture.get()
+      || myPMIDoc.IsNull() || myDocument.IsNull())
+  {
+    return 0;
+  }
+
+  const Handle(TDocStd_Document) aSource = myPMIDoc;
+  myPMIDoc.Nullify();
+  Handle(XCAFDoc_DimTolTool) aSourceTool = XCAFDoc_DocumentTool::DimTolTool(aSource->Main());
+  Handle(XCAFDoc_DimTolTool) aTargetTool = XCAFDoc_DocumentTool::DimTolTool(myDocument->Main());
+  TDF_LabelSequence          aTransferred;
+
+  // datums first, as tolerances refer to them
+  NCollection_DataMap<TDF_Label, TDF_Label> aDatumMap;
+  TDF_LabelSequence                         aDatums;
+  aSourceTool->GetDatumLabels(aDatums);
+  for (TDF_LabelSequence::Iterator aDatumIter(aDatums); aDatumIter.More(); aDatumIter.Next())
+  {
+    Handle(XCAFDoc_Datum) aDatum;
+    if (!aDatumIter.Value().FindAttribute(XCAFDoc_Datum::GetID(), aDatum))
+    {
+      continue;
+    }
+    TDF_LabelSequence aShapes, aShapes2, aTargetShapes;
+    XCAFDoc_DimTolTool::GetRefShapeLabel(aDatumIter.Value(), aShapes, aShapes2);
+    findTargetShapes(aShapes, aTargetShapes);
+
+    const TDF_Label aLabel = aTargetTool->AddDatum();
+    XCAFDoc_Datum::Set(aLabel)->SetObject(aDatum->GetObject());
+    copyName(aDatumIter.Value(), aLabel);
+    if (!aTargetShapes.IsEmpty())
+    {
+      aTargetTool->SetDatum(aTargetShapes, aLabel);
+    }
+    aDatumMap.Bind(aDatumIter.Value(), aLabel);
+    aTransferred.Append(aLabel);
+  }
+
+  TDF_LabelSequence aTolerances;
+  aSourceTool->GetGeomToleranceLabels(aTolerances);
+  for (TDF_LabelSequence::Iterator aTolIter(aTolerances); aTolIter.More(); aTolIter.Next())
+  {
+    Handle(XCAFDoc_GeomTolerance) aTolerance;
+    if (!aTolIter.Value().FindAttribute(XCAFDoc_GeomTolerance::GetID(), aTolerance))
+    {
+      continue;
+    }
+    TDF_LabelSequence aShapes, aShapes2, aTargetShapes;
+    XCAFDoc_DimTolTool::GetRefShapeLabel(aTolIter.Value(), aShapes, aShapes2);
+    findTargetShapes(aShapes, aTargetShapes);
+
+    const TDF_Label aLabel = aTargetTool->AddGeomTolerance();
+    XCAFDoc_GeomTolerance::Set(aLabel)->SetObject(aTolerance->GetObject());
+    copyName(aTolIter.Value(), aLabel);
+    if (!aTargetShapes.IsEmpty())
+    {
+      aTargetTool->SetGeomTolerance(aTargetShapes, aLabel);
+    }
+
+    TDF_LabelSequence aTolDatums;
+    XCAFDoc_DimTolTool::GetDatumOfTolerLabels(aTolIter.Value(), aTolDatums);
+    for (TDF_LabelSequence::Iterator aDatumIter(aTolDatums); aDatumIter.More(); aDatumIter.Next())
+    {
+      const TDF_Label* aTargetDatum = aDatumMap.Seek(aDatumIter.Value());
+      if (aTargetDatum != NULL)
+      {
+        aTargetTool->SetDatumToGeomTol(*aTargetDatum, aLabel);
+      }
+    }
+    aTransferred.Append(aLabel);
+  }
+
+  TDF_LabelSequence aDimensions;
+  aSourceTool->GetDimensionLabels(aDimensions);
+  for (TDF_LabelSequence::Iterator aDimIter(aDimensions); aDimIter.More(); aDimIter.Next())
+  {
+    Handle(XCAFDoc_Dimension) aDimension;
+    if (!aDimIter.Value().FindAttribute(XCAFDoc_Dimension::GetID(), aDimension))
+    {
+      continue;
+    }
+    TDF_LabelSequence aFirstShapes, aSecondShapes, aTargetFirst, aTargetSecond;
+    XCAFDoc_DimTolTool::GetRefShapeLabel(aDimIter.Value(), aFirstShapes, aSecondShapes);
+    findTargetShapes(aFirstShapes, aTargetFirst);
+    findTargetShapes(aSecondShapes, aTargetSecond);
+
+    const TDF_Label aLabel = aTargetTool->AddDimension();
+    XCAFDoc_Dimension::Set(aLabel)->SetObject(aDimension->GetObject());
+    copyName(aDimIter.Value(), aLabel);
+    if (!aTargetFirst.IsEmpty())
+    {
+      aTargetTool->SetDimension(aTargetFirst, aTargetSecond, aLabel);
+    }
+    aTransferred.Append(aLabel);
+  }
+
+  if (!aTransferred.IsEmpty())
+  {
+    OnPMITransferred(aTransferred);
+  }
+  return aTransferred.Length();
+}
+
+//=======================================================================
+// function : findTargetShape
+// purpose  :
+//=======================================================================
+TDF_Label DEJT_AsyncPMIReader::findTargetShape(const TDF_Label& theSource)
+{
+  if (!XCAFDoc_ShapeTool::IsSubShape(theSource))
+  {
+    return DEJT_Provider::MapShapeLabel(theSource, myDocument, myFirstTag);
+  }
+
+  // sub-shape labels are created by PMI translation, they are missing in the target document
+  const TDF_Label aTargetPart = findTargetShape(theSource.Father());
+  if (aTargetPart.IsNull())
+  {
+    return TDF_Label();
+  }
+  const TopoDS_Shape aSourceSubShape = XCAFDoc_ShapeTool::GetShape(theSource);
+  if (aSourceSubShape.IsNull())
+  {
+    return TDF_Label();
+  }
+  TopTools_IndexedMapOfShape aSourceMap, aTargetMap;
+  TopExp::MapShapes(XCAFDoc_ShapeTool::GetShape(theSource.Father()),
+                    aSourceSubShape.ShapeType(),
+                    aSourceMap);
+  TopExp::MapShapes(XCAFDoc_ShapeTool::GetShape(aTargetPart),
+                    aSourceSubShape.ShapeType(),
+                    aTargetMap);
+  // sub-shapes are created in the same order by both passes
+  const Standard_Integer anIndex = aSourceMap.FindIndex(aSourceSubShape);
+  if (anIndex < 1 || anIndex > aTargetMap.Extent())
+  {
+    return TDF_Label();
+  }
+
+  Handle(XCAFDoc_ShapeTool) aShapeTool = XCAFDoc_DocumentTool::ShapeTool(myDocument->Main());
+  const TopoDS_Shape&       aTargetSubShape = aTargetMap.FindKey(anIndex);
+  TDF_Label                 aTarget;
+  if (!aShapeTool->FindSubShape(aTargetPart, aTargetSubShape, aTarget))
+  {
+    aTarget = aShapeTool->AddSubShape(aTargetPart, aTargetSubShape);
+  }
+  return aTarget;
+}
+
+//=======================================================================
+// function : findTargetShapes
+// purpose  :
+//=======================================================================
+void DEJT_AsyncPMIReader::findTargetShapes(const TDF_LabelSequence& theSource,
+                                           TDF_LabelSequence&       theTarget)
+{
+  for (TDF_LabelSequence::Iterator aLabelIter(theSource); aLabelIter.More(); aLabelIter.Next())
+  {
+    const TDF_Label aTarget = findTargetShape(aLabelIter.Value());
+    if (!aTarget.IsNull())
+    {
+      theTarget.Append(aTarget);
+    }
+  }
+}
+
+//=======================================================================
+// function : Wait
+// purpose  :
+//=======================================================================
+Standard_Integer DEJT_AsyncPMIReader::Wait()
+{
+  if (myThread.joinable())
+  {
+    myThread.join();
+  }
+  return Apply();
+}
+
+//=======================================================================
+// function : Abort
+// purpose  :
+//=======================================================================
+void DEJT_AsyncPMIReader::Abort()
+{
+  myToAbort = true;
+  if (myThread.joinable())
+  {
+    myThread.join();
+  }
+  myPMIDoc.Nullify();
+  myIsDone = true;
+}
+
+//=======================================================================
+// function : OnPMITransferred
+// purpose  :
+//=======================================================================
+void DEJT_AsyncPMIReader::OnPMITransferred(const TDF_LabelSequence& theLabels)
+{
+  (void)theLabels;
+}
@@ -0,0 +1,114 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#ifndef _DEJT_AsyncPMIReader_HeaderFile
+#define _DEJT_AsyncPMIReader_HeaderFile
+
+#include <DEJT_ConfigurationNode.hxx>
+#include <TDF_Label.hxx>
+#include <TDF_LabelSequence.hxx>
+#include <TDocStd_Document.hxx>
+
+#include <atomic>
+#include <future>
+#include <thread>
+
+//! Reader of JT files translating PMI in the background.
+//! The document is filled with the product structure, geometry and metadata without PMI,
+//! so that the model can be displayed as soon as possible;
+//! the file is then read once more with PMI translation in the background thread.
+//!
+//! The background thread never modifies the target document:
+//! dimensions, geometric tolerances and datums are copied into XCAFDoc_DimTolTool
+//! of the target document by DEJT_AsyncPMIReader::Apply(), which should be called
+//! from the thread owning the document once the future returned by Future() is ready.
+//! Copied PMI labels are reported by DEJT_AsyncPMIReader::OnPMITransferred().
+//!
+//! Shape labels referenced by PMI are mapped to the labels created by the geometry pass
+//! with DEJT_Provider::MapShapeLabel(), using the first shape tag recorded before that pass,
+//! so that the target document may contain shapes read before; sub-shape labels are matched
+//! by the index of the sub-shape within its part. Saved views are not copied.
+class DEJT_AsyncPMIReader : public Standard_Transient
+{
+  DEFINE_STANDARD_RTTIEXT(DEJT_AsyncPMIReader, Standard_Transient)
+public:
+  //! Creates the reader.
+  //! @param[in] theNode reading parameters; the node is copied
+  Standard_EXPORT DEJT_AsyncPMIReader(const Handle(DEJT_ConfigurationNode)& theNode);
+
+  //! Aborts and waits for the background reading.
+  Standard_EXPORT virtual ~DEJT_AsyncPMIReader();
+
+  //! Reads the document without PMI and starts PMI translation in the background.
+  //! Does not start the background pass if PMI translation is disabled by the node.
+  //! @param[in] thePath path to the JT file
+  //! @param[in] theDocument document to fill
+  //! @param[in] theProgress progress indicator of the geometry pass
+  //! @return FALSE if the geometry pass has failed
+  Standard_EXPORT bool Perform(const TCollection_AsciiString&  thePath,
+                               const Handle(TDocStd_Document)& theDocument,
+                               const Message_ProgressRange&    theProgress = Message_ProgressRange());
+
+  //! Returns the future which becomes ready when the background pass is finished;
+  //! its value is TRUE if PMI has been read and can be applied to the document.
+  std::shared_future<bool> Future() const { return myFuture; }
+
+  //! Returns TRUE if the background pass is finished (or has not been started).
+  bool IsDone() const { return myIsDone; }
+
+  //! Copies PMI read by the background pass into the document.
+  //! Should be called from the thread owning the document; does nothing if PMI is not ready yet.
+  //! @return number of copied dimensions, tolerances and datums
+  Standard_EXPORT Standard_Integer Apply();
+
+  //! Waits for the background pass and applies the result.
+  Standard_EXPORT Standard_Integer Wait();
+
+  //! Stops the background pass; PMI is not applied.
+  Standard_EXPORT void Abort();
+
+protected:
+  //! Called by DEJT_AsyncPMIReader::Apply() after PMI has been copied.
+  //! @param[in] theLabels labels of dimensions, tolerances and datums within the target document
+  Standard_EXPORT virtual void OnPMITransferred(const TDF_LabelSequence& theLabels);
+
+private:
+  //! Reads the file with PMI into a new document; executed by the background thread.
+  void performBackground();
+
+  //! Returns the label of the target document corresponding to the shape label of the PMI document.
+  TDF_Label findTargetShape(const TDF_Label& theSource);
+
+  //! Returns the labels of the target document corresponding to the shape labels of the PMI document.
+  void findTargetShapes(const TDF_LabelSequence& theSource, TDF_LabelSequence& theTarget);
+
+private:
+  DEJT_AsyncPMIReader(const DEJT_AsyncPMIReader&);
+  DEJT_AsyncPMIReader& operator=(const DEJT_AsyncPMIReader&);
+
+private:
+  Handle(DEJT_ConfigurationNode) myNode;      //!< reading parameters
+  TCollection_AsciiString        myPath;      //!< path to the JT file
+  Handle(TDocStd_Document)       myDocument;  //!< target document
+  Handle(TDocStd_Document)       myPMIDoc;    //!< document read by the background pass
+  Standard_Integer               myFirstTag;  //!< first shape tag of the geometry pass
+  std::promise<bool>             myPromise;   //!< result of the background pass
+  std::shared_future<bool>       myFuture;    //!< future of myPromise
+  std::thread                    myThread;    //!< background thread
+  std::atomic<bool>              myToAbort;   //!< flag to stop background reading
+  std::atomic<bool>              myIsDone;    //!< flag indicating finished background reading
+};
+
+#endif // _DEJT_AsyncPMIReader_HeaderFile
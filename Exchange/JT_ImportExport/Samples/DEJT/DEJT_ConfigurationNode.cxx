@@ -18,6 +18,8 @@
 #include <DE_PluginHolder.hxx>
 #include <DEJT_Provider.hxx>
 #include <NCollection_Buffer.hxx>
+#include <NCollection_Vector.hxx>
+#include <TColStd_ListOfAsciiString.hxx>
 
 #include <TKDEJT.hxx>
 
@@ -86,12 +88,36 @@ bool DEJT_ConfigurationNode::Load(const Handle(DE_ConfigurationContext)& theReso
     theResource->BooleanVal("read.deduplicate.prims",
                             InternalParameters.ReadDeduplicatePrims,
                             aScope);
+  InternalParameters.ReadDeduplicateMeshes =
+    theResource->BooleanVal("read.deduplicate.meshes",
+                            InternalParameters.ReadDeduplicateMeshes,
+                            aScope);
   InternalParameters.ReadDeferMetadata =
     theResource->BooleanVal("read.defer.metadata", InternalParameters.ReadDeferMetadata, aScope);
-  InternalParameters.ReadCacheFileContent =
-    theResource->BooleanVal("read.cache.file.content",
-                            InternalParameters.ReadCacheFileContent,
+  InternalParameters.ReadLazyMetadata =
+    theResource->BooleanVal("read.lazy.metadata", InternalParameters.ReadLazyMetadata, aScope);
+  if (theResource->IsParamSet("read.cache.file.content", aScope))
+  {
+    // obsolete boolean parameter replaced by read.file.access.mode
+    InternalParameters.ReadFileAccessMode =
+      theResource->BooleanVal("read.cache.file.content", false, aScope)
+        ? ReadMode_FileAccess_Cache
+        : ReadMode_FileAccess_Stream;
+  }
+  InternalParameters.ReadFileAccessMode =
+    (ReadMode_FileAccess)theResource->IntegerVal("read.file.access.mode",
+                                                 InternalParameters.ReadFileAccessMode,
+                                                 aScope);
+  InternalParameters.ReadPrefetchPartitions =
+    theResource->BooleanVal("read.prefetch.partitions",
+                            InternalParameters.ReadPrefetchPartitions,
+                            aScope);
+  InternalParameters.ReadPrefetchInFlight =
+    theResource->IntegerVal("read.prefetch.in.flight",
+                            InternalParameters.ReadPrefetchInFlight,
                             aScope);
+  InternalParameters.ReadCacheDir =
+    theResource->StringVal("read.cache.dir", InternalParameters.ReadCacheDir, aScope);
   InternalParameters.ReadHiddenMetadata =
     theResource->BooleanVal("read.hidden.metadata", InternalParameters.ReadHiddenMetadata, aScope);
   InternalParameters.ReadSkipLateDataLoading =
@@ -106,6 +132,38 @@ bool DEJT_ConfigurationNode::Load(const Handle(DE_ConfigurationContext)& theReso
     theResource->BooleanVal("read.print.debug.info", InternalParameters.ReadPrintDebugInfo, aScope);
   InternalParameters.ReadFilterLayers =
     theResource->BooleanVal("read.filter.layers", InternalParameters.ReadFilterLayers, aScope);
+  TColStd_ListOfAsciiString aPatterns;
+  if (theResource->GetStringSeq("read.only.patterns", aPatterns, aScope))
+  {
+    InternalParameters.ReadOnlyPatterns = aPatterns;
+  }
+  TColStd_ListOfAsciiString aLayers;
+  if (theResource->GetStringSeq("read.only.layers", aLayers, aScope))
+  {
+    InternalParameters.ReadOnlyLayers = aLayers;
+  }
+  TColStd_ListOfAsciiString aBoxValues;
+  if (theResource->GetStringSeq("read.only.box", aBoxValues, aScope))
+  {
+    InternalParameters.ReadOnlyBox.SetVoid();
+    NCollection_Vector<Standard_Real> aCorners;
+    for (TColStd_ListOfAsciiString::Iterator anIter(aBoxValues); anIter.More(); anIter.Next())
+    {
+      if (anIter.Value().IsRealValue())
+      {
+        aCorners.Append(anIter.Value().RealValue());
+      }
+    }
+    if (aCorners.Length() == 6)
+    {
+      InternalParameters.ReadOnlyBox.Update(aCorners(0),
+                                            aCorners(1),
+                                            aCorners(2),
+                                            aCorners(3),
+                                            aCorners(4),
+                                            aCorners(5));
+    }
+  }
   InternalParameters.ReadWireframe =
     theResource->BooleanVal("read.wireframe", InternalParameters.ReadWireframe, aScope);
   InternalParameters.ReadXt = theResource->BooleanVal("read.xt", InternalParameters.ReadXt, aScope);
@@ -128,6 +186,20 @@ bool DEJT_ConfigurationNode::Load(const Handle(DE_ConfigurationContext)& theReso
     (JtData_LengthUnit)theResource->IntegerVal("write.jt.length.unit",
                                                InternalParameters.WriteJTLengthUnit,
                                                aScope);
+  TColStd_ListOfAsciiString aDeflections;
+  if (theResource->GetStringSeq("write.lod.deflections", aDeflections, aScope))
+  {
+    InternalParameters.WriteLodDeflections.Clear();
+    for (TColStd_ListOfAsciiString::Iterator anIter(aDeflections); anIter.More(); anIter.Next())
+    {
+      if (anIter.Value().IsRealValue() && anIter.Value().RealValue() > 0.0)
+      {
+        InternalParameters.WriteLodDeflections.Append(anIter.Value().RealValue());
+      }
+    }
+  }
+  InternalParameters.WriteParallel =
+    theResource->BooleanVal("write.parallel", InternalParameters.WriteParallel, aScope);
 
   return Standard_True;
 }
@@ -190,6 +262,14 @@ TCollection_AsciiString DEJT_ConfigurationNode::Save() const
     aScope + "read.deduplicate.prims :\t " + InternalParameters.ReadDeduplicatePrims + "\n";
   aResult += "!\n";
 
+  aResult += "!\n";
+  aResult += "!Set if bit-identical triangulations of different parts (e.g. fasteners)";
+  aResult += " should share a single Poly_Triangulation\n";
+  aResult += "!Default value: 0. Available values: 0, 1\n";
+  aResult +=
+    aScope + "read.deduplicate.meshes :\t " + InternalParameters.ReadDeduplicateMeshes + "\n";
+  aResult += "!\n";
+
   aResult += "!\n";
   aResult += "!Set if Metadata reading should be deferred\n";
   aResult += "!Default value: 0. Available values: 0, 1\n";
@@ -197,11 +277,42 @@ TCollection_AsciiString DEJT_ConfigurationNode::Save() const
   aResult += "!\n";
 
   aResult += "!\n";
-  aResult += "!Set if JtData_Model should cache file content in internal buffer";
-  aResult += " for later reusage (e.g. for loading LODs)\n";
+  aResult += "!Set if Metadata should be read on demand: the document is read without Metadata";
+  aResult += " and DEJT_MetadataStore attached to its root label materializes it for queried labels\n";
+  aResult += "!Default value: 0. Available values: 0, 1\n";
+  aResult += aScope + "read.lazy.metadata :\t " + InternalParameters.ReadLazyMetadata + "\n";
+  aResult += "!\n";
+
+  aResult += "!\n";
+  aResult += "!Defines how JtData_Model accesses the file content for later reusage";
+  aResult += " (e.g. for loading LODs)\n";
+  aResult += "!Default value: 0. Available values: 0(re-open the file for every late-loaded segment), ";
+  aResult += "1(cache the whole file content in internal buffer), ";
+  aResult += "2(map the file into memory and read segments directly from the mapping)\n";
+  aResult +=
+    aScope + "read.file.access.mode :\t " + InternalParameters.ReadFileAccessMode + "\n";
+  aResult += "!\n";
+
+  aResult += "!\n";
+  aResult += "!Set if the header, TOC and LSG segment of the partition files of a shattered assembly";
+  aResult += " should be read concurrently before reading the model\n";
   aResult += "!Default value: 0. Available values: 0, 1\n";
   aResult +=
-    aScope + "read.cache.file.content :\t " + InternalParameters.ReadCacheFileContent + "\n";
+    aScope + "read.prefetch.partitions :\t " + InternalParameters.ReadPrefetchPartitions + "\n";
+  aResult += "!\n";
+
+  aResult += "!\n";
+  aResult += "!Setting up the maximum number of partition files prefetched at the same time\n";
+  aResult += "!Default value: 0 (number of logical processors). Available values: <int>\n";
+  aResult +=
+    aScope + "read.prefetch.in.flight :\t " + InternalParameters.ReadPrefetchInFlight + "\n";
+  aResult += "!\n";
+
+  aResult += "!\n";
+  aResult += "!Setting up the directory of the cache of translated models;";
+  aResult += " unchanged files read with the same parameters are loaded from the cache\n";
+  aResult += "!Default value: empty. Available values: <path>\n";
+  aResult += aScope + "read.cache.dir :\t " + InternalParameters.ReadCacheDir + "\n";
   aResult += "!\n";
 
   aResult += "!\n";
@@ -241,6 +352,46 @@ TCollection_AsciiString DEJT_ConfigurationNode::Save() const
   aResult += aScope + "read.filter.layers :\t " + InternalParameters.ReadFilterLayers + "\n";
   aResult += "!\n";
 
+  aResult += "!\n";
+  aResult += "!Glob patterns ('*', '?') of names of the nodes to keep;";
+  aResult += " patterns containing '/' are matched against the full path of the node\n";
+  aResult += "!Default value: (empty). Available values: <pattern> [<pattern> ...]\n";
+  aResult += aScope + "read.only.patterns :\t";
+  for (TColStd_ListOfAsciiString::Iterator anIter(InternalParameters.ReadOnlyPatterns);
+       anIter.More();
+       anIter.Next())
+  {
+    aResult += TCollection_AsciiString(" ") + anIter.Value();
+  }
+  aResult += "\n";
+  aResult += "!\n";
+
+  aResult += "!\n";
+  aResult += "!Names of the layers to keep\n";
+  aResult += "!Default value: (empty). Available values: <name> [<name> ...]\n";
+  aResult += aScope + "read.only.layers :\t";
+  for (TColStd_ListOfAsciiString::Iterator anIter(InternalParameters.ReadOnlyLayers); anIter.More();
+       anIter.Next())
+  {
+    aResult += TCollection_AsciiString(" ") + anIter.Value();
+  }
+  aResult += "\n";
+  aResult += "!\n";
+
+  aResult += "!\n";
+  aResult += "!Box which should be intersected by the parts to keep\n";
+  aResult += "!Default value: (empty). Available values: <xmin> <ymin> <zmin> <xmax> <ymax> <zmax>\n";
+  aResult += aScope + "read.only.box :\t";
+  if (!InternalParameters.ReadOnlyBox.IsVoid())
+  {
+    Standard_Real aXmin, aYmin, aZmin, aXmax, aYmax, aZmax;
+    InternalParameters.ReadOnlyBox.Get(aXmin, aYmin, aZmin, aXmax, aYmax, aZmax);
+    aResult += TCollection_AsciiString(" ") + aXmin + " " + aYmin + " " + aZmin + " " + aXmax + " "
+               + aYmax + " " + aZmax;
+  }
+  aResult += "\n";
+  aResult += "!\n";
+
   aResult += "!\n";
   aResult += "!If true setting JtWirefram_BRepProvider\n";
   aResult += "!Default value: 0. Available values: 0, 1\n";
@@ -298,6 +449,25 @@ TCollection_AsciiString DEJT_ConfigurationNode::Save() const
   aResult += aScope + "write.jt.length.unit :\t " + InternalParameters.WriteJTLengthUnit + "\n";
   aResult += "!\n";
 
+  aResult += "!\n";
+  aResult += "!Deflections of the LODs to generate, from the finest to the coarsest;";
+  aResult += " the existing triangulation is written if no deflections are given\n";
+  aResult += "!Default value: (empty). Available values: <double> [<double> ...]\n";
+  aResult += aScope + "write.lod.deflections :\t";
+  for (TColStd_ListOfReal::Iterator anIter(InternalParameters.WriteLodDeflections); anIter.More();
+       anIter.Next())
+  {
+    aResult += TCollection_AsciiString(" ") + anIter.Value();
+  }
+  aResult += "\n";
+  aResult += "!\n";
+
+  aResult += "!\n";
+  aResult += "!Setting up parallel meshing of the LODs\n";
+  aResult += "!Default value: 0. Available values: 0, 1\n";
+  aResult += aScope + "write.parallel :\t " + InternalParameters.WriteParallel + "\n";
+  aResult += "!\n";
+
   aResult += "!*****************************************************************************\n";
   return aResult;
 }
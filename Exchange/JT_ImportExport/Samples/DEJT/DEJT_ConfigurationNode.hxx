@@ -15,9 +15,12 @@
 #ifndef _DEJT_ConfigurationNode_HeaderFile
 #define _DEJT_ConfigurationNode_HeaderFile
 
+#include <Bnd_Box.hxx>
 #include <DE_ConfigurationNode.hxx>
 #include <JTCAFControl_XcafToJT.hxx>
 #include <JtTools_IBRepProvider.hxx>
+#include <TColStd_ListOfAsciiString.hxx>
+#include <TColStd_ListOfReal.hxx>
 
 //! The purpose of this class is to configure the transfer process for JT format
 //! Stores the necessary settings for DEJT_Provider.
@@ -127,6 +130,13 @@ public:
     ReadMode_PrefGeomRepr_BRep
   };
 
+  enum ReadMode_FileAccess
+  {
+    ReadMode_FileAccess_Stream = 0, //!< re-open the file for every late-loaded segment
+    ReadMode_FileAccess_Cache,      //!< copy the whole file content into internal buffer
+    ReadMode_FileAccess_MemoryMap   //!< map the file into memory and read segments from mapping
+  };
+
   enum WriteMode_NameFormat
   {
     WriteMode_NameFormat_InstanceName = 0,
@@ -144,9 +154,15 @@ public:
       true; //<! Set if degenerate triangles should be skipped or not
     bool ReadDeduplicatePrims =
       true; //<! Set if translator should try generating single for JT primitives
+    bool ReadDeduplicateMeshes =
+      false; //<! Set if identical triangulations of different parts should be shared
     bool ReadDeferMetadata = false; //<! Set if Metadata reading should be deferred
-    bool ReadCacheFileContent =
-      false; //<! Set if JtData_Model should cache file content in internal buffer
+    bool ReadLazyMetadata  = false; //<! Set if Metadata should be read on demand by DEJT_MetadataStore
+    ReadMode_FileAccess ReadFileAccessMode =
+      ReadMode_FileAccess_Stream; //<! Defines how JtData_Model accesses the file content
+    bool ReadPrefetchPartitions = false; //<! Set if partition files of shattered assembly should be prefetched
+    int  ReadPrefetchInFlight = 0; //<! Number of partition files prefetched at the same time, 0 - number of cores
+    TCollection_AsciiString ReadCacheDir; //<! Directory of the cache of translated models, empty - no cache
     bool ReadHiddenMetadata = true; //<! Sets the flag controlling the loading of hidden Metadata
     bool ReadSkipLateDataLoading = false; //<! Sets flag to skip data loading
     bool ReadKeepLateData =
@@ -155,6 +171,9 @@ public:
       false; //<! Sets flag to load and activate only exactly specified triangulation LOD
     bool                  ReadPrintDebugInfo = false; //<! Sets flag to print debug information
     bool                  ReadFilterLayers   = false; //<! Sets whether to filter the layers
+    TColStd_ListOfAsciiString ReadOnlyPatterns; //<! Glob patterns of names or paths of nodes to keep, empty - keep all
+    TColStd_ListOfAsciiString ReadOnlyLayers;   //<! Names of layers to keep, empty - keep all
+    Bnd_Box ReadOnlyBox; //<! Box intersected by the parts to keep, void - keep all
     bool                  ReadWireframe      = false; //<! If true setting JtWirefram_BRepProvider
     bool                  ReadXt             = false; //<! Setting XSDRAWJT_XTBRepProvider
     ReadMode_PrefGeomRepr ReadPrefGeomRepr =
@@ -167,6 +186,8 @@ public:
       WriteMode_NameFormat_InstanceName; //<! Define the export name format for JT nodes
     JtData_LengthUnit WriteJTLengthUnit =
       JtData_LengthUnit_MM; //<! Setting up JT length unit using in Data Exchange
+    TColStd_ListOfReal WriteLodDeflections; //<! Deflections of generated LODs, empty - keep existing triangulation
+    bool WriteParallel = false; //<! Setup multithreaded meshing of LODs
   };
 
 public:
@@ -0,0 +1,302 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+#include <DEJT_IncrementalWriter.hxx>
+
+#include <JtData_Model.hxx>
+#include <Message.hxx>
+#include <OSD_Directory.hxx>
+#include <OSD_DirectoryIterator.hxx>
+#include <OSD_File.hxx>
+#include <OSD_FileIterator.hxx>
+#include <OSD_FileSystem.hxx>
+#include <OSD_Path.hxx>
+#include <OSD_Protection.hxx>
+#include <TCollection_ExtendedString.hxx>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+
+#ifdef _WIN32
+  #include <windows.h>
+#endif
+
+namespace
+{
+//! Returns the name of the file or directory with extension.
+static TCollection_AsciiString fileName(const OSD_Path& thePath)
+{
+  return thePath.Name() + thePath.Extension();
+}
+
+//! Removes the directory with its content.
+static void removeDirectory(const TCollection_AsciiString& theDir)
+{
+  for (OSD_FileIterator aFileIter(OSD_Path(theDir), "*"); aFileIter.More(); aFileIter.Next())
+  {
+    OSD_Path aPath;
+    aFileIter.Values().Path(aPath);
+    OSD_File(OSD_Path(theDir + fileName(aPath))).Remove();
+  }
+  for (OSD_DirectoryIterator aDirIter(OSD_Path(theDir), "*"); aDirIter.More(); aDirIter.Next())
+  {
+    OSD_Path aPath;
+    aDirIter.Values().Path(aPath);
+    const TCollection_AsciiString aName = fileName(aPath);
+    if (aName != "." && aName != "..")
+    {
+      removeDirectory(theDir + aName + "/");
+    }
+  }
+  OSD_Directory(OSD_Path(theDir)).Remove();
+}
+} // namespace
+
+//=======================================================================
+// function : IsSameContent
+// purpose  :
+//=======================================================================
+bool DEJT_IncrementalWriter::IsSameContent(const TCollection_AsciiString& thePath1,
+                                           const TCollection_AsciiString& thePath2)
+{
+  const Handle(OSD_FileSystem)& aFileSystem = OSD_FileSystem::DefaultFileSystem();
+  std::shared_ptr<std::istream> aStream1 =
+    aFileSystem->OpenIStream(thePath1, std::ios::in | std::ios::binary);
+  std::shared_ptr<std::istream> aStream2 =
+    aFileSystem->OpenIStream(thePath2, std::ios::in | std::ios::binary);
+  if (aStream1.get() == NULL || !aStream1->good() || aStream2.get() == NULL || !aStream2->good())
+  {
+    return false;
+  }
+
+  char aChunk1[65536];
+  char aChunk2[65536];
+  for (;;)
+  {
+    aStream1->read(aChunk1, sizeof(aChunk1));
+    aStream2->read(aChunk2, sizeof(aChunk2));
+    const std::streamsize aNbRead = aStream1->gcount();
+    if (aNbRead != aStream2->gcount() || aStream1->bad() || aStream2->bad()
+        || memcmp(aChunk1, aChunk2, (size_t)aNbRead) != 0)
+    {
+      return false;
+    }
+    if (aNbRead < (std::streamsize)sizeof(aChunk1))
+    {
+      // both files end here
+      return true;
+    }
+  }
+}
+
+//=======================================================================
+// function : ReplaceFile
+// purpose  :
+//=======================================================================
+bool DEJT_IncrementalWriter::ReplaceFile(const TCollection_AsciiString& theSource,
+                                         const TCollection_AsciiString& theTarget)
+{
+#ifdef _WIN32
+  const TCollection_ExtendedString aSourceW(theSource, Standard_True);
+  const TCollection_ExtendedString aTargetW(theTarget, Standard_True);
+  return ::MoveFileExW(aSourceW.ToWideString(),
+                       aTargetW.ToWideString(),
+                       MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)
+         != FALSE;
+#else
+  // rename() replaces the existing file atomically
+  return ::rename(theSource.ToCString(), theTarget.ToCString()) == 0;
+#endif
+}
+
+//=======================================================================
+// function : Perform
+// purpose  :
+//=======================================================================
+bool DEJT_IncrementalWriter::Perform(const Handle(JtNode_Partition)& theRoot,
+                                     const TCollection_AsciiString&  thePath,
+                                     const bool                      theIsShattered,
+                                     const Message_ProgressRange&    theProgress)
+{
+  myNbWritten = 0;
+  myNbSkipped = 0;
+  myNbRemoved = 0;
+
+  TCollection_AsciiString aFolder, aFileName;
+  OSD_Path::FolderAndFileFromPath(thePath, aFolder, aFileName);
+  const TCollection_AsciiString aStagingDir = aFolder + "." + aFileName + ".staging/";
+  if (OSD_Directory(OSD_Path(aStagingDir)).Exists())
+  {
+    // leftover of the interrupted call
+    removeDirectory(aStagingDir);
+  }
+  OSD_Directory aStaging(OSD_Path(aStagingDir));
+  aStaging.Build(OSD_Protection());
+  if (aStaging.Failed())
+  {
+    Message::SendFail() << "Error in the DEJT_IncrementalWriter: unable to create directory "
+                        << aStagingDir;
+    return false;
+  }
+
+  Handle(JtData_Model) aModel = new JtData_Model((aStagingDir + aFileName).ToCString());
+  if (!JtData_Model::Store(aModel, theRoot, theIsShattered, theProgress))
+  {
+    Message::SendFail() << "Error in the DEJT_IncrementalWriter: failed to write file " << thePath;
+    removeDirectory(aStagingDir);
+    return false;
+  }
+
+  NCollection_Map<TCollection_AsciiString> aFiles;
+  bool isDone = synchronize(aStagingDir, aFolder, TCollection_AsciiString(), aFiles);
+  removeDirectory(aStagingDir);
+  if (isDone)
+  {
+    // files of the previous call are deleted only when the new model is completely published
+    isDone = updateFileList(aFolder + "." + aFileName + ".files", aFolder, aFiles);
+  }
+  return isDone;
+}
+
+//=======================================================================
+// function : synchronize
+// purpose  :
+//=======================================================================
+bool DEJT_IncrementalWriter::synchronize(const TCollection_AsciiString&            theStagingDir,
+                                         const TCollection_AsciiString&            theTargetDir,
+                                         const TCollection_AsciiString&            theRelativeDir,
+                                         NCollection_Map<TCollection_AsciiString>& theFiles)
+{
+  bool isDone = true;
+  for (OSD_FileIterator aFileIter(OSD_Path(theStagingDir), "*"); aFileIter.More();
+       aFileIter.Next())
+  {
+    OSD_Path aPath;
+    aFileIter.Values().Path(aPath);
+    const TCollection_AsciiString aName = fileName(aPath);
+    const TCollection_AsciiString aSource = theStagingDir + aName;
+    const TCollection_AsciiString aTarget = theTargetDir + aName;
+    theFiles.Add(theRelativeDir + aName);
+
+    OSD_File aSourceFile(OSD_Path(aSource));
+    OSD_File aTargetFile(OSD_Path(aTarget));
+    if (aTargetFile.Exists() && aTargetFile.Size() == aSourceFile.Size()
+        && IsSameContent(aSource, aTarget))
+    {
+      ++myNbSkipped;
+      continue;
+    }
+
+    // readers never see a missing or partially written file
+    if (!ReplaceFile(aSource, aTarget))
+    {
+      Message::SendFail() << "Error in the DEJT_IncrementalWriter: unable to replace file "
+                          << aTarget;
+      isDone = false;
+      continue;
+    }
+    ++myNbWritten;
+  }
+
+  for (OSD_DirectoryIterator aDirIter(OSD_Path(theStagingDir), "*"); aDirIter.More();
+       aDirIter.Next())
+  {
+    OSD_Path aPath;
+    aDirIter.Values().Path(aPath);
+    const TCollection_AsciiString aName = fileName(aPath);
+    if (aName == "." || aName == "..")
+    {
+      continue;
+    }
+
+    OSD_Directory aTargetDir(OSD_Path(theTargetDir + aName + "/"));
+    if (!aTargetDir.Exists())
+    {
+      aTargetDir.Build(OSD_Protection());
+    }
+    isDone = synchronize(theStagingDir + aName + "/",
+                         theTargetDir + aName + "/",
+                         theRelativeDir + aName + "/",
+                         theFiles)
+             && isDone;
+  }
+  return isDone;
+}
+
+//=======================================================================
+// function : updateFileList
+// purpose  :
+//=======================================================================
+bool DEJT_IncrementalWriter::updateFileList(
+  const TCollection_AsciiString&                  theListPath,
+  const TCollection_AsciiString&                  theTargetDir,
+  const NCollection_Map<TCollection_AsciiString>& theFiles)
+{
+  const Handle(OSD_FileSystem)& aFileSystem = OSD_FileSystem::DefaultFileSystem();
+  {
+    std::shared_ptr<std::istream> aStream =
+      aFileSystem->OpenIStream(theListPath, std::ios::in | std::ios::binary);
+    if (aStream.get() != NULL)
+    {
+      std::string aLine;
+      while (std::getline(*aStream, aLine))
+      {
+        const TCollection_AsciiString aName(aLine.c_str());
+        if (aName.IsEmpty() || theFiles.Contains(aName))
+        {
+          continue;
+        }
+        OSD_File aFile(OSD_Path(theTargetDir + aName));
+        if (aFile.Exists())
+        {
+          aFile.Remove();
+          ++myNbRemoved;
+        }
+      }
+    }
+  }
+
+  const TCollection_AsciiString aTmpPath = theListPath + ".tmp";
+  {
+    std::shared_ptr<std::ostream> aStream =
+      aFileSystem->OpenOStream(aTmpPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (aStream.get() == NULL || !aStream->good())
+    {
+      Message::SendFail() << "Error in the DEJT_IncrementalWriter: unable to write file "
+                          << theListPath;
+      return false;
+    }
+    for (NCollection_Map<TCollection_AsciiString>::Iterator aFileIter(theFiles); aFileIter.More();
+         aFileIter.Next())
+    {
+      *aStream << aFileIter.Key() << "\n";
+    }
+    aStream->flush();
+    if (!aStream->good())
+    {
+      Message::SendFail() << "Error in the DEJT_IncrementalWriter: unable to write file "
+                          << theListPath;
+      return false;
+    }
+  }
+  if (!ReplaceFile(aTmpPath, theListPath))
+  {
+    Message::SendFail() << "Error in the DEJT_IncrementalWriter: unable to replace file "
+                        << theListPath;
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,104 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+#ifndef _DEJT_IncrementalWriter_HeaderFile
+#define _DEJT_IncrementalWriter_HeaderFile
+
+#include <JtNode_Partition.hxx>
+#include <Message_ProgressRange.hxx>
+#include <NCollection_Map.hxx>
+#include <TCollection_AsciiString.hxx>
+
+//! Tool writing the JT model incrementally.
+//! The model is stored into the staging directory next to the target file,
+//! then each produced file is compared with the file already existing at the target location;
+//! files with identical content are left untouched (keeping their modification time),
+//! so that publishing and synchronization tools process only the changed part files.
+//!
+//! The content is compared by size and then byte by byte, stopping at the first difference;
+//! changed files are replaced atomically by renaming the staged file over the existing one.
+//!
+//! The list of files produced by the call is stored next to the root file (".<name>.files"),
+//! so that files of the parts removed from the model are deleted by the next call;
+//! files unknown to the previous call are never deleted.
+//!
+//! To get identical files for unchanged parts, identifiers of JT entities
+//! should be regenerated from the start by Jt_GUID::Value(Standard_True)
+//! before building the model.
+class DEJT_IncrementalWriter
+{
+public:
+  //! Stores the model, replacing only changed files.
+  //! @param[in] theRoot root partition of the model
+  //! @param[in] thePath path to the root JT file
+  //! @param[in] theIsShattered flag to store parts into separate files
+  //! @param[in] theProgress progress indicator
+  //! @return FALSE if the model cannot be stored or the changed files cannot be replaced
+  Standard_EXPORT bool Perform(const Handle(JtNode_Partition)& theRoot,
+                               const TCollection_AsciiString&  thePath,
+                               const bool                      theIsShattered,
+                               const Message_ProgressRange& theProgress = Message_ProgressRange());
+
+  //! Returns the number of files written by the last call.
+  Standard_Integer NbWritten() const { return myNbWritten; }
+
+  //! Returns the number of unchanged files skipped by the last call.
+  Standard_Integer NbSkipped() const { return myNbSkipped; }
+
+  //! Returns the number of files of the previous call deleted by the last call.
+  Standard_Integer NbRemoved() const { return myNbRemoved; }
+
+  //! Compares the content of two files, stopping at the first difference.
+  //! @return TRUE if both files can be read and have the same content
+  Standard_EXPORT static bool IsSameContent(const TCollection_AsciiString& thePath1,
+                                            const TCollection_AsciiString& thePath2);
+
+  //! Renames the file, atomically replacing the existing target file.
+  //! @return FALSE if the file cannot be renamed
+  Standard_EXPORT static bool ReplaceFile(const TCollection_AsciiString& theSource,
+                                          const TCollection_AsciiString& theTarget);
+
+public:
+  //! Empty constructor.
+  DEJT_IncrementalWriter()
+      : myNbWritten(0),
+        myNbSkipped(0),
+        myNbRemoved(0)
+  {
+  }
+
+private:
+  //! Moves changed files from the staging directory into the target one, recursively.
+  //! @param[in] theStagingDir staging directory
+  //! @param[in] theTargetDir target directory
+  //! @param[in] theRelativeDir path of both directories relative to the root ones
+  //! @param[in,out] theFiles relative paths of the staged files
+  bool synchronize(const TCollection_AsciiString&            theStagingDir,
+                   const TCollection_AsciiString&            theTargetDir,
+                   const TCollection_AsciiString&            theRelativeDir,
+                   NCollection_Map<TCollection_AsciiString>& theFiles);
+
+  //! Deletes the files listed by the previous call and absent in the new list,
+  //! then stores the new list.
+  bool updateFileList(const TCollection_AsciiString&                  theListPath,
+                      const TCollection_AsciiString&                  theTargetDir,
+                      const NCollection_Map<TCollection_AsciiString>& theFiles);
+
+private:
+  Standard_Integer myNbWritten; //!< number of written files
+  Standard_Integer myNbSkipped; //!< number of skipped files
+  Standard_Integer myNbRemoved; //!< number of deleted files
+};
+
+#endif // _DEJT_IncrementalWriter_HeaderFile
@@ -0,0 +1,485 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+#include <DEJT_MappedFileSystem.hxx>
+
+#include <Message.hxx>
+#include <Standard.hxx>
+#include <Standard_ArrayStreamBuffer.hxx>
+#include <TCollection_ExtendedString.hxx>
+
+#include <string.h>
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+IMPLEMENT_STANDARD_RTTIEXT(DEJT_MappedFileSystem, OSD_FileSystem)
+
+namespace
+{
+//! Buffer pointing to the memory-mapped file; unmaps the file on destruction.
+class DEJT_MappedBuffer : public NCollection_Buffer
+{
+public:
+  DEJT_MappedBuffer(Standard_Byte* theData, const size_t theSize)
+      : NCollection_Buffer(Handle(NCollection_BaseAllocator)(), theSize, theData)
+  {
+  }
+
+  ~DEJT_MappedBuffer()
+  {
+#ifdef _WIN32
+    ::UnmapViewOfFile(ChangeData());
+#else
+    ::munmap(ChangeData(), Size());
+#endif
+  }
+};
+
+//! Stream buffer over the memory buffer, holding a reference to it.
+class DEJT_BufferStreamBuffer : public Standard_ArrayStreamBuffer
+{
+public:
+  DEJT_BufferStreamBuffer(const Handle(NCollection_Buffer)& theBuffer)
+      : Standard_ArrayStreamBuffer((const char*)theBuffer->Data(), theBuffer->Size()),
+        myBuffer(theBuffer)
+  {
+  }
+
+private:
+  Handle(NCollection_Buffer) myBuffer;
+};
+
+//! Input stream over the memory buffer, holding a reference to it.
+class DEJT_BufferIStream : public std::istream
+{
+public:
+  DEJT_BufferIStream(const Handle(NCollection_Buffer)& theBuffer)
+      : std::istream(NULL),
+        myStreamBuffer(theBuffer)
+  {
+    rdbuf(&myStreamBuffer);
+  }
+
+private:
+  DEJT_BufferStreamBuffer myStreamBuffer;
+};
+
+//! Replaces backslashes by slashes for comparison of paths.
+static TCollection_AsciiString normalizedPath(const TCollection_AsciiString& thePath)
+{
+  TCollection_AsciiString aPath = thePath;
+  aPath.ChangeAll('\\', '/');
+  return aPath;
+}
+
+//! Creates the global file system and registers it as the preferred protocol.
+static Handle(DEJT_MappedFileSystem) createGlobalFileSystem()
+{
+  Handle(DEJT_MappedFileSystem) aFileSystem = new DEJT_MappedFileSystem();
+  OSD_FileSystem::AddDefaultProtocol(aFileSystem, true);
+  return aFileSystem;
+}
+} // namespace
+
+//=======================================================================
+// function : GlobalFileSystem
+// purpose  :
+//=======================================================================
+const Handle(DEJT_MappedFileSystem)& DEJT_MappedFileSystem::GlobalFileSystem()
+{
+  static const Handle(DEJT_MappedFileSystem) THE_FILE_SYSTEM = createGlobalFileSystem();
+  return THE_FILE_SYSTEM;
+}
+
+//=======================================================================
+// function : FolderOf
+// purpose  :
+//=======================================================================
+TCollection_AsciiString DEJT_MappedFileSystem::FolderOf(const TCollection_AsciiString& thePath)
+{
+  const TCollection_AsciiString aPath = normalizedPath(thePath);
+  const int                     aSep  = aPath.SearchFromEnd("/");
+  return aSep > 0 ? aPath.SubString(1, aSep) : TCollection_AsciiString();
+}
+
+//=======================================================================
+// function : ReadStream
+// purpose  :
+//=======================================================================
+Handle(NCollection_Buffer) DEJT_MappedFileSystem::ReadStream(std::istream& theStream)
+{
+  // the data is read directly into the memory of the buffer;
+  // the common allocator is based on Standard::Allocate(), so that the block can be reallocated
+  size_t aCapacity = 1024 * 1024;
+  const std::streampos aStart = theStream.tellg();
+  if (aStart != std::streampos(-1) && theStream.seekg(0, std::ios::end))
+  {
+    // seekable stream, allocate the remaining size at once
+    const std::streampos anEnd = theStream.tellg();
+    theStream.seekg(aStart);
+    if (anEnd != std::streampos(-1) && anEnd > aStart)
+    {
+      // one extra byte detects the end of file without reallocation
+      aCapacity = (size_t)(anEnd - aStart) + 1;
+    }
+  }
+  else
+  {
+    // the size is unknown for pipes and decompressing streams
+    theStream.clear();
+  }
+
+  Standard_Byte* aData = (Standard_Byte*)Standard::Allocate(aCapacity);
+  size_t         aSize = 0;
+  while (aData != NULL && theStream.good())
+  {
+    if (aSize == aCapacity)
+    {
+      aCapacity *= 2;
+      aData = (Standard_Byte*)Standard::Reallocate(aData, aCapacity);
+      if (aData == NULL)
+      {
+        break;
+      }
+    }
+    theStream.read((char*)aData + aSize, (std::streamsize)(aCapacity - aSize));
+    aSize += (size_t)theStream.gcount();
+  }
+  if (aData == NULL || theStream.bad() || aSize == 0)
+  {
+    Standard::Free(aData);
+    return Handle(NCollection_Buffer)();
+  }
+  if (aSize < aCapacity)
+  {
+    aData = (Standard_Byte*)Standard::Reallocate(aData, aSize);
+  }
+  // the buffer takes the ownership of the block
+  return new NCollection_Buffer(NCollection_BaseAllocator::CommonBaseAllocator(), aSize, aData);
+}
+
+//=======================================================================
+// function : MapFile
+// purpose  :
+//=======================================================================
+Handle(NCollection_Buffer) DEJT_MappedFileSystem::MapFile(const TCollection_AsciiString& thePath)
+{
+#ifdef _WIN32
+  const TCollection_ExtendedString aPathW(thePath, Standard_True);
+  HANDLE aFile = ::CreateFileW(aPathW.ToWideString(),
+                               GENERIC_READ,
+                               FILE_SHARE_READ,
+                               NULL,
+                               OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL,
+                               NULL);
+  if (aFile == INVALID_HANDLE_VALUE)
+  {
+    return Handle(NCollection_Buffer)();
+  }
+  LARGE_INTEGER aFileSize;
+  if (!::GetFileSizeEx(aFile, &aFileSize) || aFileSize.QuadPart <= 0)
+  {
+    ::CloseHandle(aFile);
+    return Handle(NCollection_Buffer)();
+  }
+  HANDLE aMapping = ::CreateFileMappingW(aFile, NULL, PAGE_READONLY, 0, 0, NULL);
+  ::CloseHandle(aFile);
+  if (aMapping == NULL)
+  {
+    return Handle(NCollection_Buffer)();
+  }
+  // the view keeps the mapping object alive
+  void* aData = ::MapViewOfFile(aMapping, FILE_MAP_READ, 0, 0, 0);
+  ::CloseHandle(aMapping);
+  if (aData == NULL)
+  {
+    return Handle(NCollection_Buffer)();
+  }
+  return new DEJT_MappedBuffer((Standard_Byte*)aData, (size_t)aFileSize.QuadPart);
+#else
+  const int aFile = ::open(thePath.ToCString(), O_RDONLY);
+  if (aFile == -1)
+  {
+    return Handle(NCollection_Buffer)();
+  }
+  struct stat aStat;
+  if (::fstat(aFile, &aStat) != 0 || aStat.st_size <= 0)
+  {
+    ::close(aFile);
+    return Handle(NCollection_Buffer)();
+  }
+  // the mapping remains valid after closing the descriptor
+  void* aData = ::mmap(NULL, (size_t)aStat.st_size, PROT_READ, MAP_PRIVATE, aFile, 0);
+  ::close(aFile);
+  if (aData == MAP_FAILED)
+  {
+    return Handle(NCollection_Buffer)();
+  }
+  return new DEJT_MappedBuffer((Standard_Byte*)aData, (size_t)aStat.st_size);
+#endif
+}
+
+//=======================================================================
+// function : DEJT_MappedFileSystem
+// purpose  :
+//=======================================================================
+DEJT_MappedFileSystem::DEJT_MappedFileSystem()
+    : myNbSessions(0)
+{
+}
+
+//=======================================================================
+// function : BeginSession
+// purpose  :
+//=======================================================================
+void DEJT_MappedFileSystem::BeginSession(const TCollection_AsciiString& theFolder)
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  ++myNbSessions;
+  if (int* aCounter = myFolders.ChangeSeek(theFolder))
+  {
+    ++(*aCounter);
+  }
+  else
+  {
+    myFolders.Bind(theFolder, 1);
+  }
+}
+
+//=======================================================================
+// function : EndSession
+// purpose  :
+//=======================================================================
+void DEJT_MappedFileSystem::EndSession(const TCollection_AsciiString& theFolder)
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  int* aCounter = myFolders.ChangeSeek(theFolder);
+  if (aCounter == NULL)
+  {
+    return;
+  }
+  if (--(*aCounter) == 0)
+  {
+    myFolders.UnBind(theFolder);
+  }
+  if (--myNbSessions == 0)
+  {
+    // streams still opened by the caller keep their own references to the buffers
+    myFiles.Clear();
+  }
+}
+
+//=======================================================================
+// function : IsActive
+// purpose  :
+//=======================================================================
+bool DEJT_MappedFileSystem::IsActive() const
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  return myNbSessions > 0;
+}
+
+//=======================================================================
+// function : Find
+// purpose  :
+//=======================================================================
+Handle(NCollection_Buffer) DEJT_MappedFileSystem::Find(const TCollection_AsciiString& thePath)
+{
+  Handle(NCollection_Buffer) aBuffer;
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    if (myBound.Find(thePath, aBuffer) || myNbSessions == 0 || myFiles.Find(thePath, aBuffer))
+    {
+      return aBuffer;
+    }
+  }
+
+  // the file is mapped without holding the lock, so that different files are mapped concurrently
+  aBuffer = MapFile(thePath);
+  if (aBuffer.IsNull())
+  {
+    Message::SendTrace() << "DEJT_MappedFileSystem: unable to map file '" << thePath << "'";
+    return aBuffer;
+  }
+
+  std::lock_guard<std::mutex> aLock(myMutex);
+  Handle(NCollection_Buffer) aMapped;
+  if (myNbSessions == 0)
+  {
+    // the session has been closed meanwhile, the mapping is released together with the buffer
+    return aBuffer;
+  }
+  if (myFiles.Find(thePath, aMapped))
+  {
+    // the same file has been mapped by another thread
+    return aMapped;
+  }
+  myFiles.Bind(thePath, aBuffer);
+  return aBuffer;
+}
+
+//=======================================================================
+// function : Bind
+// purpose  :
+//=======================================================================
+bool DEJT_MappedFileSystem::Bind(const TCollection_AsciiString&    thePath,
+                                 const Handle(NCollection_Buffer)& theBuffer)
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  if (theBuffer.IsNull() || myBound.IsBound(thePath))
+  {
+    return false;
+  }
+  myBound.Bind(thePath, theBuffer);
+  return true;
+}
+
+//=======================================================================
+// function : Unbind
+// purpose  :
+//=======================================================================
+void DEJT_MappedFileSystem::Unbind(const TCollection_AsciiString& thePath)
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  myBound.UnBind(thePath);
+}
+
+//=======================================================================
+// function : IsSupportedPath
+// purpose  :
+//=======================================================================
+bool DEJT_MappedFileSystem::IsSupportedPath(const TCollection_AsciiString& theUrl) const
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  if (myBound.IsBound(theUrl))
+  {
+    return true;
+  }
+  if (myNbSessions == 0 || theUrl.Search("://") != -1)
+  {
+    return false;
+  }
+  // only files of the folders being read are mapped, other files are passed through
+  const TCollection_AsciiString aPath = normalizedPath(theUrl);
+  for (NCollection_DataMap<TCollection_AsciiString, int>::Iterator aFolderIter(myFolders);
+       aFolderIter.More();
+       aFolderIter.Next())
+  {
+    const TCollection_AsciiString& aFolder = aFolderIter.Key();
+    if (aFolder.IsEmpty() ? aPath.Search("/") == -1
+                          : (aPath.Length() > aFolder.Length()
+                             && strncmp(aPath.ToCString(), aFolder.ToCString(), aFolder.Length())
+                                  == 0))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//=======================================================================
+// function : IsOpenIStream
+// purpose  :
+//=======================================================================
+bool DEJT_MappedFileSystem::IsOpenIStream(const std::shared_ptr<std::istream>& theStream) const
+{
+  std::shared_ptr<DEJT_BufferIStream> aStream =
+    std::dynamic_pointer_cast<DEJT_BufferIStream>(theStream);
+  return aStream.get() != NULL && aStream->good();
+}
+
+//=======================================================================
+// function : IsOpenOStream
+// purpose  :
+//=======================================================================
+bool DEJT_MappedFileSystem::IsOpenOStream(const std::shared_ptr<std::ostream>& theStream) const
+{
+  (void)theStream;
+  return false;
+}
+
+//=======================================================================
+// function : OpenIStream
+// purpose  :
+//=======================================================================
+std::shared_ptr<std::istream> DEJT_MappedFileSystem::OpenIStream(
+  const TCollection_AsciiString&       theUrl,
+  const std::ios_base::openmode        theMode,
+  const int64_t                        theOffset,
+  const std::shared_ptr<std::istream>& theOldStream)
+{
+  (void)theOldStream;
+  if ((theMode & std::ios::out) != 0)
+  {
+    return std::shared_ptr<std::istream>();
+  }
+  const Handle(NCollection_Buffer) aBuffer = Find(theUrl);
+  if (aBuffer.IsNull() || theOffset < 0 || (uint64_t)theOffset > (uint64_t)aBuffer->Size())
+  {
+    return std::shared_ptr<std::istream>();
+  }
+  std::shared_ptr<DEJT_BufferIStream> aStream = std::make_shared<DEJT_BufferIStream>(aBuffer);
+  aStream->seekg((std::streamoff)theOffset, std::ios_base::beg);
+  return aStream;
+}
+
+//=======================================================================
+// function : OpenOStream
+// purpose  :
+//=======================================================================
+std::shared_ptr<std::ostream> DEJT_MappedFileSystem::OpenOStream(
+  const TCollection_AsciiString& theUrl,
+  const std::ios_base::openmode  theMode)
+{
+  (void)theUrl;
+  (void)theMode;
+  return std::shared_ptr<std::ostream>();
+}
+
+//=======================================================================
+// function : OpenStreamBuffer
+// purpose  :
+//=======================================================================
+std::shared_ptr<std::streambuf> DEJT_MappedFileSystem::OpenStreamBuffer(
+  const TCollection_AsciiString& theUrl,
+  const std::ios_base::openmode  theMode,
+  const int64_t                  theOffset,
+  int64_t*                       theOutBufSize)
+{
+  if ((theMode & std::ios::out) != 0)
+  {
+    return std::shared_ptr<std::streambuf>();
+  }
+  const Handle(NCollection_Buffer) aBuffer = Find(theUrl);
+  if (aBuffer.IsNull() || theOffset < 0 || (uint64_t)theOffset > (uint64_t)aBuffer->Size())
+  {
+    return std::shared_ptr<std::streambuf>();
+  }
+  std::shared_ptr<DEJT_BufferStreamBuffer> aStreamBuffer =
+    std::make_shared<DEJT_BufferStreamBuffer>(aBuffer);
+  aStreamBuffer->pubseekoff((std::streamoff)theOffset, std::ios_base::beg, std::ios_base::in);
+  if (theOutBufSize != NULL)
+  {
+    *theOutBufSize = (int64_t)aBuffer->Size() - theOffset;
+  }
+  return aStreamBuffer;
+}
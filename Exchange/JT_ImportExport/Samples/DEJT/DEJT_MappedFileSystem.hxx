@@ -0,0 +1,172 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+#ifndef _DEJT_MappedFileSystem_HeaderFile
+#define _DEJT_MappedFileSystem_HeaderFile
+
+#include <NCollection_Buffer.hxx>
+#include <NCollection_DataMap.hxx>
+#include <OSD_FileSystem.hxx>
+#include <TCollection_AsciiString.hxx>
+
+#include <mutex>
+
+//! File system serving read-only streams directly from memory-mapped files.
+//! Registered as preferred protocol of OSD_FileSystem::DefaultFileSystem(),
+//! so that JtData_Model opening the root file and late-loaded segments
+//! (with file content caching disabled) reads the compressed data straight
+//! from the mapping instead of re-opening the file or copying it into a buffer.
+//!
+//! The file system handles local paths only while a session is opened for their folder
+//! (see DEJT_MappedFileSystem::Sentry), so that files read by other threads or providers
+//! are passed to the next registered protocol. Files are mapped on first access
+//! and released when the last session is closed.
+//!
+//! In-memory content (e.g. JT data received from a database or network)
+//! can be bound to a virtual path with DEJT_MappedFileSystem::Bind(),
+//! so that it is read without writing a temporary file.
+//! Bound content is served regardless of the session until it is unbound.
+class DEJT_MappedFileSystem : public OSD_FileSystem
+{
+  DEFINE_STANDARD_RTTIEXT(DEJT_MappedFileSystem, OSD_FileSystem)
+public:
+  //! Auxiliary class opening the mapping session within the scope.
+  class Sentry
+  {
+  public:
+    //! Opens the session of the global file system for the folder of the file.
+    //! @param[in] thePath path to the root file; files of its folder are mapped
+    //! @param[in] theToActivate flag to open the session; does nothing if FALSE
+    Sentry(const TCollection_AsciiString& thePath, const bool theToActivate = true)
+    {
+      if (theToActivate)
+      {
+        myFolder     = DEJT_MappedFileSystem::FolderOf(thePath);
+        myFileSystem = DEJT_MappedFileSystem::GlobalFileSystem();
+        myFileSystem->BeginSession(myFolder);
+      }
+    }
+
+    //! Closes the session of the global file system.
+    ~Sentry()
+    {
+      if (!myFileSystem.IsNull())
+      {
+        myFileSystem->EndSession(myFolder);
+      }
+    }
+
+  private:
+    Sentry(const Sentry&);
+    Sentry& operator=(const Sentry&);
+
+  private:
+    Handle(DEJT_MappedFileSystem) myFileSystem;
+    TCollection_AsciiString       myFolder;
+  };
+
+public:
+  //! Returns the global instance registered within OSD_FileSystem::DefaultFileSystem().
+  Standard_EXPORT static const Handle(DEJT_MappedFileSystem)& GlobalFileSystem();
+
+  //! Returns the folder of the file with '/' separators and the trailing separator,
+  //! empty string for the file name without folder.
+  Standard_EXPORT static TCollection_AsciiString FolderOf(const TCollection_AsciiString& thePath);
+
+  //! Reads the whole stream into a new buffer without intermediate copies.
+  //! The buffer is allocated at once for seekable streams and grown geometrically otherwise.
+  //! @param[in] theStream stream to read from the current position
+  //! @return buffer with the stream content or NULL on failure
+  Standard_EXPORT static Handle(NCollection_Buffer) ReadStream(std::istream& theStream);
+
+  //! Maps the whole file into memory for reading.
+  //! @param[in] thePath path to the local file
+  //! @return buffer pointing to the mapped memory or NULL on failure;
+  //!         the mapping is released together with the buffer
+  Standard_EXPORT static Handle(NCollection_Buffer) MapFile(const TCollection_AsciiString& thePath);
+
+public:
+  //! Empty constructor.
+  Standard_EXPORT DEJT_MappedFileSystem();
+
+  //! Opens a new mapping session for the files of the folder and its sub-folders.
+  //! @param[in] theFolder folder returned by FolderOf()
+  Standard_EXPORT void BeginSession(const TCollection_AsciiString& theFolder);
+
+  //! Closes the session; releases all mapped files when the last session is closed.
+  //! @param[in] theFolder folder passed to BeginSession()
+  Standard_EXPORT void EndSession(const TCollection_AsciiString& theFolder);
+
+  //! Returns TRUE if at least one session is opened.
+  Standard_EXPORT bool IsActive() const;
+
+  //! Returns the mapped file content, mapping it if it has not been done before.
+  //! @param[in] thePath path to the local file
+  //! @return mapped file content or NULL if the file cannot be mapped
+  Standard_EXPORT Handle(NCollection_Buffer) Find(const TCollection_AsciiString& thePath);
+
+  //! Binds the memory content to the virtual path.
+  //! @param[in] thePath virtual path, should not match an existing file
+  //! @param[in] theBuffer content to be returned for the path
+  //! @return FALSE if the path is already bound
+  Standard_EXPORT bool Bind(const TCollection_AsciiString&    thePath,
+                            const Handle(NCollection_Buffer)& theBuffer);
+
+  //! Removes the binding of the virtual path.
+  //! Streams opened before keep their own references to the content.
+  Standard_EXPORT void Unbind(const TCollection_AsciiString& thePath);
+
+public:
+  //! Returns TRUE for bound paths and for local paths within folders of opened sessions.
+  Standard_EXPORT virtual bool IsSupportedPath(const TCollection_AsciiString& theUrl) const
+    Standard_OVERRIDE;
+
+  //! Returns TRUE if the stream has been opened by this file system and is valid.
+  Standard_EXPORT virtual bool IsOpenIStream(const std::shared_ptr<std::istream>& theStream) const
+    Standard_OVERRIDE;
+
+  //! Returns FALSE, writing is not supported.
+  Standard_EXPORT virtual bool IsOpenOStream(const std::shared_ptr<std::ostream>& theStream) const
+    Standard_OVERRIDE;
+
+  //! Opens the stream over the mapped file content.
+  //! The stream doesn't copy data; several streams share the same mapping.
+  Standard_EXPORT virtual std::shared_ptr<std::istream> OpenIStream(
+    const TCollection_AsciiString&       theUrl,
+    const std::ios_base::openmode        theMode,
+    const int64_t                        theOffset   = 0,
+    const std::shared_ptr<std::istream>& theOldStream = std::shared_ptr<std::istream>())
+    Standard_OVERRIDE;
+
+  //! Returns NULL, writing is not supported.
+  Standard_EXPORT virtual std::shared_ptr<std::ostream> OpenOStream(
+    const TCollection_AsciiString& theUrl,
+    const std::ios_base::openmode  theMode) Standard_OVERRIDE;
+
+  //! Opens the stream buffer over the mapped file content.
+  Standard_EXPORT virtual std::shared_ptr<std::streambuf> OpenStreamBuffer(
+    const TCollection_AsciiString& theUrl,
+    const std::ios_base::openmode  theMode,
+    const int64_t                  theOffset     = 0,
+    int64_t*                       theOutBufSize = NULL) Standard_OVERRIDE;
+
+private:
+  NCollection_DataMap<TCollection_AsciiString, Handle(NCollection_Buffer)> myFiles; //!< mapped files
+  NCollection_DataMap<TCollection_AsciiString, Handle(NCollection_Buffer)> myBound; //!< bound content
+  NCollection_DataMap<TCollection_AsciiString, int> myFolders; //!< session counters of folders
+  mutable std::mutex myMutex;      //!< mutex protecting the maps and the session counter
+  int                myNbSessions; //!< number of opened sessions
+};
+
+#endif // _DEJT_MappedFileSystem_HeaderFile
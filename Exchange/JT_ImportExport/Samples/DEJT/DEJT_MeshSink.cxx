@@ -0,0 +1,106 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+#include <DEJT_MeshSink.hxx>
+
+#include <RWMesh_FaceIterator.hxx>
+#include <TDataStd_Name.hxx>
+#include <XCAFPrs_DocumentExplorer.hxx>
+
+//=======================================================================
+// function : Perform
+// purpose  :
+//=======================================================================
+Standard_Integer DEJT_MeshSink::Perform(const Handle(TDocStd_Document)& theDocument,
+                                        const Standard_Integer          theLod)
+{
+  Standard_Integer aNbMeshes = 0;
+  Mesh             aMesh;
+  aMesh.Lod = theLod;
+  for (XCAFPrs_DocumentExplorer aDocExp(theDocument, XCAFPrs_DocumentExplorerFlags_OnlyLeafNodes);
+       aDocExp.More();
+       aDocExp.Next())
+  {
+    const XCAFPrs_DocumentNode& aDocNode = aDocExp.Current();
+    aMesh.NodePath  = aDocNode.Id;
+    aMesh.Transform = aDocNode.Location.Transformation();
+    aMesh.PartName.Clear();
+    Handle(TDataStd_Name) aName;
+    if (aDocNode.RefLabel.FindAttribute(TDataStd_Name::GetID(), aName))
+    {
+      aMesh.PartName = TCollection_AsciiString(aName->Get());
+    }
+
+    // faces of the part are grouped by style; nodes are kept in part coordinates
+    bool hasMesh = false;
+    for (RWMesh_FaceIterator aFaceIter(aDocNode.RefLabel, TopLoc_Location(), true, aDocNode.Style);
+         aFaceIter.More();
+         aFaceIter.Next())
+    {
+      if (aFaceIter.IsEmptyMesh())
+      {
+        continue;
+      }
+      if (hasMesh && !aFaceIter.FaceStyle().IsEqual(aMesh.Style))
+      {
+        AddMesh(aMesh);
+        ++aNbMeshes;
+        hasMesh = false;
+      }
+      if (!hasMesh)
+      {
+        aMesh.Style = aFaceIter.FaceStyle();
+        aMesh.Positions.clear();
+        aMesh.Normals.clear();
+        aMesh.Indices.clear();
+        hasMesh = true;
+      }
+
+      const Standard_Integer aFirstNode = (Standard_Integer)aMesh.Positions.size();
+      const bool hasNormals = aFaceIter.HasNormals() && aMesh.Normals.size() == aMesh.Positions.size();
+      if (!hasNormals)
+      {
+        aMesh.Normals.clear();
+      }
+      for (Standard_Integer aNodeIter = aFaceIter.NodeLower(); aNodeIter <= aFaceIter.NodeUpper();
+           ++aNodeIter)
+      {
+        const gp_Pnt aNode = aFaceIter.NodeTransformed(aNodeIter);
+        aMesh.Positions.push_back(
+          Graphic3d_Vec3((float)aNode.X(), (float)aNode.Y(), (float)aNode.Z()));
+        if (hasNormals)
+        {
+          const gp_Dir aNormal = aFaceIter.NormalTransformed(aNodeIter);
+          aMesh.Normals.push_back(
+            Graphic3d_Vec3((float)aNormal.X(), (float)aNormal.Y(), (float)aNormal.Z()));
+        }
+      }
+      for (Standard_Integer anElemIter = aFaceIter.ElemLower(); anElemIter <= aFaceIter.ElemUpper();
+           ++anElemIter)
+      {
+        const Poly_Triangle aTri = aFaceIter.TriangleOriented(anElemIter);
+        for (Standard_Integer aVertIter = 1; aVertIter <= 3; ++aVertIter)
+        {
+          aMesh.Indices.push_back(aFirstNode + aTri.Value(aVertIter) - aFaceIter.NodeLower());
+        }
+      }
+    }
+    if (hasMesh)
+    {
+      AddMesh(aMesh);
+      ++aNbMeshes;
+    }
+  }
+  return aNbMeshes;
+}
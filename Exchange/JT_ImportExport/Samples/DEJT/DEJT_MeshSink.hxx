@@ -0,0 +1,67 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+#ifndef _DEJT_MeshSink_HeaderFile
+#define _DEJT_MeshSink_HeaderFile
+
+#include <Graphic3d_Vec3.hxx>
+#include <TDocStd_Document.hxx>
+#include <XCAFPrs_Style.hxx>
+#include <gp_Trsf.hxx>
+
+#include <vector>
+
+//! Interface receiving JT meshes as flat arrays, without OCAF labels and TopoDS shapes,
+//! e.g. for passing the model to a renderer.
+//! Each call of DEJT_MeshSink::AddMesh() passes the triangles of one part instance
+//! sharing the same style; nodes are defined in the coordinate system of the part,
+//! so that instances of the same part can share GPU buffers.
+//!
+//! The sink is filled by DEJT_MeshSink::Perform() from an XDE document;
+//! DEJT_Provider::Read() reads the whole file into an intermediate mesh-only document first,
+//! as the JT library provides no access to decoded tri-strip sets outside of the XCAF reader.
+//! Meshes are not streamed from the decoder: the read takes longer than the read of the document
+//! (the document is explored afterwards) and the peak memory is the one of the complete document.
+class DEJT_MeshSink
+{
+public:
+  //! Mesh of the part instance with a single style.
+  struct Mesh
+  {
+    TCollection_AsciiString     NodePath;  //!< path of the instance within the assembly
+    TCollection_AsciiString     PartName;  //!< name of the part
+    gp_Trsf                     Transform; //!< placement of the part instance
+    Standard_Integer            Lod;       //!< triangulation LOD
+    XCAFPrs_Style               Style;     //!< color and material
+    std::vector<Graphic3d_Vec3> Positions; //!< node positions in part coordinates
+    std::vector<Graphic3d_Vec3> Normals;   //!< node normals, empty if not defined
+    std::vector<Standard_Integer> Indices; //!< 0-based node indices, 3 per triangle
+  };
+
+public:
+  //! Destructor.
+  virtual ~DEJT_MeshSink() {}
+
+  //! Receives the mesh; the data is valid only within the call.
+  virtual void AddMesh(const Mesh& theMesh) = 0;
+
+  //! Passes meshes of all leaf nodes of the document into the sink.
+  //! @param[in] theDocument document to explore
+  //! @param[in] theLod LOD index of the document triangulations
+  //! @return number of passed meshes
+  Standard_EXPORT Standard_Integer Perform(const Handle(TDocStd_Document)& theDocument,
+                                           const Standard_Integer          theLod = 0);
+};
+
+#endif // _DEJT_MeshSink_HeaderFile
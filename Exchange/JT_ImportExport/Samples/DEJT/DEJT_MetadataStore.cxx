@@ -0,0 +1,400 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+#include <DEJT_MetadataStore.hxx>
+
+#include <DEJT_MappedFileSystem.hxx>
+#include <DEJT_Provider.hxx>
+#include <Message.hxx>
+#include <Message_ProgressScope.hxx>
+#include <Standard_GUID.hxx>
+#include <TColStd_DataMapOfStringInteger.hxx>
+#include <TDataStd_DataMapOfStringReal.hxx>
+#include <TDataStd_DataMapOfStringString.hxx>
+#include <TDF_ChildIterator.hxx>
+#include <TDF_Tool.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+
+IMPLEMENT_STANDARD_RTTIEXT(DEJT_MetadataStore, TDF_Attribute)
+
+//=======================================================================
+// function : GetID
+// purpose  :
+//=======================================================================
+const Standard_GUID& DEJT_MetadataStore::GetID()
+{
+  static const Standard_GUID THE_ID("5b1e2c7a-3f4d-4e8b-9a61-0c2d7e9f4a13");
+  return THE_ID;
+}
+
+//=======================================================================
+// function : Set
+// purpose  :
+//=======================================================================
+Handle(DEJT_MetadataStore) DEJT_MetadataStore::Set(
+  const Handle(TDocStd_Document)&       theDocument,
+  const Handle(DEJT_ConfigurationNode)& theNode,
+  const TCollection_AsciiString&        thePath,
+  const Standard_Integer                theFirstShapeTag)
+{
+  const TDF_Label            aRoot = theDocument->GetData()->Root();
+  Handle(DEJT_MetadataStore) aStore;
+  if (!aRoot.FindAttribute(GetID(), aStore))
+  {
+    aStore = new DEJT_MetadataStore();
+    aRoot.AddAttribute(aStore);
+  }
+  // labels of the new read never overlap the labels of the sources registered before
+  Source aSource;
+  aSource.Node     = Handle(DEJT_ConfigurationNode)::DownCast(theNode->Copy());
+  aSource.Path     = thePath;
+  aSource.FirstTag = theFirstShapeTag;
+  aSource.IsLoaded = false;
+  aStore->mySources.Append(aSource);
+  return aStore;
+}
+
+//=======================================================================
+// function : Find
+// purpose  :
+//=======================================================================
+Handle(DEJT_MetadataStore) DEJT_MetadataStore::Find(const TDF_Label& theLabel)
+{
+  Handle(DEJT_MetadataStore) aStore;
+  if (!theLabel.IsNull())
+  {
+    theLabel.Root().FindAttribute(GetID(), aStore);
+  }
+  return aStore;
+}
+
+//=======================================================================
+// function : NamedData
+// purpose  :
+//=======================================================================
+Handle(TDataStd_NamedData) DEJT_MetadataStore::NamedData(const TDF_Label& theLabel)
+{
+  Handle(TDataStd_NamedData) aData;
+  if (theLabel.FindAttribute(TDataStd_NamedData::GetID(), aData))
+  {
+    return aData;
+  }
+  const Handle(DEJT_MetadataStore) aStore = Find(theLabel);
+  return !aStore.IsNull() ? aStore->Materialize(theLabel) : aData;
+}
+
+//=======================================================================
+// function : DEJT_MetadataStore
+// purpose  :
+//=======================================================================
+DEJT_MetadataStore::DEJT_MetadataStore() {}
+
+//=======================================================================
+// function : SetContent
+// purpose  :
+//=======================================================================
+void DEJT_MetadataStore::SetContent(const Handle(NCollection_Buffer)& theContent)
+{
+  if (!mySources.IsEmpty())
+  {
+    mySources.ChangeLast().Content = theContent;
+  }
+}
+
+//=======================================================================
+// function : IsLoaded
+// purpose  :
+//=======================================================================
+bool DEJT_MetadataStore::IsLoaded() const
+{
+  for (NCollection_Sequence<Source>::Iterator aSourceIter(mySources); aSourceIter.More();
+       aSourceIter.Next())
+  {
+    if (!aSourceIter.Value().IsLoaded)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//=======================================================================
+// function : Load
+// purpose  :
+//=======================================================================
+bool DEJT_MetadataStore::Load(const Message_ProgressRange& theProgress)
+{
+  if (mySources.IsEmpty())
+  {
+    return false;
+  }
+  Message_ProgressScope aPS(theProgress, "Reading metadata", mySources.Length());
+  bool                  isDone = true;
+  for (NCollection_Sequence<Source>::Iterator aSourceIter(mySources); aSourceIter.More();
+       aSourceIter.Next())
+  {
+    Message_ProgressRange aRange = aPS.Next();
+    if (aSourceIter.Value().IsLoaded)
+    {
+      continue;
+    }
+    // the file is not read again if it fails
+    aSourceIter.ChangeValue().IsLoaded = true;
+    isDone = load(aSourceIter.Value(), aRange) && isDone;
+  }
+  return isDone;
+}
+
+//=======================================================================
+// function : load
+// purpose  :
+//=======================================================================
+bool DEJT_MetadataStore::load(const Source& theSource, const Message_ProgressRange& theProgress)
+{
+  Handle(DEJT_ConfigurationNode) aNode =
+    Handle(DEJT_ConfigurationNode)::DownCast(theSource.Node->Copy());
+  aNode->InternalParameters.ReadLazyMetadata      = false;
+  aNode->InternalParameters.ReadTranslateMetadata = true;
+  aNode->InternalParameters.ReadDeferMetadata     = false;
+  aNode->InternalParameters.ReadTranslatePMI      = false;
+  aNode->InternalParameters.ReadKeepLateData      = false;
+  // only the scene graph and properties are needed, shape segments are not decoded
+  aNode->InternalParameters.ReadSkipLateDataLoading = true;
+  aNode->InternalParameters.ReadDeduplicateMeshes   = false;
+  aNode->InternalParameters.ReadPrefetchPartitions  = false;
+  // the cache would store a document without geometry under the key of this pass
+  aNode->InternalParameters.ReadCacheDir.Clear();
+
+  Handle(TDocStd_Document) aDoc      = new TDocStd_Document("BinXCAF");
+  Handle(DEJT_Provider)    aProvider = new DEJT_Provider(aNode);
+  const Handle(DEJT_MappedFileSystem)& aFileSystem = DEJT_MappedFileSystem::GlobalFileSystem();
+  const bool                           isBound =
+    !theSource.Content.IsNull() && aFileSystem->Bind(theSource.Path, theSource.Content);
+  const bool isDone = aProvider->Read(theSource.Path, aDoc, theProgress);
+  if (isBound)
+  {
+    aFileSystem->Unbind(theSource.Path);
+  }
+  if (!isDone)
+  {
+    Message::SendFail() << "Error in the DEJT_MetadataStore during reading the file "
+                        << theSource.Path << "\t: Error: metadata reading failed";
+    return false;
+  }
+
+  const Handle(TDocStd_Document) aTargetDoc = TDocStd_Document::Get(Label());
+  for (TDF_ChildIterator aLabelIter(XCAFDoc_DocumentTool::ShapesLabel(aDoc->Main()),
+                                    Standard_True);
+       aLabelIter.More();
+       aLabelIter.Next())
+  {
+    Handle(TDataStd_NamedData) aData;
+    if (!aLabelIter.Value().FindAttribute(TDataStd_NamedData::GetID(), aData))
+    {
+      continue;
+    }
+    // the target document may contain labels of other reads
+    const TDF_Label aTarget =
+      DEJT_Provider::MapShapeLabel(aLabelIter.Value(), aTargetDoc, theSource.FirstTag);
+    if (!aTarget.IsNull())
+    {
+      TCollection_AsciiString anEntry;
+      TDF_Tool::Entry(aTarget, anEntry);
+      append(anEntry, aData);
+    }
+  }
+  return true;
+}
+
+//=======================================================================
+// function : append
+// purpose  :
+//=======================================================================
+void DEJT_MetadataStore::append(const TCollection_AsciiString&    theEntry,
+                                const Handle(TDataStd_NamedData)& theData)
+{
+  Range aRange;
+  aRange.First = myValues.size();
+  if (theData->HasIntegers())
+  {
+    for (TColStd_DataMapOfStringInteger::Iterator anIter(theData->GetIntegersContainer());
+         anIter.More();
+         anIter.Next())
+    {
+      Value aValue;
+      aValue.Name    = myStrings.Add(anIter.Key());
+      aValue.Type    = ValueType_Integer;
+      aValue.Integer = anIter.Value();
+      myValues.push_back(aValue);
+    }
+  }
+  if (theData->HasReals())
+  {
+    for (TDataStd_DataMapOfStringReal::Iterator anIter(theData->GetRealsContainer()); anIter.More();
+         anIter.Next())
+    {
+      Value aValue;
+      aValue.Name = myStrings.Add(anIter.Key());
+      aValue.Type = ValueType_Real;
+      aValue.Real = anIter.Value();
+      myValues.push_back(aValue);
+    }
+  }
+  if (theData->HasStrings())
+  {
+    for (TDataStd_DataMapOfStringString::Iterator anIter(theData->GetStringsContainer());
+         anIter.More();
+         anIter.Next())
+    {
+      Value aValue;
+      aValue.Name   = myStrings.Add(anIter.Key());
+      aValue.Type   = ValueType_String;
+      aValue.String = myStrings.Add(anIter.Value());
+      myValues.push_back(aValue);
+    }
+  }
+  aRange.Count = myValues.size() - aRange.First;
+  if (aRange.Count != 0)
+  {
+    myLabels.Bind(theEntry, aRange);
+  }
+}
+
+//=======================================================================
+// function : HasMetadata
+// purpose  :
+//=======================================================================
+bool DEJT_MetadataStore::HasMetadata(const TDF_Label& theLabel)
+{
+  if (!Load())
+  {
+    return false;
+  }
+  TCollection_AsciiString anEntry;
+  TDF_Tool::Entry(theLabel, anEntry);
+  return myLabels.IsBound(anEntry);
+}
+
+//=======================================================================
+// function : Materialize
+// purpose  :
+//=======================================================================
+Handle(TDataStd_NamedData) DEJT_MetadataStore::Materialize(const TDF_Label& theLabel)
+{
+  Handle(TDataStd_NamedData) aData;
+  if (theLabel.FindAttribute(TDataStd_NamedData::GetID(), aData) || !Load())
+  {
+    return aData;
+  }
+
+  TCollection_AsciiString anEntry;
+  TDF_Tool::Entry(theLabel, anEntry);
+  const Range* aRange = myLabels.Seek(anEntry);
+  if (aRange == NULL)
+  {
+    return aData;
+  }
+
+  aData = TDataStd_NamedData::Set(theLabel);
+  for (size_t aValueIter = aRange->First; aValueIter < aRange->First + aRange->Count; ++aValueIter)
+  {
+    const Value&                      aValue = myValues[aValueIter];
+    const TCollection_ExtendedString& aName  = myStrings.FindKey(aValue.Name);
+    switch (aValue.Type)
+    {
+      case ValueType_Integer:
+        aData->SetInteger(aName, aValue.Integer);
+        break;
+      case ValueType_Real:
+        aData->SetReal(aName, aValue.Real);
+        break;
+      case ValueType_String:
+        aData->SetString(aName, myStrings.FindKey(aValue.String));
+        break;
+    }
+  }
+  return aData;
+}
+
+//=======================================================================
+// function : MaterializeAll
+// purpose  :
+//=======================================================================
+Standard_Integer DEJT_MetadataStore::MaterializeAll()
+{
+  if (!Load())
+  {
+    return 0;
+  }
+
+  Standard_Integer aNbMaterialized = 0;
+  for (NCollection_DataMap<TCollection_AsciiString, Range>::Iterator anIter(myLabels);
+       anIter.More();
+       anIter.Next())
+  {
+    TDF_Label aLabel;
+    TDF_Tool::Label(Label().Data(), anIter.Key(), aLabel, Standard_False);
+    if (!aLabel.IsNull() && !Materialize(aLabel).IsNull())
+    {
+      ++aNbMaterialized;
+    }
+  }
+  return aNbMaterialized;
+}
+
+//=======================================================================
+// function : ID
+// purpose  :
+//=======================================================================
+const Standard_GUID& DEJT_MetadataStore::ID() const
+{
+  return GetID();
+}
+
+//=======================================================================
+// function : Restore
+// purpose  :
+//=======================================================================
+void DEJT_MetadataStore::Restore(const Handle(TDF_Attribute)& theWith)
+{
+  Handle(DEJT_MetadataStore) aStore = Handle(DEJT_MetadataStore)::DownCast(theWith);
+  mySources = aStore->mySources;
+  myStrings = aStore->myStrings;
+  myValues  = aStore->myValues;
+  myLabels  = aStore->myLabels;
+}
+
+//=======================================================================
+// function : NewEmpty
+// purpose  :
+//=======================================================================
+Handle(TDF_Attribute) DEJT_MetadataStore::NewEmpty() const
+{
+  return new DEJT_MetadataStore();
+}
+
+//=======================================================================
+// function : Paste
+// purpose  :
+//=======================================================================
+void DEJT_MetadataStore::Paste(const Handle(TDF_Attribute)&       theInto,
+                               const Handle(TDF_RelocationTable)& theRT) const
+{
+  (void)theRT;
+  Handle(DEJT_MetadataStore) aStore = Handle(DEJT_MetadataStore)::DownCast(theInto);
+  aStore->mySources = mySources;
+  aStore->myStrings = myStrings;
+  aStore->myValues  = myValues;
+  aStore->myLabels  = myLabels;
+}
@@ -0,0 +1,183 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+#ifndef _DEJT_MetadataStore_HeaderFile
+#define _DEJT_MetadataStore_HeaderFile
+
+#include <DEJT_ConfigurationNode.hxx>
+#include <Message_ProgressRange.hxx>
+#include <NCollection_Buffer.hxx>
+#include <NCollection_DataMap.hxx>
+#include <NCollection_IndexedMap.hxx>
+#include <NCollection_Sequence.hxx>
+#include <TCollection_ExtendedString.hxx>
+#include <TDataStd_NamedData.hxx>
+#include <TDF_Attribute.hxx>
+#include <TDocStd_Document.hxx>
+
+#include <vector>
+
+//! Lazy store of JT metadata attached to the root label of the XDE document.
+//! The document is read without metadata translation (see read.lazy.metadata);
+//! metadata is read on the first request by a separate pass, which skips late-loaded segments
+//! and the model cache, and is kept in a compact form:
+//! property names and string values are shared between all nodes,
+//! so that a million nodes with similar property tables take little memory.
+//! TDataStd_NamedData attributes are materialized only for the queried labels.
+//!
+//! Labels of the separate pass are mapped to the labels created by the main read
+//! (see DEJT_Provider::MapShapeLabel()), as both passes produce the same shape structure.
+//! Every lazy read into the same document registers its file as a new source of the store,
+//! so that metadata of files read before is kept.
+//! Only scalar values (integers, reals and strings) are kept.
+//! The attribute is transient and is not stored within the document file.
+class DEJT_MetadataStore : public TDF_Attribute
+{
+  DEFINE_STANDARD_RTTIEXT(DEJT_MetadataStore, TDF_Attribute)
+public:
+  //! Returns the GUID of the attribute.
+  Standard_EXPORT static const Standard_GUID& GetID();
+
+  //! Attaches the store to the root label of the document, if it is not attached yet,
+  //! and registers the file as a new source of metadata.
+  //! @param[in] theDocument document read without metadata
+  //! @param[in] theNode reading parameters used to read the document; the node is copied
+  //! @param[in] thePath path to the JT file
+  //! @param[in] theFirstShapeTag value of DEJT_Provider::NextShapeTag() before reading the file
+  //! @return attached store
+  Standard_EXPORT static Handle(DEJT_MetadataStore) Set(
+    const Handle(TDocStd_Document)&       theDocument,
+    const Handle(DEJT_ConfigurationNode)& theNode,
+    const TCollection_AsciiString&        thePath,
+    const Standard_Integer                theFirstShapeTag = 1);
+
+  //! Returns the store attached to the document of the label or NULL.
+  Standard_EXPORT static Handle(DEJT_MetadataStore) Find(const TDF_Label& theLabel);
+
+  //! Returns metadata of the label, materializing TDataStd_NamedData attribute on first request.
+  //! Reads metadata of the whole file on the first call.
+  //! @param[in] theLabel label of the document
+  //! @return named data or NULL if the label has no metadata
+  Standard_EXPORT static Handle(TDataStd_NamedData) NamedData(const TDF_Label& theLabel);
+
+public:
+  //! Empty constructor.
+  Standard_EXPORT DEJT_MetadataStore();
+
+  //! Sets the file content of the last registered source for the documents read from memory;
+  //! the content is bound to the path while reading metadata.
+  Standard_EXPORT void SetContent(const Handle(NCollection_Buffer)& theContent);
+
+  //! Returns TRUE if metadata of all registered sources has been read.
+  Standard_EXPORT bool IsLoaded() const;
+
+  //! Returns the number of registered source files.
+  Standard_Integer NbSources() const { return mySources.Length(); }
+
+  //! Reads metadata of the whole files not read yet into the compact form.
+  //! @param[in] theProgress progress indicator
+  //! @return FALSE if the file cannot be read
+  Standard_EXPORT bool Load(const Message_ProgressRange& theProgress = Message_ProgressRange());
+
+  //! Returns TRUE if the label has metadata; reads metadata if needed.
+  Standard_EXPORT bool HasMetadata(const TDF_Label& theLabel);
+
+  //! Creates TDataStd_NamedData attribute with metadata of the label, if it does not exist yet.
+  //! @param[in] theLabel label of the document
+  //! @return named data or NULL if the label has no metadata
+  Standard_EXPORT Handle(TDataStd_NamedData) Materialize(const TDF_Label& theLabel);
+
+  //! Materializes metadata of all labels.
+  //! @return number of materialized attributes
+  Standard_EXPORT Standard_Integer MaterializeAll();
+
+  //! Returns the number of labels with metadata.
+  Standard_Integer NbLabels() const { return myLabels.Extent(); }
+
+  //! Returns the number of stored values.
+  Standard_Integer NbValues() const { return (Standard_Integer)myValues.size(); }
+
+  //! Returns the number of unique names and string values.
+  Standard_Integer NbStrings() const { return myStrings.Extent(); }
+
+public:
+  //! Returns the GUID of the attribute.
+  Standard_EXPORT virtual const Standard_GUID& ID() const Standard_OVERRIDE;
+
+  //! Restores the content from the backup.
+  Standard_EXPORT virtual void Restore(const Handle(TDF_Attribute)& theWith) Standard_OVERRIDE;
+
+  //! Creates an empty attribute.
+  Standard_EXPORT virtual Handle(TDF_Attribute) NewEmpty() const Standard_OVERRIDE;
+
+  //! Copies the content into another attribute.
+  Standard_EXPORT virtual void Paste(const Handle(TDF_Attribute)&       theInto,
+                                     const Handle(TDF_RelocationTable)& theRT) const
+    Standard_OVERRIDE;
+
+private:
+  //! Type of the stored value.
+  enum ValueType
+  {
+    ValueType_Integer,
+    ValueType_Real,
+    ValueType_String
+  };
+
+  //! Stored value of the property.
+  struct Value
+  {
+    Standard_Integer Name; //!< index of the property name in the string pool
+    ValueType        Type; //!< value type
+
+    union
+    {
+      Standard_Integer Integer; //!< integer value
+      Standard_Real    Real;    //!< real value
+      Standard_Integer String;  //!< index of the string value in the string pool
+    };
+  };
+
+  //! File read lazily into the document.
+  struct Source
+  {
+    Handle(DEJT_ConfigurationNode) Node;     //!< reading parameters
+    TCollection_AsciiString        Path;     //!< path to the JT file
+    Handle(NCollection_Buffer)     Content;  //!< file content read from memory
+    Standard_Integer               FirstTag; //!< first shape tag of the read
+    bool                           IsLoaded; //!< flag indicating read metadata
+  };
+
+  //! Range of values of the label.
+  struct Range
+  {
+    size_t First; //!< index of the first value
+    size_t Count; //!< number of values
+  };
+
+private:
+  //! Reads metadata of the source file.
+  bool load(const Source& theSource, const Message_ProgressRange& theProgress);
+
+  //! Appends values of the named data read by the metadata pass.
+  void append(const TCollection_AsciiString& theEntry, const Handle(TDataStd_NamedData)& theData);
+
+private:
+  NCollection_Sequence<Source>                       mySources; //!< files read into the document
+  NCollection_IndexedMap<TCollection_ExtendedString> myStrings; //!< pool of names and strings
+  std::vector<Value>                                 myValues;  //!< values of all labels
+  NCollection_DataMap<TCollection_AsciiString, Range> myLabels; //!< values of labels by entries
+};
+
+#endif // _DEJT_MetadataStore_HeaderFile
@@ -0,0 +1,405 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#include <DEJT_ModelCache.hxx>
+
+#include <BinDrivers_DocumentStorageDriver.hxx>
+#include <BinXCAFDrivers.hxx>
+#include <DEJT_IncrementalWriter.hxx>
+#include <DEJT_MappedFileSystem.hxx>
+#include <DEJT_PartitionPrefetcher.hxx>
+#include <Message.hxx>
+#include <NCollection_Map.hxx>
+#include <NCollection_Sequence.hxx>
+#include <OSD_Directory.hxx>
+#include <OSD_File.hxx>
+#include <OSD_FileSystem.hxx>
+#include <OSD_Path.hxx>
+#include <OSD_Process.hxx>
+#include <OSD_Protection.hxx>
+#include <OSD_Thread.hxx>
+#include <Standard_Failure.hxx>
+#include <TDocStd_Application.hxx>
+#include <TDocStd_XLinkTool.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+
+#include <stdio.h>
+
+#include <string>
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <sys/stat.h>
+#endif
+
+namespace
+{
+//! Returns the size and the modification time of the file;
+//! the time is in 100-nanosecond intervals on Windows and in nanoseconds elsewhere.
+static bool fileStamp(const TCollection_AsciiString& thePath, uint64_t& theSize, uint64_t& theTime)
+{
+#ifdef _WIN32
+  const TCollection_ExtendedString aPathW(thePath, Standard_True);
+  WIN32_FILE_ATTRIBUTE_DATA        anAttribs;
+  if (!::GetFileAttributesExW(aPathW.ToWideString(), GetFileExInfoStandard, &anAttribs)
+      || (anAttribs.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+  {
+    return false;
+  }
+  theSize = ((uint64_t)anAttribs.nFileSizeHigh << 32) | anAttribs.nFileSizeLow;
+  theTime = ((uint64_t)anAttribs.ftLastWriteTime.dwHighDateTime << 32)
+            | anAttribs.ftLastWriteTime.dwLowDateTime;
+  return true;
+#else
+  struct stat aStat;
+  if (::stat(thePath.ToCString(), &aStat) != 0 || !S_ISREG(aStat.st_mode))
+  {
+    return false;
+  }
+  theSize = (uint64_t)aStat.st_size;
+  #if defined(__APPLE__)
+  theTime = (uint64_t)aStat.st_mtimespec.tv_sec * 1000000000ULL
+            + (uint64_t)aStat.st_mtimespec.tv_nsec;
+  #else
+  theTime = (uint64_t)aStat.st_mtim.tv_sec * 1000000000ULL + (uint64_t)aStat.st_mtim.tv_nsec;
+  #endif
+  return true;
+#endif
+}
+
+//! Appends the string to 64-bit FNV-1a hash.
+static void hashString(const TCollection_AsciiString& theString, uint64_t& theHash)
+{
+  for (Standard_Integer anIter = 1; anIter <= theString.Length(); ++anIter)
+  {
+    theHash ^= (unsigned char)theString.Value(anIter);
+    theHash *= 1099511628211ULL;
+  }
+  // separator, so that concatenation of different strings gives different hashes
+  theHash ^= 0xFF;
+  theHash *= 1099511628211ULL;
+}
+
+//! Appends the size and the modification time of the file to the hash.
+static bool hashFileStamp(const TCollection_AsciiString& thePath, uint64_t& theHash)
+{
+  uint64_t aSize = 0, aTime = 0;
+  if (!fileStamp(thePath, aSize, aTime))
+  {
+    return false;
+  }
+  char aStamp[64];
+  Sprintf(aStamp, "%llu %llu", (unsigned long long)aSize, (unsigned long long)aTime);
+  hashString(aStamp, theHash);
+  return true;
+}
+
+//! Returns the name of the temporary file unique for the process and the thread.
+static TCollection_AsciiString temporaryPath(const TCollection_AsciiString& thePath)
+{
+  char aSuffix[64];
+  Sprintf(aSuffix,
+          ".%d.%llx.tmp",
+          OSD_Process().ProcessId(),
+          (unsigned long long)OSD_Thread::Current());
+  return thePath + aSuffix;
+}
+
+//! Creates the application handling BinXCAF format.
+static Handle(TDocStd_Application) newApplication()
+{
+  Handle(TDocStd_Application) anApp = new TDocStd_Application();
+  BinXCAFDrivers::DefineFormat(anApp);
+  return anApp;
+}
+} // namespace
+
+//=======================================================================
+// function : DEJT_ModelCache
+// purpose  :
+//=======================================================================
+DEJT_ModelCache::DEJT_ModelCache(const TCollection_AsciiString& theDir)
+    : myDir(theDir)
+{
+  if (!myDir.IsEmpty() && myDir.Value(myDir.Length()) != '/' && myDir.Value(myDir.Length()) != '\\')
+  {
+    myDir += "/";
+  }
+}
+
+//=======================================================================
+// function : fileKey
+// purpose  :
+//=======================================================================
+bool DEJT_ModelCache::fileKey(const TCollection_AsciiString&        thePath,
+                              const Handle(DEJT_ConfigurationNode)& theNode,
+                              uint64_t&                             theHash) const
+{
+  theHash = 14695981039346656037ULL;
+  hashString(thePath, theHash);
+  if (myDir.IsEmpty() || !hashFileStamp(thePath, theHash))
+  {
+    return false;
+  }
+  hashString(TCollection_AsciiString(theNode->GlobalParameters.LengthUnit), theHash);
+
+  // only parameters changing the translated document are hashed; parameters affecting
+  // the reading time and memory (parallel, file access, prefetch, late data) share the entry
+  static const char* THE_RESULT_PARAMS[] = {".read.lod.index",
+                                            ".read.skip.degenerate.triangles",
+                                            ".read.deduplicate.prims",
+                                            ".read.deduplicate.meshes",
+                                            ".read.defer.metadata",
+                                            ".read.lazy.metadata",
+                                            ".read.hidden.metadata",
+                                            ".read.skip.late.data.loading",
+                                            ".read.load.strictly",
+                                            ".read.dump.brep.provider",
+                                            ".read.filter.layers",
+                                            ".read.only.patterns",
+                                            ".read.only.layers",
+                                            ".read.only.box",
+                                            ".read.wireframe",
+                                            ".read.xt",
+                                            ".read.pref.geom.repr",
+                                            ".read.translate.metadata",
+                                            ".read.translate.pmi"};
+  const TCollection_AsciiString aResource = theNode->Save();
+  for (Standard_Integer aLineIter = 1;; ++aLineIter)
+  {
+    const TCollection_AsciiString aLine = aResource.Token("\n", aLineIter);
+    if (aLine.IsEmpty())
+    {
+      break;
+    }
+    if (aLine.Value(1) == '!')
+    {
+      continue;
+    }
+    const TCollection_AsciiString aKey = aLine.Token(" :\t", 1);
+    for (size_t aParamIter = 0;
+         aParamIter < sizeof(THE_RESULT_PARAMS) / sizeof(THE_RESULT_PARAMS[0]);
+         ++aParamIter)
+    {
+      if (aKey.EndsWith(THE_RESULT_PARAMS[aParamIter]))
+      {
+        hashString(aLine, theHash);
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+//=======================================================================
+// function : dependencyListPath
+// purpose  :
+//=======================================================================
+TCollection_AsciiString DEJT_ModelCache::dependencyListPath(const uint64_t theFileKey) const
+{
+  char aName[32];
+  Sprintf(aName, "%016llx.dep", (unsigned long long)theFileKey);
+  return myDir + aName;
+}
+
+//=======================================================================
+// function : EntryPath
+// purpose  :
+//=======================================================================
+TCollection_AsciiString DEJT_ModelCache::EntryPath(
+  const TCollection_AsciiString&        thePath,
+  const Handle(DEJT_ConfigurationNode)& theNode) const
+{
+  uint64_t aHash = 0;
+  if (!fileKey(thePath, theNode, aHash))
+  {
+    return TCollection_AsciiString();
+  }
+
+  // without the list of partitions the key cannot match any entry written by Store()
+  std::shared_ptr<std::istream> aStream =
+    OSD_FileSystem::DefaultFileSystem()->OpenIStream(dependencyListPath(aHash),
+                                                     std::ios::in | std::ios::binary);
+  if (aStream.get() == NULL)
+  {
+    hashString("?", aHash);
+  }
+  else
+  {
+    std::string aLine;
+    while (std::getline(*aStream, aLine))
+    {
+      const TCollection_AsciiString aPartPath(aLine.c_str());
+      hashString(aPartPath, aHash);
+      if (!hashFileStamp(aPartPath, aHash))
+      {
+        hashString("?", aHash);
+      }
+    }
+  }
+
+  char aName[32];
+  Sprintf(aName, "%016llx.xbf", (unsigned long long)aHash);
+  return myDir + aName;
+}
+
+//=======================================================================
+// function : Load
+// purpose  :
+//=======================================================================
+bool DEJT_ModelCache::Load(const TCollection_AsciiString&  theEntry,
+                           const Handle(TDocStd_Document)& theDocument,
+                           const Message_ProgressRange&    theProgress) const
+{
+  if (theEntry.IsEmpty() || !OSD_File(OSD_Path(theEntry)).Exists())
+  {
+    return false;
+  }
+
+  Handle(TDocStd_Application) anApp = newApplication();
+  Handle(TDocStd_Document)    aCachedDoc;
+  {
+    // the entry is parsed directly from the mapped pages
+    DEJT_MappedFileSystem::Sentry aMappingSentry(theEntry);
+    if (anApp->Open(TCollection_ExtendedString(theEntry, Standard_True), aCachedDoc, theProgress)
+          != PCDM_RS_OK
+        || aCachedDoc.IsNull())
+    {
+      Message::SendWarning() << "Warning in the DEJT_ModelCache: unable to read cache entry "
+                             << theEntry;
+      return false;
+    }
+  }
+
+  bool isDone = true;
+  try
+  {
+    TDocStd_XLinkTool aCopyTool;
+    aCopyTool.Copy(theDocument->Main(), aCachedDoc->Main());
+    Standard_Real aLengthUnit = 1.0;
+    if (XCAFDoc_DocumentTool::GetLengthUnit(aCachedDoc, aLengthUnit))
+    {
+      XCAFDoc_DocumentTool::SetLengthUnit(theDocument, aLengthUnit);
+    }
+  }
+  catch (const Standard_Failure& theFailure)
+  {
+    Message::SendWarning() << "Warning in the DEJT_ModelCache: unable to copy cache entry "
+                           << theEntry << "\t: " << theFailure.GetMessageString();
+    isDone = false;
+  }
+  anApp->Close(aCachedDoc);
+  return isDone;
+}
+
+//=======================================================================
+// function : Store
+// purpose  :
+//=======================================================================
+bool DEJT_ModelCache::Store(const TCollection_AsciiString&        thePath,
+                            const Handle(DEJT_ConfigurationNode)& theNode,
+                            const Handle(TDocStd_Document)&       theDocument,
+                            const Message_ProgressRange&          theProgress) const
+{
+  uint64_t aFileKey = 0;
+  if (!theDocument->IsOpened() || !fileKey(thePath, theNode, aFileKey))
+  {
+    return false;
+  }
+
+  OSD_Directory aDir(OSD_Path(myDir));
+  if (!aDir.Exists())
+  {
+    aDir.Build(OSD_Protection());
+    if (aDir.Failed())
+    {
+      Message::SendWarning() << "Warning in the DEJT_ModelCache: unable to create directory "
+                             << myDir;
+      return false;
+    }
+  }
+
+  // partitions referenced directly or indirectly by the root file
+  NCollection_Sequence<TCollection_AsciiString> aParts;
+  NCollection_Map<TCollection_AsciiString>      aVisited;
+  aVisited.Add(thePath);
+  DEJT_PartitionPrefetcher::CollectReferences(thePath, aParts);
+  for (Standard_Integer aPartIter = 1; aPartIter <= aParts.Length();)
+  {
+    if (!aVisited.Add(aParts.Value(aPartIter)))
+    {
+      aParts.Remove(aPartIter);
+      continue;
+    }
+    DEJT_PartitionPrefetcher::CollectReferences(aParts.Value(aPartIter++), aParts);
+  }
+
+  const TCollection_AsciiString aListPath    = dependencyListPath(aFileKey);
+  const TCollection_AsciiString aTmpListPath = temporaryPath(aListPath);
+  {
+    std::shared_ptr<std::ostream> aStream = OSD_FileSystem::DefaultFileSystem()->OpenOStream(
+      aTmpListPath,
+      std::ios::out | std::ios::binary | std::ios::trunc);
+    if (aStream.get() == NULL || !aStream->good())
+    {
+      Message::SendWarning() << "Warning in the DEJT_ModelCache: unable to write file "
+                             << aListPath;
+      return false;
+    }
+    for (NCollection_Sequence<TCollection_AsciiString>::Iterator aPartIter(aParts);
+         aPartIter.More();
+         aPartIter.Next())
+    {
+      *aStream << aPartIter.Value() << "\n";
+    }
+    aStream->flush();
+  }
+  if (!DEJT_IncrementalWriter::ReplaceFile(aTmpListPath, aListPath))
+  {
+    OSD_File(OSD_Path(aTmpListPath)).Remove();
+    Message::SendWarning() << "Warning in the DEJT_ModelCache: unable to write file "
+                           << aListPath;
+    return false;
+  }
+  const TCollection_AsciiString anEntry = EntryPath(thePath, theNode);
+
+  Handle(TDocStd_Application)              anApp = newApplication();
+  Handle(BinDrivers_DocumentStorageDriver) aDriver =
+    Handle(BinDrivers_DocumentStorageDriver)::DownCast(anApp->WriterFromFormat("BinXCAF"));
+  if (aDriver.IsNull())
+  {
+    return false;
+  }
+  // mesh-only parts keep nothing but triangulations
+  aDriver->SetWithTriangles(anApp->MessageDriver(), Standard_True);
+
+  // concurrent writers of the same entry use different temporary files
+  const TCollection_AsciiString aTmpEntry = temporaryPath(anEntry);
+  aDriver->Write(theDocument, TCollection_ExtendedString(aTmpEntry, Standard_True), theProgress);
+  OSD_File aTmpFile(OSD_Path(aTmpEntry));
+  if (aDriver->GetStoreStatus() != PCDM_SS_OK
+      || !DEJT_IncrementalWriter::ReplaceFile(aTmpEntry, anEntry))
+  {
+    Message::SendWarning() << "Warning in the DEJT_ModelCache: unable to write cache entry "
+                           << anEntry;
+    if (aTmpFile.Exists())
+    {
+      aTmpFile.Remove();
+    }
+    return false;
+  }
+  return true;
+}
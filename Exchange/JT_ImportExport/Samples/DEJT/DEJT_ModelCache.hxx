@@ -0,0 +1,103 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#ifndef _DEJT_ModelCache_HeaderFile
+#define _DEJT_ModelCache_HeaderFile
+
+#include <DEJT_ConfigurationNode.hxx>
+#include <Message_ProgressRange.hxx>
+#include <TCollection_AsciiString.hxx>
+#include <TDocStd_Document.hxx>
+
+//! On-disk cache of translated JT models.
+//! The XDE document produced from the JT file is stored in the cache directory
+//! in BinXCAF format together with triangulations,
+//! so that re-opening the unchanged file skips LSG traversal, segment decoding and transfer.
+//! The entry is a regular BinXCAF file rather than a compressed or memory-mapped flat layout:
+//! loading opens the entry as a document and deep-copies it into the target one
+//! by TDocStd_XLinkTool::Copy().
+//!
+//! The cache entry is keyed by 64-bit FNV-1a hash of the file path, its size,
+//! its modification time (with nanoseconds), the system length unit and the read.* parameters
+//! of the node changing the translated document, so that modifying the file or changing
+//! the result options produces a new entry; parameters affecting only the reading time
+//! and memory (read.parallel, read.file.access.mode, read.prefetch.*, read.keep.late.data,
+//! read.print.debug.info, read.check.brep.types) share the entry.
+//! Partition files of a shattered assembly are part of the key as well:
+//! the list of partitions referenced by the root file is stored next to the entries
+//! by Store(), and the sizes and modification times of the listed files are hashed into the key.
+//! Files which cannot be stat'ed (e.g. streams bound in DEJT_MappedFileSystem) are not cached.
+//! Stale entries are never removed automatically.
+class DEJT_ModelCache
+{
+public:
+  //! Constructor.
+  //! @param[in] theDir cache directory; created on first store if it does not exist
+  Standard_EXPORT DEJT_ModelCache(const TCollection_AsciiString& theDir);
+
+  //! Returns the path to the cache entry of the JT file read with the given parameters.
+  //! The entry does not exist until the file is stored by Store() with the same parameters.
+  //! @param[in] thePath path to the JT file
+  //! @param[in] theNode reading parameters
+  //! @return empty string if the file cannot be stat'ed
+  Standard_EXPORT TCollection_AsciiString
+    EntryPath(const TCollection_AsciiString&        thePath,
+              const Handle(DEJT_ConfigurationNode)& theNode) const;
+
+  //! Loads the cache entry into the document.
+  //! The entry is read through the memory mapping of DEJT_MappedFileSystem into a temporary
+  //! document, which is then deep-copied into the target one by TDocStd_XLinkTool::Copy().
+  //! @param[in] theEntry path returned by EntryPath()
+  //! @param[in] theDocument empty XDE document to fill
+  //! @param[in] theProgress progress indicator
+  //! @return FALSE if the entry does not exist or cannot be read
+  Standard_EXPORT bool Load(
+    const TCollection_AsciiString&  theEntry,
+    const Handle(TDocStd_Document)& theDocument,
+    const Message_ProgressRange&    theProgress = Message_ProgressRange()) const;
+
+  //! Stores the document read from the JT file into the cache entry.
+  //! The partition files referenced by the file are collected and listed for EntryPath().
+  //! The list and the entry are written into uniquely named temporary files first
+  //! and renamed, so that concurrent readers and writers never see incomplete files.
+  //! @param[in] thePath path to the JT file
+  //! @param[in] theNode reading parameters
+  //! @param[in] theDocument document to store; should be opened by an application
+  //! @param[in] theProgress progress indicator
+  //! @return FALSE if the entry cannot be written
+  Standard_EXPORT bool Store(
+    const TCollection_AsciiString&        thePath,
+    const Handle(DEJT_ConfigurationNode)& theNode,
+    const Handle(TDocStd_Document)&       theDocument,
+    const Message_ProgressRange&          theProgress = Message_ProgressRange()) const;
+
+  //! Returns the cache directory ending with the separator.
+  const TCollection_AsciiString& Directory() const { return myDir; }
+
+private:
+  //! Computes the hash of the JT file stamp and reading parameters, without partitions.
+  //! @return FALSE if the file cannot be stat'ed
+  bool fileKey(const TCollection_AsciiString&        thePath,
+               const Handle(DEJT_ConfigurationNode)& theNode,
+               uint64_t&                             theHash) const;
+
+  //! Returns the path to the list of partition files for the file key.
+  TCollection_AsciiString dependencyListPath(const uint64_t theFileKey) const;
+
+private:
+  TCollection_AsciiString myDir; //!< cache directory ending with the separator
+};
+
+#endif // _DEJT_ModelCache_HeaderFile
@@ -0,0 +1,297 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#include <DEJT_PartFilter.hxx>
+
+#include <BRepBndLib.hxx>
+#include <NCollection_Map.hxx>
+#include <TColStd_HSequenceOfExtendedString.hxx>
+#include <TDataStd_Name.hxx>
+#include <TopoDS_Shape.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_LayerTool.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+
+namespace
+{
+//! Returns the name of the label or an empty string.
+static TCollection_AsciiString labelName(const TDF_Label& theLabel)
+{
+  Handle(TDataStd_Name) aNameAttr;
+  if (!theLabel.FindAttribute(TDataStd_Name::GetID(), aNameAttr))
+  {
+    return TCollection_AsciiString();
+  }
+  return TCollection_AsciiString(aNameAttr->Get(), '?');
+}
+} // namespace
+
+//=======================================================================
+// function : DEJT_PartFilter
+// purpose  :
+//=======================================================================
+DEJT_PartFilter::DEJT_PartFilter()
+    : myFirstTag(1),
+      myNbParts(0),
+      myNbKept(0)
+{
+}
+
+//=======================================================================
+// function : MatchGlob
+// purpose  :
+//=======================================================================
+bool DEJT_PartFilter::MatchGlob(const TCollection_AsciiString& thePattern,
+                                const TCollection_AsciiString& theString)
+{
+  const char* aPat     = thePattern.ToCString();
+  const char* aStr     = theString.ToCString();
+  const char* aStarPat = NULL;
+  const char* aStarStr = NULL;
+  while (*aStr != '\0')
+  {
+    if (*aPat == '*')
+    {
+      aStarPat = ++aPat;
+      aStarStr = aStr;
+    }
+    else if (*aPat == '?' || *aPat == *aStr)
+    {
+      ++aPat;
+      ++aStr;
+    }
+    else if (aStarPat != NULL)
+    {
+      // let the last '*' consume one more character
+      aPat = aStarPat;
+      aStr = ++aStarStr;
+    }
+    else
+    {
+      return false;
+    }
+  }
+  while (*aPat == '*')
+  {
+    ++aPat;
+  }
+  return *aPat == '\0';
+}
+
+//=======================================================================
+// function : matchPatterns
+// purpose  :
+//=======================================================================
+bool DEJT_PartFilter::matchPatterns(const TCollection_AsciiString& theName,
+                                    const TCollection_AsciiString& thePath) const
+{
+  for (NCollection_List<TCollection_AsciiString>::Iterator anIter(myPatterns); anIter.More();
+       anIter.Next())
+  {
+    const TCollection_AsciiString& aPattern = anIter.Value();
+    if (MatchGlob(aPattern, aPattern.Search("/") != -1 ? thePath : theName))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//=======================================================================
+// function : matchLayers
+// purpose  :
+//=======================================================================
+bool DEJT_PartFilter::matchLayers(const TDF_Label& theLabel) const
+{
+  if (myLayerTool.IsNull())
+  {
+    return false;
+  }
+  Handle(TColStd_HSequenceOfExtendedString) aLayers = myLayerTool->GetLayers(theLabel);
+  if (aLayers.IsNull())
+  {
+    return false;
+  }
+  for (TColStd_HSequenceOfExtendedString::Iterator aLayerIter(*aLayers); aLayerIter.More();
+       aLayerIter.Next())
+  {
+    const TCollection_AsciiString aLayer(aLayerIter.Value(), '?');
+    for (NCollection_List<TCollection_AsciiString>::Iterator anIter(myLayers); anIter.More();
+         anIter.Next())
+    {
+      if (anIter.Value() == aLayer)
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+//=======================================================================
+// function : readFreeShapes
+// purpose  :
+//=======================================================================
+void DEJT_PartFilter::readFreeShapes(TDF_LabelSequence& theShapes) const
+{
+  TDF_LabelSequence aFreeShapes;
+  myShapeTool->GetFreeShapes(aFreeShapes);
+  for (TDF_LabelSequence::Iterator aFreeIter(aFreeShapes); aFreeIter.More(); aFreeIter.Next())
+  {
+    // labels of the read are appended to the shapes label after the existing ones
+    if (aFreeIter.Value().Tag() >= myFirstTag)
+    {
+      theShapes.Append(aFreeIter.Value());
+    }
+  }
+}
+
+//=======================================================================
+// function : filterNode
+// purpose  :
+//=======================================================================
+bool DEJT_PartFilter::filterNode(const TDF_Label&               theLabel,
+                                 const TCollection_AsciiString& theParentPath,
+                                 const TopLoc_Location&         theParentLoc,
+                                 const bool                     theIsNameMatched,
+                                 const bool                     theIsLayerMatched)
+{
+  TDF_Label aRefLabel = theLabel;
+  XCAFDoc_ShapeTool::GetReferredShape(theLabel, aRefLabel);
+
+  // instance name is preferred, as it identifies the occurrence
+  TCollection_AsciiString aName = labelName(theLabel);
+  if (aName.IsEmpty())
+  {
+    aName = labelName(aRefLabel);
+  }
+  const TCollection_AsciiString aPath = theParentPath + "/" + aName;
+  const TopLoc_Location aLoc = theParentLoc * XCAFDoc_ShapeTool::GetLocation(theLabel);
+  const bool isNameMatched = theIsNameMatched || matchPatterns(aName, aPath);
+  const bool isLayerMatched =
+    theIsLayerMatched || matchLayers(theLabel) || (aRefLabel != theLabel && matchLayers(aRefLabel));
+
+  bool isKept = false;
+  if (XCAFDoc_ShapeTool::IsAssembly(aRefLabel))
+  {
+    TDF_LabelSequence aComponents;
+    XCAFDoc_ShapeTool::GetComponents(aRefLabel, aComponents);
+    for (TDF_LabelSequence::Iterator aCompIter(aComponents); aCompIter.More(); aCompIter.Next())
+    {
+      const TDF_Label& aComponent = aCompIter.Value();
+      const bool isCompKept = filterNode(aComponent, aPath, aLoc, isNameMatched, isLayerMatched);
+      bool* aWasKept = myIsKept.ChangeSeek(aComponent);
+      if (aWasKept == NULL)
+      {
+        myIsKept.Bind(aComponent, isCompKept);
+      }
+      else
+      {
+        *aWasKept = *aWasKept || isCompKept;
+      }
+      isKept = isKept || isCompKept;
+    }
+    return isKept;
+  }
+
+  ++myNbParts;
+  isKept = (myPatterns.IsEmpty() || isNameMatched) && (myLayers.IsEmpty() || isLayerMatched);
+  if (isKept && !myBox.IsVoid())
+  {
+    Bnd_Box aBox;
+    BRepBndLib::Add(XCAFDoc_ShapeTool::GetShape(aRefLabel).Moved(aLoc), aBox, true);
+    isKept = !aBox.IsOut(myBox);
+  }
+  if (isKept)
+  {
+    ++myNbKept;
+  }
+  return isKept;
+}
+
+//=======================================================================
+// function : Perform
+// purpose  :
+//=======================================================================
+bool DEJT_PartFilter::Perform(const Handle(TDocStd_Document)& theDocument,
+                              const Standard_Integer          theFirstShapeTag)
+{
+  myNbParts  = 0;
+  myNbKept   = 0;
+  myFirstTag = theFirstShapeTag;
+  myIsKept.Clear();
+  if (theDocument.IsNull())
+  {
+    return false;
+  }
+  myShapeTool = XCAFDoc_DocumentTool::ShapeTool(theDocument->Main());
+  myLayerTool = XCAFDoc_DocumentTool::LayerTool(theDocument->Main());
+
+  TDF_LabelSequence aRoots;
+  readFreeShapes(aRoots);
+  if (aRoots.IsEmpty())
+  {
+    return false;
+  }
+  if (IsEmpty())
+  {
+    return true;
+  }
+
+  TDF_LabelSequence aRejectedRoots;
+  for (TDF_LabelSequence::Iterator aRootIter(aRoots); aRootIter.More(); aRootIter.Next())
+  {
+    if (!filterNode(aRootIter.Value(), "", TopLoc_Location(), false, false))
+    {
+      aRejectedRoots.Append(aRootIter.Value());
+    }
+  }
+
+  for (NCollection_DataMap<TDF_Label, bool>::Iterator aCompIter(myIsKept); aCompIter.More();
+       aCompIter.Next())
+  {
+    if (!aCompIter.Value())
+    {
+      myShapeTool->RemoveComponent(aCompIter.Key());
+    }
+  }
+  for (TDF_LabelSequence::Iterator aRootIter(aRejectedRoots); aRootIter.More(); aRootIter.Next())
+  {
+    myShapeTool->RemoveShape(aRootIter.Value());
+  }
+
+  // prototypes referred only by removed components become free shapes, remove them as well
+  NCollection_Map<TDF_Label> aRootsMap;
+  for (TDF_LabelSequence::Iterator aRootIter(aRoots); aRootIter.More(); aRootIter.Next())
+  {
+    aRootsMap.Add(aRootIter.Value());
+  }
+  for (bool isRemoved = true; isRemoved;)
+  {
+    isRemoved = false;
+    TDF_LabelSequence aFreeShapes;
+    readFreeShapes(aFreeShapes);
+    for (TDF_LabelSequence::Iterator aFreeIter(aFreeShapes); aFreeIter.More(); aFreeIter.Next())
+    {
+      if (!aRootsMap.Contains(aFreeIter.Value()))
+      {
+        isRemoved = myShapeTool->RemoveShape(aFreeIter.Value()) || isRemoved;
+      }
+    }
+  }
+  myShapeTool->UpdateAssemblies();
+  myIsKept.Clear();
+  return true;
+}
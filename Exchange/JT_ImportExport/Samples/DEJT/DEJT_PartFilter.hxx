@@ -0,0 +1,117 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#ifndef _DEJT_PartFilter_HeaderFile
+#define _DEJT_PartFilter_HeaderFile
+
+#include <Bnd_Box.hxx>
+#include <NCollection_DataMap.hxx>
+#include <NCollection_List.hxx>
+#include <TCollection_AsciiString.hxx>
+#include <TDF_Label.hxx>
+#include <TDF_LabelSequence.hxx>
+#include <TDocStd_Document.hxx>
+#include <TopLoc_Location.hxx>
+
+class XCAFDoc_LayerTool;
+class XCAFDoc_ShapeTool;
+
+//! Tool keeping only the selected sub-tree of the product structure of the document.
+//! A part occurrence is kept if it satisfies all defined criteria:
+//! - its name or the name of one of its parents matches one of the glob patterns
+//!   ('*' and '?' wildcards); patterns containing '/' are matched against the full path
+//!   of the node, composed of names of nodes from the root, e.g. "/Car/Engine*";
+//! - it or one of its parents belongs to one of the layers;
+//! - its bounding box intersects the query box.
+//! Assemblies are kept if at least one of their parts is kept.
+//! Since instanced sub-assemblies are shared, a component is removed only
+//! if it is rejected for all its occurrences.
+class DEJT_PartFilter
+{
+public:
+  //! Empty constructor, defines a filter accepting everything.
+  Standard_EXPORT DEJT_PartFilter();
+
+  //! Adds the glob pattern of node names or paths.
+  void AddPattern(const TCollection_AsciiString& thePattern) { myPatterns.Append(thePattern); }
+
+  //! Adds the name of the layer to keep.
+  void AddLayer(const TCollection_AsciiString& theLayer) { myLayers.Append(theLayer); }
+
+  //! Sets the query box; void box disables the criterion.
+  void SetBox(const Bnd_Box& theBox) { myBox = theBox; }
+
+  //! Returns TRUE if the filter accepts everything.
+  bool IsEmpty() const { return myPatterns.IsEmpty() && myLayers.IsEmpty() && myBox.IsVoid(); }
+
+  //! Removes rejected parts from the document.
+  //! Only shapes created by the last read are filtered, i.e. top-level shape labels
+  //! with tag not less than theFirstShapeTag (see DEJT_Provider::NextShapeTag());
+  //! shapes which were in the document before the read are left untouched.
+  //! The filter is applied to the translated document, so that it does not reduce
+  //! the amount of data read from the file.
+  //! @param[in] theDocument document to filter
+  //! @param[in] theFirstShapeTag tag of the first shape label created by the read
+  //! @return FALSE if the read has created no shapes
+  Standard_EXPORT bool Perform(const Handle(TDocStd_Document)& theDocument,
+                               const Standard_Integer          theFirstShapeTag = 1);
+
+  //! Returns the number of part occurrences met.
+  Standard_Integer NbParts() const { return myNbParts; }
+
+  //! Returns the number of kept part occurrences.
+  Standard_Integer NbKept() const { return myNbKept; }
+
+  //! Returns TRUE if the string matches the glob pattern with '*' and '?' wildcards.
+  Standard_EXPORT static bool MatchGlob(const TCollection_AsciiString& thePattern,
+                                        const TCollection_AsciiString& theString);
+
+private:
+  //! Evaluates the filter for the node and its children.
+  //! @param[in] theLabel root or component label
+  //! @param[in] theParentPath path of the parent node
+  //! @param[in] theParentLoc location of the parent node
+  //! @param[in] theIsNameMatched flag indicating that one of parents matches the patterns
+  //! @param[in] theIsLayerMatched flag indicating that one of parents belongs to the layers
+  //! @return TRUE if the node is kept
+  bool filterNode(const TDF_Label&               theLabel,
+                  const TCollection_AsciiString& theParentPath,
+                  const TopLoc_Location&         theParentLoc,
+                  const bool                     theIsNameMatched,
+                  const bool                     theIsLayerMatched);
+
+  //! Returns TRUE if the node name or path matches one of the patterns.
+  bool matchPatterns(const TCollection_AsciiString& theName,
+                     const TCollection_AsciiString& thePath) const;
+
+  //! Returns TRUE if the label belongs to one of the layers.
+  bool matchLayers(const TDF_Label& theLabel) const;
+
+  //! Returns free shapes created by the read being filtered.
+  void readFreeShapes(TDF_LabelSequence& theShapes) const;
+
+private:
+  NCollection_List<TCollection_AsciiString> myPatterns; //!< glob patterns of names or paths
+  NCollection_List<TCollection_AsciiString> myLayers;   //!< names of layers to keep
+  Bnd_Box                                   myBox;      //!< query box
+  Handle(XCAFDoc_ShapeTool)                 myShapeTool;
+  Handle(XCAFDoc_LayerTool)                 myLayerTool;
+  NCollection_DataMap<TDF_Label, bool>      myIsKept; //!< components kept in any occurrence
+  Standard_Integer                          myFirstTag; //!< first shape tag of the read
+  Standard_Integer                          myNbParts; //!< number of part occurrences met
+  Standard_Integer                          myNbKept;  //!< number of kept part occurrences
+};
+
+#endif // _DEJT_PartFilter_HeaderFile
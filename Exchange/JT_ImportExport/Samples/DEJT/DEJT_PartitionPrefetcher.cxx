@@ -0,0 +1,357 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#include <DEJT_PartitionPrefetcher.hxx>
+
+#include <DEJT_MappedFileSystem.hxx>
+#include <JtData_Model.hxx>
+#include <JtNode_Group.hxx>
+#include <JtNode_Instance.hxx>
+#include <JtNode_Partition.hxx>
+#include <Message.hxx>
+#include <Message_ProgressRange.hxx>
+#include <NCollection_Array1.hxx>
+#include <NCollection_IncAllocator.hxx>
+#include <NCollection_Map.hxx>
+#include <OSD_Parallel.hxx>
+#include <OSD_Path.hxx>
+#include <OSD_ThreadPool.hxx>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+//! Size of the page touched to make it resident.
+static const size_t THE_PAGE_SIZE = 4096;
+
+//! Size of the version string of JT file header.
+static const size_t THE_VERSION_SIZE = 80;
+
+//! Reads the unsigned integer of the given size stored with the given byte order.
+static uint64_t readUInt(const Standard_Byte* theData,
+                         const size_t         theSize,
+                         const bool           theIsBigEndian)
+{
+  uint64_t aValue = 0;
+  for (size_t aByteIter = 0; aByteIter < theSize; ++aByteIter)
+  {
+    const size_t aShift = theIsBigEndian ? (theSize - 1 - aByteIter) : aByteIter;
+    aValue |= uint64_t(theData[aByteIter]) << (8 * aShift);
+  }
+  return aValue;
+}
+
+//! Reads one byte of every page of the range, so that the pages are loaded into memory.
+static size_t touchRange(const Handle(NCollection_Buffer)& theContent,
+                         const uint64_t                    theOffset,
+                         const uint64_t                    theLength)
+{
+  if (theOffset >= theContent->Size())
+  {
+    return 0;
+  }
+  const size_t         aLength = size_t(Min(theLength, uint64_t(theContent->Size()) - theOffset));
+  const Standard_Byte* aData   = theContent->Data() + theOffset;
+  volatile Standard_Byte aSum  = 0;
+  for (size_t aPos = 0; aPos < aLength; aPos += THE_PAGE_SIZE)
+  {
+    aSum = Standard_Byte(aSum + aData[aPos]);
+  }
+  if (aLength != 0)
+  {
+    aSum = Standard_Byte(aSum + aData[aLength - 1]);
+  }
+  (void)aSum;
+  return aLength;
+}
+
+//! Collects partitions referenced by the node and its children.
+//! Partition nodes are not entered, as their content belongs to their own files.
+static void collectPartitions(const Handle(JtData_Object)&                   theNode,
+                              const TCollection_AsciiString&                 theFolder,
+                              NCollection_Map<Handle(JtData_Object)>&        theVisited,
+                              NCollection_Sequence<TCollection_AsciiString>& theFiles)
+{
+  if (theNode.IsNull() || !theVisited.Add(theNode))
+  {
+    return;
+  }
+  if (Handle(JtNode_Partition) aPartition = Handle(JtNode_Partition)::DownCast(theNode))
+  {
+    const TCollection_AsciiString aFileName(aPartition->FileName());
+    if (!aFileName.IsEmpty())
+    {
+      theFiles.Append(theFolder + aFileName);
+    }
+    return;
+  }
+  if (Handle(JtNode_Instance) anInstance = Handle(JtNode_Instance)::DownCast(theNode))
+  {
+    collectPartitions(anInstance->Object(), theFolder, theVisited, theFiles);
+    return;
+  }
+  if (Handle(JtNode_Group) aGroup = Handle(JtNode_Group)::DownCast(theNode))
+  {
+    for (size_t aChildIter = 0; aChildIter < aGroup->Children().size(); ++aChildIter)
+    {
+      collectPartitions(aGroup->Children()[aChildIter], theFolder, theVisited, theFiles);
+    }
+  }
+}
+
+//! Functor prefetching one file per task.
+class DEJT_PrefetchFunctor
+{
+public:
+  DEJT_PrefetchFunctor(
+    const NCollection_Array1<TCollection_AsciiString>&                  theFiles,
+    NCollection_Array1<size_t>&                                         theSizes,
+    NCollection_Array1<NCollection_Sequence<TCollection_AsciiString>>* theReferences)
+      : myFiles(theFiles),
+        mySizes(theSizes),
+        myReferences(theReferences),
+        myFileSystem(DEJT_MappedFileSystem::GlobalFileSystem())
+  {
+  }
+
+  void operator()(int theThreadIndex, int theIndex) const
+  {
+    (void)theThreadIndex;
+    const TCollection_AsciiString& aPath = myFiles.Value(theIndex);
+    // within the session the mapping is kept for the reader, otherwise it is released at once
+    Handle(NCollection_Buffer) aContent = myFileSystem->IsActive()
+                                            ? myFileSystem->Find(aPath)
+                                            : DEJT_MappedFileSystem::MapFile(aPath);
+    if (aContent.IsNull())
+    {
+      return;
+    }
+    mySizes.ChangeValue(theIndex) = DEJT_PartitionPrefetcher::TouchTocAndLsg(aContent);
+    if (myReferences != NULL && mySizes.Value(theIndex) != 0)
+    {
+      // the scene graph is read from the pages touched above
+      DEJT_PartitionPrefetcher::CollectReferences(aPath, myReferences->ChangeValue(theIndex));
+    }
+  }
+
+private:
+  const NCollection_Array1<TCollection_AsciiString>&                  myFiles;
+  NCollection_Array1<size_t>&                                         mySizes;
+  NCollection_Array1<NCollection_Sequence<TCollection_AsciiString>>* myReferences;
+  Handle(DEJT_MappedFileSystem)                                       myFileSystem;
+};
+} // namespace
+
+//=======================================================================
+// function : DEJT_PartitionPrefetcher
+// purpose  :
+//=======================================================================
+DEJT_PartitionPrefetcher::DEJT_PartitionPrefetcher()
+    : myNbFailed(0),
+      mySize(0)
+{
+}
+
+//=======================================================================
+// function : CollectReferences
+// purpose  :
+//=======================================================================
+bool DEJT_PartitionPrefetcher::CollectReferences(
+  const TCollection_AsciiString&                 theFilePath,
+  NCollection_Sequence<TCollection_AsciiString>& theFiles)
+{
+  // only the part of the file which does not use late loading is read
+  Handle(NCollection_IncAllocator) anAllocator = new NCollection_IncAllocator();
+  Handle(JtData_Model)             aModel      = new JtData_Model(theFilePath);
+  const Handle(JtNode_Partition)   aPartition  = aModel->Init(anAllocator, Message_ProgressRange());
+  if (aPartition.IsNull())
+  {
+    return false;
+  }
+
+  TCollection_AsciiString aFolder, aFileName;
+  OSD_Path::FolderAndFileFromPath(theFilePath, aFolder, aFileName);
+  NCollection_Map<Handle(JtData_Object)> aVisited;
+  aVisited.Add(aPartition);
+  if (Handle(JtNode_Group) aGroup = Handle(JtNode_Group)::DownCast(aPartition))
+  {
+    for (size_t aChildIter = 0; aChildIter < aGroup->Children().size(); ++aChildIter)
+    {
+      collectPartitions(aGroup->Children()[aChildIter], aFolder, aVisited, theFiles);
+    }
+  }
+  return true;
+}
+
+//=======================================================================
+// function : Perform
+// purpose  :
+//=======================================================================
+Standard_Integer DEJT_PartitionPrefetcher::Perform(const TCollection_AsciiString& theRootPath,
+                                                   const int                      theNbInFlight)
+{
+  myNbFailed = 0;
+  mySize     = 0;
+
+  // every round prefetches one level of the partition hierarchy
+  NCollection_Map<TCollection_AsciiString>      aVisited;
+  NCollection_Sequence<TCollection_AsciiString> aFiles;
+  aVisited.Add(theRootPath);
+  aFiles.Append(theRootPath);
+  Standard_Integer aNbFiles = 0;
+  while (!aFiles.IsEmpty())
+  {
+    NCollection_Sequence<TCollection_AsciiString> aReferences;
+    aNbFiles += prefetch(aFiles, theNbInFlight, &aReferences);
+    aFiles.Clear();
+    for (NCollection_Sequence<TCollection_AsciiString>::Iterator aRefIter(aReferences);
+         aRefIter.More();
+         aRefIter.Next())
+    {
+      if (aVisited.Add(aRefIter.Value()))
+      {
+        aFiles.Append(aRefIter.Value());
+      }
+    }
+  }
+  return aNbFiles;
+}
+
+//=======================================================================
+// function : Perform
+// purpose  :
+//=======================================================================
+Standard_Integer DEJT_PartitionPrefetcher::Perform(
+  const NCollection_Sequence<TCollection_AsciiString>& theFiles,
+  const int                                            theNbInFlight)
+{
+  myNbFailed = 0;
+  mySize     = 0;
+  return prefetch(theFiles, theNbInFlight, NULL);
+}
+
+//=======================================================================
+// function : prefetch
+// purpose  :
+//=======================================================================
+Standard_Integer DEJT_PartitionPrefetcher::prefetch(
+  const NCollection_Sequence<TCollection_AsciiString>& theFiles,
+  const int                                            theNbInFlight,
+  NCollection_Sequence<TCollection_AsciiString>*       theReferences)
+{
+  if (theFiles.IsEmpty())
+  {
+    return 0;
+  }
+
+  NCollection_Array1<TCollection_AsciiString> aFiles(0, theFiles.Length() - 1);
+  NCollection_Array1<size_t>                  aSizes(0, theFiles.Length() - 1);
+  NCollection_Array1<NCollection_Sequence<TCollection_AsciiString>> aReferences(
+    0,
+    theFiles.Length() - 1);
+  Standard_Integer                            aFileIndex = 0;
+  for (NCollection_Sequence<TCollection_AsciiString>::Iterator aFileIter(theFiles);
+       aFileIter.More();
+       aFileIter.Next(), ++aFileIndex)
+  {
+    aFiles.SetValue(aFileIndex, aFileIter.Value());
+  }
+  aSizes.Init(0);
+
+  // the work is bound by I/O latency rather than by CPU, so a dedicated pool is used
+  // to allow more files in flight than the default pool has threads
+  const int aNbInFlight =
+    Min(theNbInFlight > 0 ? theNbInFlight : OSD_Parallel::NbLogicalProcessors(), aFiles.Length());
+  Handle(OSD_ThreadPool)   aPool = new OSD_ThreadPool(aNbInFlight);
+  OSD_ThreadPool::Launcher aLauncher(*aPool, aNbInFlight);
+  aLauncher.Perform(
+    aFiles.Lower(),
+    aFiles.Upper() + 1,
+    DEJT_PrefetchFunctor(aFiles, aSizes, theReferences != NULL ? &aReferences : NULL));
+
+  Standard_Integer aNbFailed = 0;
+  for (Standard_Integer anIndex = aFiles.Lower(); anIndex <= aFiles.Upper(); ++anIndex)
+  {
+    if (aSizes.Value(anIndex) == 0)
+    {
+      ++aNbFailed;
+    }
+    mySize += aSizes.Value(anIndex);
+    if (theReferences != NULL)
+    {
+      theReferences->Append(aReferences.ChangeValue(anIndex));
+    }
+  }
+  myNbFailed += aNbFailed;
+  if (aNbFailed != 0)
+  {
+    Message::SendTrace() << "DEJT_PartitionPrefetcher: unable to prefetch " << aNbFailed
+                         << " of " << aFiles.Length() << " files";
+  }
+  return aFiles.Length() - aNbFailed;
+}
+
+//=======================================================================
+// function : TouchTocAndLsg
+// purpose  :
+//=======================================================================
+size_t DEJT_PartitionPrefetcher::TouchTocAndLsg(const Handle(NCollection_Buffer)& theContent)
+{
+  // header: version string, byte order, empty field, TOC offset, LSG segment ID
+  if (theContent.IsNull() || theContent->Size() < THE_VERSION_SIZE + 1 + 4 + 4 + 16
+      || strncmp((const char*)theContent->Data(), "Version ", 8) != 0)
+  {
+    return 0;
+  }
+  const Standard_Byte* aData         = theContent->Data();
+  const int            aMajorVersion = atoi((const char*)aData + 8);
+  const bool           isBigEndian   = aData[THE_VERSION_SIZE] != 0;
+  // offsets are 64-bit since JT 10
+  const size_t aOffsetSize = aMajorVersion >= 10 ? 8 : 4;
+  const size_t aPos        = THE_VERSION_SIZE + 1 + 4;
+  if (theContent->Size() < aPos + aOffsetSize + 16)
+  {
+    return 0;
+  }
+  const uint64_t       aTocOffset = readUInt(aData + aPos, aOffsetSize, isBigEndian);
+  const Standard_Byte* aLsgId     = aData + aPos + aOffsetSize;
+  size_t               aSize      = aPos + aOffsetSize + 16;
+  if (aTocOffset + 4 > theContent->Size())
+  {
+    return aSize;
+  }
+
+  // TOC entry: segment ID, segment offset, segment length, segment attributes
+  const uint64_t aNbEntries  = readUInt(aData + aTocOffset, 4, isBigEndian);
+  const size_t   anEntrySize = 16 + aOffsetSize + 4 + 4;
+  aSize += touchRange(theContent, aTocOffset, 4 + aNbEntries * anEntrySize);
+  for (uint64_t anEntryIter = 0; anEntryIter < aNbEntries; ++anEntryIter)
+  {
+    const uint64_t anEntryPos = aTocOffset + 4 + anEntryIter * anEntrySize;
+    if (anEntryPos + anEntrySize > theContent->Size())
+    {
+      break;
+    }
+    if (memcmp(aData + anEntryPos, aLsgId, 16) == 0)
+    {
+      const uint64_t aSegOffset = readUInt(aData + anEntryPos + 16, aOffsetSize, isBigEndian);
+      const uint64_t aSegLength = readUInt(aData + anEntryPos + 16 + aOffsetSize, 4, isBigEndian);
+      aSize += touchRange(theContent, aSegOffset, aSegLength);
+      break;
+    }
+  }
+  return aSize;
+}
@@ -0,0 +1,95 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#ifndef _DEJT_PartitionPrefetcher_HeaderFile
+#define _DEJT_PartitionPrefetcher_HeaderFile
+
+#include <NCollection_Buffer.hxx>
+#include <NCollection_Sequence.hxx>
+#include <TCollection_AsciiString.hxx>
+
+//! Tool prefetching the partition files of a shattered JT assembly.
+//! Shattered assemblies consist of many small partition files, which are resolved
+//! by JtData_Model one after another; on network storage the latency of every file
+//! dominates the reading time.
+//! The tool follows the partition references of the scene graph starting from the root file,
+//! so that only the files of the assembly are read, and reads the header, the TOC and
+//! the LSG segment of every file concurrently, keeping a bounded number of files in flight,
+//! so that the reader finds them in memory.
+//! Files of one level of the partition hierarchy are read at the same time,
+//! the files they refer to are read by the next round.
+//! Within an active DEJT_MappedFileSystem session the files remain mapped until
+//! the session is closed; otherwise the data is left in the system file cache.
+class DEJT_PartitionPrefetcher
+{
+public:
+  //! Empty constructor.
+  Standard_EXPORT DEJT_PartitionPrefetcher();
+
+  //! Collects the partition files referenced by the scene graph of the JT file;
+  //! paths are resolved relatively to the folder of the file.
+  //! Files referenced by the found partitions are not collected.
+  //! @param[in] theFilePath path to the JT file
+  //! @param[out] theFiles appended paths of the referenced files
+  //! @return FALSE if the scene graph of the file cannot be read
+  Standard_EXPORT static bool CollectReferences(
+    const TCollection_AsciiString&                 theFilePath,
+    NCollection_Sequence<TCollection_AsciiString>& theFiles);
+
+  //! Prefetches the root file and the partition files it refers to, directly or indirectly.
+  //! @param[in] theRootPath path to the root file of the assembly
+  //! @param[in] theNbInFlight maximum number of files read at the same time;
+  //!                          0 means the number of logical processors
+  //! @return number of prefetched files
+  Standard_EXPORT Standard_Integer Perform(const TCollection_AsciiString& theRootPath,
+                                           const int                      theNbInFlight = 0);
+
+  //! Prefetches the files; partition references of the files are not followed.
+  //! @param[in] theFiles paths to JT files
+  //! @param[in] theNbInFlight maximum number of files read at the same time;
+  //!                          0 means the number of logical processors
+  //! @return number of prefetched files
+  Standard_EXPORT Standard_Integer
+    Perform(const NCollection_Sequence<TCollection_AsciiString>& theFiles,
+            const int                                            theNbInFlight = 0);
+
+  //! Returns the number of files failed to prefetch by the last call.
+  Standard_Integer NbFailed() const { return myNbFailed; }
+
+  //! Returns the number of bytes read by the last call.
+  size_t Size() const { return mySize; }
+
+  //! Reads the header, the TOC and the LSG segment of the JT file content,
+  //! so that the corresponding pages of the mapped file are loaded into memory.
+  //! @param[in] theContent content of the JT file
+  //! @return number of bytes read or 0 if the content is not a valid JT file
+  Standard_EXPORT static size_t TouchTocAndLsg(const Handle(NCollection_Buffer)& theContent);
+
+private:
+  //! Prefetches the files concurrently and accumulates the counters.
+  //! @param[in] theFiles paths to JT files
+  //! @param[in] theNbInFlight maximum number of files read at the same time
+  //! @param[out] theReferences if not NULL, receives the files referenced by theFiles
+  //! @return number of prefetched files
+  Standard_Integer prefetch(const NCollection_Sequence<TCollection_AsciiString>& theFiles,
+                            const int                                            theNbInFlight,
+                            NCollection_Sequence<TCollection_AsciiString>*       theReferences);
+
+private:
+  Standard_Integer myNbFailed; //!< number of files failed to prefetch
+  size_t           mySize;     //!< number of bytes read
+};
+
+#endif // _DEJT_PartitionPrefetcher_HeaderFile
@@ -0,0 +1,313 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+#include <DEJT_ProgressiveReader.hxx>
+
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <DEJT_Provider.hxx>
+#include <JTCAFControl_Reader.hxx>
+#include <Message.hxx>
+#include <Message_ProgressIndicator.hxx>
+#include <Standard_Failure.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+
+IMPLEMENT_STANDARD_RTTIEXT(DEJT_ProgressiveReader, Standard_Transient)
+
+namespace
+{
+//! Progress indicator interrupting the background pass on abort request.
+class DEJT_AbortIndicator : public Message_ProgressIndicator
+{
+public:
+  DEJT_AbortIndicator(const std::atomic<bool>& theToAbort)
+      : myToAbort(theToAbort)
+  {
+  }
+
+  virtual Standard_Boolean UserBreak() Standard_OVERRIDE { return myToAbort; }
+
+  virtual void Show(const Message_ProgressScope&, const Standard_Boolean) Standard_OVERRIDE {}
+
+private:
+  const std::atomic<bool>& myToAbort;
+};
+} // namespace
+
+//=======================================================================
+// function : DEJT_ProgressiveReader
+// purpose  :
+//=======================================================================
+DEJT_ProgressiveReader::DEJT_ProgressiveReader(const Handle(DEJT_ConfigurationNode)& theNode)
+    : myNode(Handle(DEJT_ConfigurationNode)::DownCast(theNode->Copy())),
+      myReadyLod(-1),
+      myNbLods(0),
+      myCurrentLod(-1),
+      myFirstTag(1),
+      myToAbort(false),
+      myIsDone(true),
+      myHasFailed(false)
+{
+  // late data is released after each pass, finer LODs are read by the next passes
+  myNode->InternalParameters.ReadKeepLateData = false;
+}
+
+//=======================================================================
+// function : ~DEJT_ProgressiveReader
+// purpose  :
+//=======================================================================
+DEJT_ProgressiveReader::~DEJT_ProgressiveReader()
+{
+  Abort();
+}
+
+//=======================================================================
+// function : Perform
+// purpose  :
+//=======================================================================
+bool DEJT_ProgressiveReader::Perform(const TCollection_AsciiString&  thePath,
+                                     const Handle(TDocStd_Document)& theDocument,
+                                     const Message_ProgressRange&    theProgress)
+{
+  Abort();
+  myPath       = thePath;
+  myDocument   = theDocument;
+  myReadyDoc.Nullify();
+  myReadyLod   = -1;
+  myCurrentLod = -1;
+  myToAbort    = false;
+  myHasFailed  = false;
+
+  Message_ProgressScope aPS(theProgress, "Reading coarse LOD", 2);
+  {
+    // the scene graph defines the number of LODs, shape segments are not needed
+    JTCAFControl_Reader aReader;
+    aReader.SetToSkipLateDataLoading(true);
+    aReader.SetTranslateMetadata(false);
+    aReader.SetTranslatePMI(false);
+    Handle(TDocStd_Document) aDoc = new TDocStd_Document("BinXCAF");
+    if (!aReader.Perform(aDoc, thePath.ToCString(), aPS.Next()))
+    {
+      Message::SendFail() << "Error in the DEJT_ProgressiveReader during reading the file "
+                          << thePath << "\t: Error: file reading failed";
+      return false;
+    }
+    myNbLods = aReader.NbTriangulationLods();
+  }
+
+  const Standard_Integer aTargetLod = Min(TargetLod(), Max(myNbLods - 1, 0));
+  const Standard_Integer aCoarseLod = Max(myNbLods - 1, aTargetLod);
+  Handle(DEJT_ConfigurationNode) aNode =
+    Handle(DEJT_ConfigurationNode)::DownCast(myNode->Copy());
+  aNode->InternalParameters.ReadLodIndex = aCoarseLod;
+  Handle(DEJT_Provider) aProvider        = new DEJT_Provider(aNode);
+  // parts of the finer passes are mapped onto the labels created by the coarse one
+  myFirstTag = DEJT_Provider::NextShapeTag(theDocument);
+  if (!aProvider->Read(thePath, theDocument, aPS.Next()))
+  {
+    return false;
+  }
+  myCurrentLod = aCoarseLod;
+  if (aCoarseLod == aTargetLod || aPS.UserBreak())
+  {
+    return true;
+  }
+
+  myIsDone = false;
+  myThread = std::thread(&DEJT_ProgressiveReader::performBackground, this);
+  return true;
+}
+
+//=======================================================================
+// function : readLod
+// purpose  :
+//=======================================================================
+Handle(TDocStd_Document) DEJT_ProgressiveReader::readLod(
+  const Standard_Integer       theLod,
+  const Message_ProgressRange& theProgress) const
+{
+  Handle(DEJT_ConfigurationNode) aNode =
+    Handle(DEJT_ConfigurationNode)::DownCast(myNode->Copy());
+  aNode->InternalParameters.ReadLodIndex = theLod;
+  // metadata is already transferred by the coarse pass
+  aNode->InternalParameters.ReadTranslateMetadata = false;
+  aNode->InternalParameters.ReadTranslatePMI      = false;
+
+  Handle(TDocStd_Document) aDoc      = new TDocStd_Document("BinXCAF");
+  Handle(DEJT_Provider)    aProvider = new DEJT_Provider(aNode);
+  if (!aProvider->Read(myPath, aDoc, theProgress))
+  {
+    return Handle(TDocStd_Document)();
+  }
+  return aDoc;
+}
+
+//=======================================================================
+// function : performBackground
+// purpose  :
+//=======================================================================
+void DEJT_ProgressiveReader::performBackground()
+{
+  // exceptions should never leave the thread body, otherwise the process is terminated
+  try
+  {
+    Handle(DEJT_AbortIndicator) anIndicator = new DEJT_AbortIndicator(myToAbort);
+    const Standard_Integer      aTargetLod  = Min(TargetLod(), Max(myNbLods - 1, 0));
+    // the target LOD is read directly, intermediate LODs would cost a full pass each
+    Handle(TDocStd_Document) aDoc = readLod(aTargetLod, anIndicator->Start());
+    if (!aDoc.IsNull())
+    {
+      std::lock_guard<std::mutex> aLock(myMutex);
+      myReadyDoc = aDoc;
+      myReadyLod = aTargetLod;
+    }
+    else if (!myToAbort)
+    {
+      myHasFailed = true;
+    }
+  }
+  catch (const Standard_Failure& theFailure)
+  {
+    Message::SendFail() << "Error in the DEJT_ProgressiveReader during reading the file " << myPath
+                        << "\t: Exception: " << theFailure.GetMessageString();
+    myHasFailed = true;
+  }
+  catch (...)
+  {
+    Message::SendFail() << "Error in the DEJT_ProgressiveReader during reading the file " << myPath
+                        << "\t: Unknown exception";
+    myHasFailed = true;
+  }
+  myIsDone = true;
+}
+
+//=======================================================================
+// function : Refine
+// purpose  :
+//=======================================================================
+Standard_Integer DEJT_ProgressiveReader::Refine()
+{
+  Handle(TDocStd_Document) aDoc;
+  Standard_Integer         aLod = -1;
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    aDoc = myReadyDoc;
+    aLod = myReadyLod;
+    myReadyDoc.Nullify();
+  }
+  if (aDoc.IsNull() || myDocument.IsNull())
+  {
+    return 0;
+  }
+
+  myCurrentLod = aLod;
+  return transferTriangulations(aDoc, aLod);
+}
+
+//=======================================================================
+// function : transferTriangulations
+// purpose  :
+//=======================================================================
+Standard_Integer DEJT_ProgressiveReader::transferTriangulations(
+  const Handle(TDocStd_Document)& theSource,
+  const Standard_Integer          theLod)
+{
+  Handle(XCAFDoc_ShapeTool) aSourceTool = XCAFDoc_DocumentTool::ShapeTool(theSource->Main());
+  TDF_LabelSequence         aParts;
+  aSourceTool->GetShapes(aParts);
+
+  BRep_Builder     aBuilder;
+  Standard_Integer aNbRefined = 0;
+  for (TDF_LabelSequence::Iterator aPartIter(aParts); aPartIter.More(); aPartIter.Next())
+  {
+    const TDF_Label& aSourceLabel = aPartIter.Value();
+    if (!XCAFDoc_ShapeTool::IsSimpleShape(aSourceLabel))
+    {
+      continue;
+    }
+
+    // the target document may have contained shapes before the coarse pass
+    const TDF_Label aTargetLabel =
+      DEJT_Provider::MapShapeLabel(aSourceLabel, myDocument, myFirstTag);
+    if (aTargetLabel.IsNull() || !XCAFDoc_ShapeTool::IsSimpleShape(aTargetLabel))
+    {
+      continue;
+    }
+
+    const TopoDS_Shape aTargetShape = XCAFDoc_ShapeTool::GetShape(aTargetLabel);
+    const TopoDS_Shape aSourceShape = XCAFDoc_ShapeTool::GetShape(aSourceLabel);
+    // faces are created in the same order by every pass
+    bool            isRefined = false;
+    TopExp_Explorer aTargetExp(aTargetShape, TopAbs_FACE);
+    TopExp_Explorer aSourceExp(aSourceShape, TopAbs_FACE);
+    for (; aTargetExp.More() && aSourceExp.More(); aTargetExp.Next(), aSourceExp.Next())
+    {
+      TopLoc_Location                   aLoc;
+      const Handle(Poly_Triangulation)& aTriangulation =
+        BRep_Tool::Triangulation(TopoDS::Face(aSourceExp.Current()), aLoc);
+      if (!aTriangulation.IsNull())
+      {
+        aBuilder.UpdateFace(TopoDS::Face(aTargetExp.Current()), aTriangulation);
+        isRefined = true;
+      }
+    }
+    if (isRefined)
+    {
+      ++aNbRefined;
+      OnPartRefined(aTargetLabel, theLod);
+    }
+  }
+  return aNbRefined;
+}
+
+//=======================================================================
+// function : Wait
+// purpose  :
+//=======================================================================
+void DEJT_ProgressiveReader::Wait()
+{
+  if (myThread.joinable())
+  {
+    myThread.join();
+  }
+  Refine();
+}
+
+//=======================================================================
+// function : Abort
+// purpose  :
+//=======================================================================
+void DEJT_ProgressiveReader::Abort()
+{
+  myToAbort = true;
+  if (myThread.joinable())
+  {
+    myThread.join();
+  }
+  myIsDone = true;
+}
+
+//=======================================================================
+// function : OnPartRefined
+// purpose  :
+//=======================================================================
+void DEJT_ProgressiveReader::OnPartRefined(const TDF_Label&       thePart,
+                                           const Standard_Integer theLod)
+{
+  (void)thePart;
+  (void)theLod;
+}
@@ -0,0 +1,128 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+#ifndef _DEJT_ProgressiveReader_HeaderFile
+#define _DEJT_ProgressiveReader_HeaderFile
+
+#include <DEJT_ConfigurationNode.hxx>
+#include <TDF_Label.hxx>
+#include <TDocStd_Document.hxx>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+//! Progressive reader of JT files.
+//! The document is first filled with the coarsest triangulation LOD of every part,
+//! so that the model can be displayed as soon as possible;
+//! the target LOD DEJT_ConfigurationNode::InternalParameters::ReadLodIndex
+//! is then read directly by a single pass in the background thread,
+//! without reading the intermediate LODs.
+//!
+//! The background thread never modifies the target document:
+//! the refined triangulations are applied by DEJT_ProgressiveReader::Refine(),
+//! which should be called periodically from the thread owning the document
+//! (e.g. from the idle handler of the viewer). Each refined part
+//! is reported by DEJT_ProgressiveReader::OnPartRefined().
+//!
+//! Parts are matched through DEJT_Provider::MapShapeLabel() relative to the first shape label
+//! created by the coarse pass, as every pass reads the same assembly structure,
+//! so that the document may already contain other shapes;
+//! the triangulations are replaced in place, so that all instances of the part are updated.
+class DEJT_ProgressiveReader : public Standard_Transient
+{
+  DEFINE_STANDARD_RTTIEXT(DEJT_ProgressiveReader, Standard_Transient)
+public:
+  //! Creates the reader.
+  //! @param[in] theNode reading parameters; the node is copied
+  Standard_EXPORT DEJT_ProgressiveReader(const Handle(DEJT_ConfigurationNode)& theNode);
+
+  //! Aborts and waits for the background reading.
+  Standard_EXPORT virtual ~DEJT_ProgressiveReader();
+
+  //! Reads the coarsest LOD into the document and starts reading finer LODs in the background.
+  //! @param[in] thePath path to the JT file
+  //! @param[in] theDocument document to fill
+  //! @param[in] theProgress progress indicator of the coarse pass
+  //! @return FALSE if the coarse pass has failed
+  Standard_EXPORT bool Perform(const TCollection_AsciiString&  thePath,
+                               const Handle(TDocStd_Document)& theDocument,
+                               const Message_ProgressRange&    theProgress = Message_ProgressRange());
+
+  //! Applies the finest LOD read by the background thread so far to the document.
+  //! Should be called from the thread owning the document.
+  //! @return number of refined parts
+  Standard_EXPORT Standard_Integer Refine();
+
+  //! Returns TRUE if the background reading is finished (or has not been started).
+  bool IsDone() const { return myIsDone; }
+
+  //! Returns TRUE if the background reading has failed;
+  //! the document keeps the coarse LOD in this case.
+  bool HasFailed() const { return myHasFailed; }
+
+  //! Waits for the background reading and applies the result.
+  Standard_EXPORT void Wait();
+
+  //! Stops the background reading; parts already refined are kept.
+  Standard_EXPORT void Abort();
+
+  //! Returns the number of triangulation LODs in the file.
+  Standard_Integer NbLods() const { return myNbLods; }
+
+  //! Returns the LOD currently displayed by the document.
+  Standard_Integer CurrentLod() const { return myCurrentLod; }
+
+  //! Returns the finest LOD to read.
+  Standard_Integer TargetLod() const { return myNode->InternalParameters.ReadLodIndex; }
+
+protected:
+  //! Called by DEJT_ProgressiveReader::Refine() for each refined part.
+  //! @param[in] thePart label of the part within the target document
+  //! @param[in] theLod LOD index of the new triangulation
+  Standard_EXPORT virtual void OnPartRefined(const TDF_Label& thePart, const Standard_Integer theLod);
+
+private:
+  //! Reads the requested LOD into a new document.
+  Handle(TDocStd_Document) readLod(const Standard_Integer       theLod,
+                                   const Message_ProgressRange& theProgress) const;
+
+  //! Reads the target LOD; executed by the background thread.
+  void performBackground();
+
+  //! Copies triangulations of the parts from the source document into the target one.
+  Standard_Integer transferTriangulations(const Handle(TDocStd_Document)& theSource,
+                                          const Standard_Integer          theLod);
+
+private:
+  DEJT_ProgressiveReader(const DEJT_ProgressiveReader&);
+  DEJT_ProgressiveReader& operator=(const DEJT_ProgressiveReader&);
+
+private:
+  Handle(DEJT_ConfigurationNode) myNode;       //!< reading parameters
+  TCollection_AsciiString        myPath;       //!< path to the JT file
+  Handle(TDocStd_Document)       myDocument;   //!< target document
+  Handle(TDocStd_Document)       myReadyDoc;   //!< finest document read in the background
+  Standard_Integer               myReadyLod;   //!< LOD of myReadyDoc
+  Standard_Integer               myNbLods;     //!< number of LODs in the file
+  Standard_Integer               myCurrentLod; //!< LOD applied to the target document
+  Standard_Integer               myFirstTag;   //!< tag of the first shape label of the coarse pass
+  std::thread                    myThread;     //!< background thread
+  std::mutex                     myMutex;      //!< mutex protecting myReadyDoc
+  std::atomic<bool>              myToAbort;    //!< flag to stop background reading
+  std::atomic<bool>              myIsDone;     //!< flag indicating finished background reading
+  std::atomic<bool>              myHasFailed;  //!< flag indicating failed background reading
+};
+
+#endif // _DEJT_ProgressiveReader_HeaderFile
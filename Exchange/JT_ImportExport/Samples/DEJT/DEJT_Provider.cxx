@@ -17,14 +17,26 @@
 #include <BinXCAFDrivers.hxx>
 #include <BRep_Builder.hxx>
 #include <DEJT_ConfigurationNode.hxx>
+#include <DEJT_MappedFileSystem.hxx>
+#include <DEJT_MeshSink.hxx>
+#include <DEJT_MetadataStore.hxx>
+#include <DEJT_ModelCache.hxx>
+#include <DEJT_PartFilter.hxx>
+#include <DEJT_PartitionPrefetcher.hxx>
+#include <DEJT_TriangulationDeduplicator.hxx>
 #include <JtTools_FileDumpBRepProvider.hxx>
 #include <JtWireframe_BRepProvider.hxx>
 #include <JTCAFControl_Reader.hxx>
 #include <JtNode_Partition.hxx>
+#include <TColStd_ListOfInteger.hxx>
+#include <TDF_ChildIterator.hxx>
+#include <TDF_TagSource.hxx>
 #include <TDocStd_Application.hxx>
 #include <XCAFDoc_ShapeTool.hxx>
 #include <XCAFDoc_DocumentTool.hxx>
 
+#include <atomic>
+
 IMPLEMENT_STANDARD_RTTIEXT(DEJT_Provider, DE_Provider)
 
 //=======================================================================
@@ -100,6 +112,28 @@ bool DEJT_Provider::Read(const TCollection_AsciiString&  thePath,
       new JtTools_FileDumpBRepProvider(aNode->InternalParameters.ReadDumpBRepProvider);
   }
 
+  // labels created by this read, used to match the documents of the deferred passes
+  const Standard_Integer aFirstShapeTag = NextShapeTag(theDocument);
+
+  // the cached model replaces the document content, so it is applied only to empty documents
+  TCollection_AsciiString aCacheEntry;
+  DEJT_ModelCache         aCache(aNode->InternalParameters.ReadCacheDir);
+  TDF_LabelSequence       aFreeShapes;
+  XCAFDoc_DocumentTool::ShapeTool(theDocument->Main())->GetFreeShapes(aFreeShapes);
+  if (!aNode->InternalParameters.ReadCacheDir.IsEmpty() && aFreeShapes.IsEmpty())
+  {
+    aCacheEntry = aCache.EntryPath(thePath, aNode);
+    if (aCache.Load(aCacheEntry, theDocument))
+    {
+      if (aNode->InternalParameters.ReadLazyMetadata
+          && aNode->InternalParameters.ReadTranslateMetadata)
+      {
+        DEJT_MetadataStore::Set(theDocument, aNode, thePath, aFirstShapeTag);
+      }
+      return true;
+    }
+  }
+
   {
     JTCAFControl_Reader aReader;
     aReader.SetParallel(aNode->InternalParameters.ReadParallel);
@@ -107,7 +141,8 @@ bool DEJT_Provider::Read(const TCollection_AsciiString&  thePath,
     aReader.SetSkipDegenerateTriangles(aNode->InternalParameters.ReadSkipDegenerateTriangles);
     aReader.SetDeduplicatePrimitives(aNode->InternalParameters.ReadDeduplicatePrims);
     aReader.SetDeferMetadata(aNode->InternalParameters.ReadDeferMetadata);
-    aReader.SetCacheFileContent(aNode->InternalParameters.ReadCacheFileContent);
+    aReader.SetCacheFileContent(aNode->InternalParameters.ReadFileAccessMode
+                                == DEJT_ConfigurationNode::ReadMode_FileAccess_Cache);
     aReader.SetPreferredRepresentation(aPrefGeomRepr);
     aReader.SetLoadHiddenMetadata(aNode->InternalParameters.ReadHiddenMetadata);
     aReader.SetToSkipLateDataLoading(aNode->InternalParameters.ReadSkipLateDataLoading);
@@ -115,7 +150,8 @@ bool DEJT_Provider::Read(const TCollection_AsciiString&  thePath,
     aReader.SetToLoadStrictly(aNode->InternalParameters.ReadLoadStrictly);
     aReader.SetToPrintDebugMessages(aNode->InternalParameters.ReadPrintDebugInfo);
     aReader.SetFilterLayers(aNode->InternalParameters.ReadFilterLayers);
-    aReader.SetTranslateMetadata(aNode->InternalParameters.ReadTranslateMetadata);
+    aReader.SetTranslateMetadata(aNode->InternalParameters.ReadTranslateMetadata
+                                 && !aNode->InternalParameters.ReadLazyMetadata);
     aReader.SetTranslatePMI(aNode->InternalParameters.ReadTranslatePMI);
     aReader.SetCheckBRepTypes(aNode->InternalParameters.ReadCheckBRepTypes);
 
@@ -145,6 +181,17 @@ bool DEJT_Provider::Read(const TCollection_AsciiString&  thePath,
     }
 
     aReader.SetSystemLengthUnit(aLengthUnitM);
+    // file content is served from the mapping instead of re-opening the file for each segment
+    DEJT_MappedFileSystem::Sentry aMappingSentry(
+      thePath,
+      aNode->InternalParameters.ReadFileAccessMode
+      == DEJT_ConfigurationNode::ReadMode_FileAccess_MemoryMap);
+    if (aNode->InternalParameters.ReadPrefetchPartitions)
+    {
+      // partition files are resolved by the reader one after another, read them ahead concurrently
+      DEJT_PartitionPrefetcher aPrefetcher;
+      aPrefetcher.Perform(thePath, aNode->InternalParameters.ReadPrefetchInFlight);
+    }
     if (!aReader.Perform(theDocument, thePath.ToCString(), theProgress))
     {
       Message::SendFail() << "Error in the DEJT_Provider during reading the file " << thePath
@@ -160,6 +207,41 @@ bool DEJT_Provider::Read(const TCollection_AsciiString&  thePath,
     }
   }
 
+  DEJT_PartFilter aFilter;
+  for (TColStd_ListOfAsciiString::Iterator anIter(aNode->InternalParameters.ReadOnlyPatterns);
+       anIter.More();
+       anIter.Next())
+  {
+    aFilter.AddPattern(anIter.Value());
+  }
+  for (TColStd_ListOfAsciiString::Iterator anIter(aNode->InternalParameters.ReadOnlyLayers);
+       anIter.More();
+       anIter.Next())
+  {
+    aFilter.AddLayer(anIter.Value());
+  }
+  aFilter.SetBox(aNode->InternalParameters.ReadOnlyBox);
+  if (!aFilter.IsEmpty())
+  {
+    aFilter.Perform(theDocument, aFirstShapeTag);
+  }
+
+  if (aNode->InternalParameters.ReadDeduplicateMeshes)
+  {
+    DEJT_TriangulationDeduplicator aDeduplicator;
+    aDeduplicator.Perform(theDocument);
+  }
+
+  if (!aCacheEntry.IsEmpty())
+  {
+    aCache.Store(thePath, aNode, theDocument);
+  }
+
+  if (aNode->InternalParameters.ReadLazyMetadata && aNode->InternalParameters.ReadTranslateMetadata)
+  {
+    DEJT_MetadataStore::Set(theDocument, aNode, thePath, aFirstShapeTag);
+  }
+
   return true;
 }
 
@@ -180,6 +262,15 @@ bool DEJT_Provider::Write(const TCollection_AsciiString&  thePath,
   Handle(DEJT_ConfigurationNode) aNode = Handle(DEJT_ConfigurationNode)::DownCast(GetNode());
 
   JtData_Array<IMeshTools_Parameters> aLODParameters;
+  for (TColStd_ListOfReal::Iterator aDeflIter(aNode->InternalParameters.WriteLodDeflections);
+       aDeflIter.More();
+       aDeflIter.Next())
+  {
+    // faces of the part are meshed concurrently, LODs are stored in the given order
+    aLODParameters.push_back(IMeshTools_Parameters());
+    aLODParameters.back().Deflection = aDeflIter.Value();
+    aLODParameters.back().InParallel = aNode->InternalParameters.WriteParallel;
+  }
   JtData_LengthUnit                   aJtLengthUnit = aNode->InternalParameters.WriteJTLengthUnit;
   Standard_Real           aCafLengthUnitM = JtData_Model::GetJtLengthUnitScale(aJtLengthUnit);
   JTCAFControl_NameFormat aNameFormat =
@@ -287,6 +378,153 @@ bool DEJT_Provider::Write(const TCollection_AsciiString& thePath,
   return Write(thePath, aDoc, theProgress);
 }
 
+//=======================================================================
+// function : Read
+// purpose  :
+//=======================================================================
+bool DEJT_Provider::Read(std::istream&                   theStream,
+                         const TCollection_AsciiString&  theName,
+                         const Handle(TDocStd_Document)& theDocument,
+                         const Message_ProgressRange&    theProgress)
+{
+  const Handle(NCollection_Buffer) aBuffer = DEJT_MappedFileSystem::ReadStream(theStream);
+  if (aBuffer.IsNull())
+  {
+    Message::SendFail() << "Error in the DEJT_Provider during reading the stream " << theName
+                        << "\t: Error: unable to read the stream content";
+    return false;
+  }
+  return Read(aBuffer, theName, theDocument, theProgress);
+}
+
+//=======================================================================
+// function : Read
+// purpose  :
+//=======================================================================
+bool DEJT_Provider::Read(const Handle(NCollection_Buffer)& theBuffer,
+                         const TCollection_AsciiString&    theName,
+                         const Handle(TDocStd_Document)&   theDocument,
+                         const Message_ProgressRange&      theProgress)
+{
+  if (theBuffer.IsNull() || theBuffer->IsEmpty())
+  {
+    Message::SendFail() << "Error in the DEJT_Provider during reading the stream " << theName
+                        << "\t: Error: empty content";
+    return false;
+  }
+
+  // unique virtual path, so that concurrent reads of the same name do not interfere
+  static std::atomic<int>       THE_STREAM_COUNTER(0);
+  const TCollection_AsciiString aVirtualPath = TCollection_AsciiString("jtstream-")
+                                               + (++THE_STREAM_COUNTER) + "/"
+                                               + (theName.IsEmpty() ? "stream.jt" : theName);
+  const Handle(DEJT_MappedFileSystem)& aFileSystem = DEJT_MappedFileSystem::GlobalFileSystem();
+  aFileSystem->Bind(aVirtualPath, theBuffer);
+  const bool isDone = Read(aVirtualPath, theDocument, theProgress);
+  aFileSystem->Unbind(aVirtualPath);
+
+  const Handle(DEJT_MetadataStore) aMetadataStore = DEJT_MetadataStore::Find(theDocument->Main());
+  if (isDone && !aMetadataStore.IsNull())
+  {
+    // metadata is read later from the same content
+    aMetadataStore->SetContent(theBuffer);
+  }
+  return isDone;
+}
+
+//=======================================================================
+// function : Read
+// purpose  :
+//=======================================================================
+bool DEJT_Provider::Read(const TCollection_AsciiString& thePath,
+                         DEJT_MeshSink&                 theSink,
+                         const Message_ProgressRange&   theProgress)
+{
+  if (!GetNode()->IsKind(STANDARD_TYPE(DEJT_ConfigurationNode)))
+  {
+    Message::SendFail() << "Error in the DEJT_Provider during reading the file " << thePath
+                        << "\t: Incorrect or empty Configuration Node";
+    return false;
+  }
+  Handle(DEJT_ConfigurationNode) aNode =
+    Handle(DEJT_ConfigurationNode)::DownCast(GetNode()->Copy());
+  aNode->InternalParameters.ReadPrefGeomRepr      = DEJT_ConfigurationNode::ReadMode_PrefGeomRepr_Mesh;
+  aNode->InternalParameters.ReadTranslateMetadata = false;
+  aNode->InternalParameters.ReadTranslatePMI      = false;
+  aNode->InternalParameters.ReadLazyMetadata      = false;
+  aNode->InternalParameters.ReadKeepLateData      = false;
+
+  Handle(TDocStd_Document) aDoc      = new TDocStd_Document("BinXCAF");
+  Handle(DEJT_Provider)    aProvider = new DEJT_Provider(aNode);
+  if (!aProvider->Read(thePath, aDoc, theProgress))
+  {
+    return false;
+  }
+  theSink.Perform(aDoc, aNode->InternalParameters.ReadLodIndex);
+  return true;
+}
+
+//=======================================================================
+// function : NextShapeTag
+// purpose  :
+//=======================================================================
+Standard_Integer DEJT_Provider::NextShapeTag(const Handle(TDocStd_Document)& theDocument)
+{
+  const TDF_Label       aShapes  = XCAFDoc_DocumentTool::ShapesLabel(theDocument->Main());
+  Standard_Integer      aLastTag = 0;
+  Handle(TDF_TagSource) aTagSource;
+  if (aShapes.FindAttribute(TDF_TagSource::GetID(), aTagSource))
+  {
+    aLastTag = aTagSource->Get();
+  }
+  for (TDF_ChildIterator aChildIter(aShapes); aChildIter.More(); aChildIter.Next())
+  {
+    aLastTag = Max(aLastTag, aChildIter.Value().Tag());
+  }
+  return aLastTag + 1;
+}
+
+//=======================================================================
+// function : MapShapeLabel
+// purpose  :
+//=======================================================================
+TDF_Label DEJT_Provider::MapShapeLabel(const TDF_Label&                theSource,
+                                       const Handle(TDocStd_Document)& theTarget,
+                                       const Standard_Integer          theFirstTag)
+{
+  if (theSource.IsNull())
+  {
+    return TDF_Label();
+  }
+
+  // tags of the path from the shapes label to the source label
+  const TDF_Label       aSourceShapes = XCAFDoc_DocumentTool::ShapesLabel(theSource);
+  TColStd_ListOfInteger aTags;
+  for (TDF_Label aLabel = theSource; aLabel != aSourceShapes; aLabel = aLabel.Father())
+  {
+    if (aLabel.IsRoot())
+    {
+      return TDF_Label();
+    }
+    aTags.Prepend(aLabel.Tag());
+  }
+  if (aTags.IsEmpty())
+  {
+    return TDF_Label();
+  }
+
+  // the top-level shape labels of the separate read start from tag 1
+  TDF_Label aTarget = XCAFDoc_DocumentTool::ShapesLabel(theTarget->Main());
+  aTarget           = aTarget.FindChild(aTags.First() + theFirstTag - 1, Standard_False);
+  aTags.RemoveFirst();
+  for (TColStd_ListOfInteger::Iterator aTagIter(aTags); aTagIter.More() && !aTarget.IsNull();
+       aTagIter.Next())
+  {
+    aTarget = aTarget.FindChild(aTagIter.Value(), Standard_False);
+  }
+  return aTarget;
+}
+
 //=======================================================================
 // function : GetFormat
 // purpose  :
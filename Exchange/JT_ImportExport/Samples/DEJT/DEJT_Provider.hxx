@@ -16,6 +16,10 @@
 #define _DEJT_Provider_HeaderFile
 
 #include <DE_Provider.hxx>
+#include <NCollection_Buffer.hxx>
+#include <TDF_Label.hxx>
+
+class DEJT_MeshSink;
 
 //! The class to transfer JT files.
 //! Reads and Writes any JT files into/from OCCT.
@@ -129,6 +133,63 @@ public:
     const TopoDS_Shape&            theShape,
     const Message_ProgressRange&   theProgress = Message_ProgressRange()) Standard_OVERRIDE;
 
+public:
+  //! Reads JT content from the stream, according internal configuration.
+  //! The content is read into memory and served to the reader without a temporary file.
+  //! @param[in] theStream stream to read from the current position
+  //! @param[in] theName name of the content used in messages (e.g. original file name)
+  //! @param[out] theDocument document to save result
+  //! @param theProgress[in] progress indicator
+  //! @return true if Read operation has ended correctly
+  Standard_EXPORT bool Read(std::istream&                   theStream,
+                            const TCollection_AsciiString&  theName,
+                            const Handle(TDocStd_Document)& theDocument,
+                            const Message_ProgressRange&    theProgress = Message_ProgressRange());
+
+  //! Reads JT content from the memory buffer, according internal configuration.
+  //! The buffer is not copied and should not be modified during reading.
+  //! Late-loaded data kept within the document (see read.keep.late.data)
+  //! cannot be loaded after the call, as the content is released.
+  //! @param[in] theBuffer JT file content
+  //! @param[in] theName name of the content used in messages (e.g. original file name)
+  //! @param[out] theDocument document to save result
+  //! @param theProgress[in] progress indicator
+  //! @return true if Read operation has ended correctly
+  Standard_EXPORT bool Read(const Handle(NCollection_Buffer)& theBuffer,
+                            const TCollection_AsciiString&    theName,
+                            const Handle(TDocStd_Document)&   theDocument,
+                            const Message_ProgressRange&      theProgress = Message_ProgressRange());
+
+  //! Reads meshes of the JT file into the sink, according internal configuration.
+  //! The file is read completely into an intermediate XDE document with triangulations only
+  //! (metadata and PMI are skipped), which is then explored by DEJT_MeshSink::Perform()
+  //! and released after passing the meshes; the read is therefore slower than reading
+  //! the document itself and provides the flat interface only.
+  //! @param[in] thePath path to the import CAD file
+  //! @param[in] theSink sink receiving meshes
+  //! @param theProgress[in] progress indicator
+  //! @return true if Read operation has ended correctly
+  Standard_EXPORT bool Read(const TCollection_AsciiString& thePath,
+                            DEJT_MeshSink&                 theSink,
+                            const Message_ProgressRange&   theProgress = Message_ProgressRange());
+
+public:
+  //! Returns the tag of the first shape label to be created in the document by the next read.
+  //! The reader appends shape labels, so that the labels of the shape tool with the tag
+  //! not less than the returned one are created by the read performed afterwards.
+  //! @param[in] theDocument XDE document
+  Standard_EXPORT static Standard_Integer NextShapeTag(const Handle(TDocStd_Document)& theDocument);
+
+  //! Maps the label of a document, into which the file has been read alone,
+  //! to the label created by reading the same file with the same parameters into the target one.
+  //! @param[in] theSource shape label (or its sub-label) of the separately read document
+  //! @param[in] theTarget target document
+  //! @param[in] theFirstTag value of NextShapeTag() before reading into the target document
+  //! @return null label if the source is not a shape label or the target label does not exist
+  Standard_EXPORT static TDF_Label MapShapeLabel(const TDF_Label&                theSource,
+                                                 const Handle(TDocStd_Document)& theTarget,
+                                                 const Standard_Integer          theFirstTag);
+
 public:
   //! Gets CAD format name of associated provider
   //! @return provider CAD format
@@ -0,0 +1,419 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+#include <DEJT_SegmentCache.hxx>
+
+#include <Message.hxx>
+#include <NCollection_Array1.hxx>
+#include <NCollection_BaseAllocator.hxx>
+#include <NCollection_IncAllocator.hxx>
+#include <NCollection_Map.hxx>
+#include <OSD_Parallel.hxx>
+#include <OSD_ThreadPool.hxx>
+
+#include <atomic>
+
+IMPLEMENT_STANDARD_RTTIEXT(DEJT_SegmentCache, Standard_Transient)
+
+namespace
+{
+//! Size of the header storing the size of the block, keeps the alignment of the base allocator.
+static const size_t THE_BLOCK_HEADER_SIZE = 16;
+
+//! Allocator counting the memory requested from the base allocator and not freed yet.
+//! The size of every block is stored in its header, so that freed blocks are subtracted.
+class DEJT_CountingAllocator : public NCollection_BaseAllocator
+{
+public:
+  //! @param[in] theBaseAllocator allocator providing the memory
+  //! @param[in] theToTrackFrees flag to subtract freed blocks; FALSE for allocators
+  //!                            which keep freed memory until their destruction
+  DEJT_CountingAllocator(const Handle(NCollection_BaseAllocator)& theBaseAllocator,
+                         const bool                               theToTrackFrees)
+      : myBaseAllocator(theBaseAllocator),
+        mySize(0),
+        myToTrackFrees(theToTrackFrees)
+  {
+  }
+
+  virtual void* Allocate(const size_t theSize) Standard_OVERRIDE
+  {
+    char* aBlock = static_cast<char*>(myBaseAllocator->Allocate(theSize + THE_BLOCK_HEADER_SIZE));
+    if (aBlock == NULL)
+    {
+      return NULL;
+    }
+    *reinterpret_cast<size_t*>(aBlock) = theSize;
+    mySize += theSize;
+    return aBlock + THE_BLOCK_HEADER_SIZE;
+  }
+
+  //! Containers request blocks by AllocateOptimal(), which should get the header as well.
+  virtual void* AllocateOptimal(const size_t theSize) Standard_OVERRIDE
+  {
+    return Allocate(theSize);
+  }
+
+  virtual void Free(void* theAddress) Standard_OVERRIDE
+  {
+    if (theAddress == NULL)
+    {
+      return;
+    }
+    char* aBlock = static_cast<char*>(theAddress) - THE_BLOCK_HEADER_SIZE;
+    if (myToTrackFrees)
+    {
+      mySize -= *reinterpret_cast<const size_t*>(aBlock);
+    }
+    myBaseAllocator->Free(aBlock);
+  }
+
+  //! Returns the size of allocated memory which has not been freed.
+  size_t Size() const { return mySize; }
+
+private:
+  Handle(NCollection_BaseAllocator) myBaseAllocator;
+  std::atomic<size_t>               mySize; //!< objects of the segment may be freed by any thread
+  bool                              myToTrackFrees;
+};
+
+//! Functor loading one segment per task.
+class DEJT_SegmentLoadFunctor
+{
+public:
+  DEJT_SegmentLoadFunctor(const NCollection_Array1<Handle(JtProperty_LateLoaded)>& theSegments,
+                          NCollection_Array1<Handle(NCollection_BaseAllocator)>&   theAllocators,
+                          NCollection_Array1<size_t>&                              theSizes,
+                          NCollection_Array1<Standard_Boolean>&                    theStatuses,
+                          const bool                                               theToTrackFrees)
+      : mySegments(theSegments),
+        myAllocators(theAllocators),
+        mySizes(theSizes),
+        myStatuses(theStatuses),
+        myToTrackFrees(theToTrackFrees)
+  {
+  }
+
+  void operator()(int theThreadIndex, int theIndex) const
+  {
+    (void)theThreadIndex;
+    Handle(DEJT_CountingAllocator) anAllocator =
+      new DEJT_CountingAllocator(myAllocators.Value(theIndex), myToTrackFrees);
+    myStatuses.ChangeValue(theIndex) =
+      mySegments.Value(theIndex)->Load(anAllocator, Message_ProgressRange());
+    mySizes.ChangeValue(theIndex) = anAllocator->Size();
+  }
+
+private:
+  const NCollection_Array1<Handle(JtProperty_LateLoaded)>& mySegments;
+  NCollection_Array1<Handle(NCollection_BaseAllocator)>&   myAllocators;
+  NCollection_Array1<size_t>&                              mySizes;
+  NCollection_Array1<Standard_Boolean>&                    myStatuses;
+  bool                                                     myToTrackFrees;
+};
+} // namespace
+
+//=======================================================================
+// function : DEJT_SegmentCache
+// purpose  :
+//=======================================================================
+DEJT_SegmentCache::DEJT_SegmentCache(const size_t theBudget, const size_t theArenaBlockSize)
+    : myBudget(theBudget),
+      myArenaBlockSize(theArenaBlockSize),
+      mySize(0),
+      myNbEvictions(0),
+      myNbHits(0),
+      myNbMisses(0)
+{
+}
+
+//=======================================================================
+// function : ~DEJT_SegmentCache
+// purpose  :
+//=======================================================================
+DEJT_SegmentCache::~DEJT_SegmentCache()
+{
+  Clear();
+}
+
+//=======================================================================
+// function : SetBudget
+// purpose  :
+//=======================================================================
+void DEJT_SegmentCache::SetBudget(const size_t theBudget)
+{
+  myBudget = theBudget;
+  evict();
+}
+
+//=======================================================================
+// function : Load
+// purpose  :
+//=======================================================================
+Handle(JtData_Object) DEJT_SegmentCache::Load(const Handle(JtProperty_LateLoaded)& theSegment,
+                                              const Message_ProgressRange&         theProgress)
+{
+  if (theSegment.IsNull())
+  {
+    return Handle(JtData_Object)();
+  }
+
+  ListOfEntries::iterator anEntryIter;
+  if (mySegments.Find(theSegment, anEntryIter))
+  {
+    ++myNbHits;
+    myEntries.splice(myEntries.begin(), myEntries, anEntryIter);
+    return theSegment->DefferedObject();
+  }
+
+  if (!theSegment->DefferedObject().IsNull())
+  {
+    // the segment has been loaded by its owner, which is responsible for unloading it
+    return theSegment->DefferedObject();
+  }
+
+  ++myNbMisses;
+  purgeRetired();
+  Handle(NCollection_BaseAllocator) anArena     = newAllocator();
+  Handle(DEJT_CountingAllocator)    anAllocator =
+    new DEJT_CountingAllocator(anArena, myArenaBlockSize == 0);
+  if (!theSegment->Load(anAllocator, theProgress))
+  {
+    Message::SendFail() << "Error in the DEJT_SegmentCache: failed to load late-loaded segment";
+    return Handle(JtData_Object)();
+  }
+
+  add(theSegment, anAllocator->Size(), anArena);
+  evict();
+  return theSegment->DefferedObject();
+}
+
+//=======================================================================
+// function : LoadParallel
+// purpose  :
+//=======================================================================
+Standard_Integer DEJT_SegmentCache::LoadParallel(
+  const NCollection_Sequence<Handle(JtProperty_LateLoaded)>& theSegments,
+  const int                                                  theNbThreads)
+{
+  // collect unique segments which are not loaded yet
+  NCollection_Map<Handle(JtProperty_LateLoaded)>      aQueued;
+  NCollection_Sequence<Handle(JtProperty_LateLoaded)> aTasks;
+  for (NCollection_Sequence<Handle(JtProperty_LateLoaded)>::Iterator aSegIter(theSegments);
+       aSegIter.More();
+       aSegIter.Next())
+  {
+    const Handle(JtProperty_LateLoaded)& aSegment = aSegIter.Value();
+    if (aSegment.IsNull())
+    {
+      continue;
+    }
+    ListOfEntries::iterator anEntryIter;
+    if (mySegments.Find(aSegment, anEntryIter))
+    {
+      ++myNbHits;
+      myEntries.splice(myEntries.begin(), myEntries, anEntryIter);
+    }
+    else if (aSegment->DefferedObject().IsNull() && aQueued.Add(aSegment))
+    {
+      // segments loaded by their owners are left to them
+      ++myNbMisses;
+      aTasks.Append(aSegment);
+    }
+  }
+  if (aTasks.IsEmpty())
+  {
+    evict();
+    return 0;
+  }
+
+  NCollection_Array1<Handle(JtProperty_LateLoaded)>     aSegments(0, aTasks.Length() - 1);
+  NCollection_Array1<Handle(NCollection_BaseAllocator)> anAllocators(0, aTasks.Length() - 1);
+  NCollection_Array1<size_t>                            aSizes(0, aTasks.Length() - 1);
+  NCollection_Array1<Standard_Boolean>                  aStatuses(0, aTasks.Length() - 1);
+  Standard_Integer                                      aTaskIndex = 0;
+  for (NCollection_Sequence<Handle(JtProperty_LateLoaded)>::Iterator aTaskIter(aTasks);
+       aTaskIter.More();
+       aTaskIter.Next(), ++aTaskIndex)
+  {
+    aSegments.SetValue(aTaskIndex, aTaskIter.Value());
+    anAllocators.SetValue(aTaskIndex, newAllocator());
+  }
+  aSizes.Init(0);
+  aStatuses.Init(Standard_False);
+
+  const int aNbThreads =
+    Min(theNbThreads > 0 ? theNbThreads : OSD_Parallel::NbLogicalProcessors(), aTasks.Length());
+  if (myThreadPool.IsNull() || myThreadPool->NbThreads() < aNbThreads)
+  {
+    myThreadPool = new OSD_ThreadPool(aNbThreads);
+  }
+  OSD_ThreadPool::Launcher aLauncher(*myThreadPool, aNbThreads);
+  aLauncher.Perform(aSegments.Lower(),
+                    aSegments.Upper() + 1,
+                    DEJT_SegmentLoadFunctor(aSegments,
+                                            anAllocators,
+                                            aSizes,
+                                            aStatuses,
+                                            myArenaBlockSize == 0));
+
+  Standard_Integer aNbFailed = 0;
+  for (Standard_Integer anIndex = aSegments.Lower(); anIndex <= aSegments.Upper(); ++anIndex)
+  {
+    if (aStatuses.Value(anIndex))
+    {
+      add(aSegments.Value(anIndex), aSizes.Value(anIndex), anAllocators.Value(anIndex));
+    }
+    else
+    {
+      ++aNbFailed;
+    }
+  }
+  if (aNbFailed != 0)
+  {
+    Message::SendFail() << "Error in the DEJT_SegmentCache: failed to load " << aNbFailed
+                        << " late-loaded segments";
+  }
+  evict();
+  return aNbFailed;
+}
+
+//=======================================================================
+// function : Unload
+// purpose  :
+//=======================================================================
+void DEJT_SegmentCache::Unload(const Handle(JtProperty_LateLoaded)& theSegment)
+{
+  ListOfEntries::iterator anEntryIter;
+  if (!mySegments.Find(theSegment, anEntryIter))
+  {
+    return;
+  }
+  mySize -= anEntryIter->Size;
+  release(*anEntryIter);
+  mySegments.UnBind(theSegment);
+  myEntries.erase(anEntryIter);
+}
+
+//=======================================================================
+// function : Clear
+// purpose  :
+//=======================================================================
+void DEJT_SegmentCache::Clear()
+{
+  for (ListOfEntries::iterator anEntryIter = myEntries.begin(); anEntryIter != myEntries.end();
+       ++anEntryIter)
+  {
+    release(*anEntryIter);
+  }
+  myEntries.clear();
+  mySegments.Clear();
+  mySize = 0;
+  purgeRetired();
+}
+
+//=======================================================================
+// function : add
+// purpose  :
+//=======================================================================
+void DEJT_SegmentCache::add(const Handle(JtProperty_LateLoaded)&     theSegment,
+                            const size_t                             theSize,
+                            const Handle(NCollection_BaseAllocator)& theArena)
+{
+  Entry anEntry;
+  anEntry.Segment = theSegment;
+  anEntry.Size    = theSize;
+  // the common allocator is not owned by the segment, so that there is nothing to retire
+  if (theArena != NCollection_BaseAllocator::CommonBaseAllocator())
+  {
+    anEntry.Arena = theArena;
+  }
+  myEntries.push_front(anEntry);
+  mySegments.Bind(theSegment, myEntries.begin());
+  mySize += theSize;
+}
+
+//=======================================================================
+// function : newAllocator
+// purpose  :
+//=======================================================================
+Handle(NCollection_BaseAllocator) DEJT_SegmentCache::newAllocator() const
+{
+  if (myArenaBlockSize == 0)
+  {
+    return NCollection_BaseAllocator::CommonBaseAllocator();
+  }
+  return new NCollection_IncAllocator(myArenaBlockSize);
+}
+
+//=======================================================================
+// function : evict
+// purpose  :
+//=======================================================================
+void DEJT_SegmentCache::evict()
+{
+  if (myBudget == 0)
+  {
+    return;
+  }
+  while (mySize > myBudget && myEntries.size() > 1)
+  {
+    const Entry& anEntry = myEntries.back();
+    mySize -= anEntry.Size;
+    release(anEntry);
+    mySegments.UnBind(anEntry.Segment);
+    myEntries.pop_back();
+    ++myNbEvictions;
+  }
+  purgeRetired();
+}
+
+//=======================================================================
+// function : release
+// purpose  :
+//=======================================================================
+void DEJT_SegmentCache::release(const Entry& theEntry)
+{
+  Handle(JtData_Object) anObject = theEntry.Segment->DefferedObject();
+  theEntry.Segment->Unload();
+  if (!theEntry.Arena.IsNull() && !anObject.IsNull() && anObject->GetRefCount() > 1)
+  {
+    // the object is still referenced by the caller, keep its memory until it is released
+    RetiredArena aRetired;
+    aRetired.Object = anObject;
+    aRetired.Arena  = theEntry.Arena;
+    myRetired.push_back(aRetired);
+  }
+}
+
+//=======================================================================
+// function : purgeRetired
+// purpose  :
+//=======================================================================
+void DEJT_SegmentCache::purgeRetired()
+{
+  for (ListOfRetiredArenas::iterator aRetIter = myRetired.begin(); aRetIter != myRetired.end();)
+  {
+    if (aRetIter->Object->GetRefCount() == 1)
+    {
+      // the object is destroyed before its arena
+      aRetIter->Object.Nullify();
+      aRetIter = myRetired.erase(aRetIter);
+    }
+    else
+    {
+      ++aRetIter;
+    }
+  }
+}
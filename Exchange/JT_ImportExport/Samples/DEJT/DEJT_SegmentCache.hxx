@@ -0,0 +1,174 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+#ifndef _DEJT_SegmentCache_HeaderFile
+#define _DEJT_SegmentCache_HeaderFile
+
+#include <JtProperty_LateLoaded.hxx>
+#include <Message_ProgressRange.hxx>
+#include <NCollection_BaseAllocator.hxx>
+#include <NCollection_DataMap.hxx>
+#include <NCollection_Sequence.hxx>
+#include <OSD_ThreadPool.hxx>
+#include <Standard_Transient.hxx>
+
+#include <list>
+
+//! Cache of late-loaded JT segments limited by the memory budget.
+//! Segments are loaded on demand by DEJT_SegmentCache::Load();
+//! when the total size of loaded segments exceeds the budget,
+//! the least recently used segments are released by JtProperty_LateLoaded::Unload().
+//! Released segments are transparently reloaded on the next request.
+//!
+//! The size of a segment is the amount of memory allocated for it
+//! through the allocator passed to JtProperty_LateLoaded::Load()
+//! and not freed by the end of loading.
+//! Segments loaded by other owners are returned as is and never unloaded by the cache.
+//!
+//! Loading a segment creates many small objects; with a non-zero arena block size
+//! every segment is loaded into its own NCollection_IncAllocator, so that its objects
+//! are allocated from a few large blocks, which are released at once when the segment is unloaded.
+//! If the object returned by Load() is still referenced when its segment is unloaded,
+//! the arena is retired and released only after the last handle to the object is gone;
+//! objects nested into the segment data should not outlive the handle to the returned object,
+//! and no handle should outlive the cache itself when arenas are used.
+//! The class is not thread-safe; segments may be loaded concurrently
+//! by DEJT_SegmentCache::LoadParallel().
+class DEJT_SegmentCache : public Standard_Transient
+{
+  DEFINE_STANDARD_RTTIEXT(DEJT_SegmentCache, Standard_Transient)
+public:
+  //! Creates the cache.
+  //! @param[in] theBudget memory budget in bytes; 0 means unlimited cache
+  //! @param[in] theArenaBlockSize block size of the arena of each segment in bytes;
+  //!                              0 means allocating segments from the general heap
+  Standard_EXPORT DEJT_SegmentCache(const size_t theBudget = 0, const size_t theArenaBlockSize = 0);
+
+  //! Releases all loaded segments.
+  Standard_EXPORT virtual ~DEJT_SegmentCache();
+
+  //! Returns memory budget in bytes.
+  size_t Budget() const { return myBudget; }
+
+  //! Sets memory budget in bytes, evicts segments exceeding the new budget.
+  Standard_EXPORT void SetBudget(const size_t theBudget);
+
+  //! Returns block size of the arena of each segment in bytes, 0 if arenas are not used.
+  size_t ArenaBlockSize() const { return myArenaBlockSize; }
+
+  //! Sets block size of the arena of each segment in bytes; 0 disables arenas.
+  //! Applies to segments loaded afterwards.
+  void SetArenaBlockSize(const size_t theBlockSize) { myArenaBlockSize = theBlockSize; }
+
+  //! Returns the total size of loaded segments in bytes.
+  size_t Size() const { return mySize; }
+
+  //! Returns the number of loaded segments.
+  Standard_Integer NbSegments() const { return mySegments.Extent(); }
+
+  //! Returns TRUE if the segment is loaded and managed by this cache.
+  bool Contains(const Handle(JtProperty_LateLoaded)& theSegment) const
+  {
+    return mySegments.IsBound(theSegment);
+  }
+
+  //! Loads the segment, if it is not loaded yet, and marks it as the most recently used.
+  //! Least recently used segments exceeding the budget are unloaded.
+  //! @param[in] theSegment late-loaded property to load
+  //! @param[in] theProgress progress indicator
+  //! @return deferred object of the segment or NULL on failure
+  Standard_EXPORT Handle(JtData_Object) Load(
+    const Handle(JtProperty_LateLoaded)& theSegment,
+    const Message_ProgressRange&         theProgress = Message_ProgressRange());
+
+  //! Loads the segments concurrently and marks them as the most recently used.
+  //! Every segment not loaded yet is an independent task; tasks are distributed
+  //! dynamically over the threads of the private thread pool of the cache,
+  //! so that a thread finishing its segment takes the next one.
+  //! Segments exceeding the budget are unloaded after loading the whole batch.
+  //! @param[in] theSegments late-loaded properties to load
+  //! @param[in] theNbThreads maximum number of threads to use; 0 means all threads of the pool
+  //! @return number of segments failed to load
+  Standard_EXPORT Standard_Integer
+    LoadParallel(const NCollection_Sequence<Handle(JtProperty_LateLoaded)>& theSegments,
+                 const int                                                  theNbThreads = 0);
+
+  //! Unloads the segment and removes it from the cache.
+  Standard_EXPORT void Unload(const Handle(JtProperty_LateLoaded)& theSegment);
+
+  //! Unloads all segments.
+  Standard_EXPORT void Clear();
+
+  //! Returns the number of segments unloaded to fit the budget.
+  Standard_Integer NbEvictions() const { return myNbEvictions; }
+
+  //! Returns the number of requests served without loading.
+  Standard_Integer NbHits() const { return myNbHits; }
+
+  //! Returns the number of requests which required loading.
+  Standard_Integer NbMisses() const { return myNbMisses; }
+
+private:
+  //! Registers the loaded segment as the most recently used one.
+  void add(const Handle(JtProperty_LateLoaded)&     theSegment,
+           const size_t                             theSize,
+           const Handle(NCollection_BaseAllocator)& theArena);
+
+  //! Creates the allocator for loading a segment.
+  Handle(NCollection_BaseAllocator) newAllocator() const;
+
+  //! Unloads least recently used segments until the size fits the budget.
+  //! The most recently used segment is always kept.
+  void evict();
+
+private:
+  //! Loaded segment.
+  struct Entry
+  {
+    Handle(JtProperty_LateLoaded)     Segment; //!< late-loaded property
+    size_t                            Size;    //!< memory allocated for the segment
+    Handle(NCollection_BaseAllocator) Arena;   //!< private arena, NULL without arenas
+  };
+
+  //! Arena of an unloaded segment whose object is still referenced outside of the cache.
+  struct RetiredArena
+  {
+    Handle(JtData_Object)             Object; //!< object of the unloaded segment
+    Handle(NCollection_BaseAllocator) Arena;  //!< allocator owning the object memory
+  };
+
+  typedef std::list<Entry>        ListOfEntries;
+  typedef std::list<RetiredArena> ListOfRetiredArenas;
+
+  //! Unloads the segment of the entry; retires its arena while the object is referenced.
+  void release(const Entry& theEntry);
+
+  //! Releases retired arenas whose objects are not referenced anymore.
+  void purgeRetired();
+
+private:
+  ListOfEntries          myEntries;    //!< segments from the most to the least recently used
+  ListOfRetiredArenas    myRetired;    //!< arenas kept until their objects are released
+  Handle(OSD_ThreadPool) myThreadPool; //!< pool loading segments in parallel, created on demand
+  NCollection_DataMap<Handle(JtProperty_LateLoaded), ListOfEntries::iterator>
+                   mySegments;       //!< map of loaded segments to their entries
+  size_t           myBudget;         //!< memory budget in bytes
+  size_t           myArenaBlockSize; //!< block size of segment arenas, 0 - general heap
+  size_t           mySize;           //!< total size of loaded segments
+  Standard_Integer myNbEvictions;    //!< number of evicted segments
+  Standard_Integer myNbHits;         //!< number of cache hits
+  Standard_Integer myNbMisses;       //!< number of cache misses
+};
+
+#endif // _DEJT_SegmentCache_HeaderFile
@@ -0,0 +1,365 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#include <DEJT_SegmentIndex.hxx>
+
+#include <BVH_BinnedBuilder.hxx>
+#include <JtNode_Group.hxx>
+#include <JtNode_Instance.hxx>
+#include <JtNode_Shape_Base.hxx>
+#include <NCollection_Map.hxx>
+
+IMPLEMENT_STANDARD_RTTIEXT(DEJT_SegmentIndex, BVH_PrimitiveSet3d)
+
+namespace
+{
+//! Predicate rejecting boxes not intersecting the clipping box.
+struct DEJT_BoxPredicate
+{
+  BVH_Vec3d Min; //!< minimum corner of the clipping box
+  BVH_Vec3d Max; //!< maximum corner of the clipping box
+
+  bool IsOut(const BVH_Vec3d& theMin, const BVH_Vec3d& theMax) const
+  {
+    return theMin.x() > Max.x() || theMax.x() < Min.x() || theMin.y() > Max.y()
+           || theMax.y() < Min.y() || theMin.z() > Max.z() || theMax.z() < Min.z();
+  }
+};
+
+//! Predicate rejecting boxes entirely behind one of the planes.
+struct DEJT_PlanesPredicate
+{
+  NCollection_Vector<NCollection_Vec4<Standard_Real>> Planes; //!< plane equations
+
+  bool IsOut(const BVH_Vec3d& theMin, const BVH_Vec3d& theMax) const
+  {
+    for (NCollection_Vector<NCollection_Vec4<Standard_Real>>::Iterator aPlaneIter(Planes);
+         aPlaneIter.More();
+         aPlaneIter.Next())
+    {
+      const NCollection_Vec4<Standard_Real>& aPlane = aPlaneIter.Value();
+      // the box corner farthest along the plane normal
+      const Standard_Real aDist = aPlane.x() * (aPlane.x() >= 0.0 ? theMax.x() : theMin.x())
+                                  + aPlane.y() * (aPlane.y() >= 0.0 ? theMax.y() : theMin.y())
+                                  + aPlane.z() * (aPlane.z() >= 0.0 ? theMax.z() : theMin.z())
+                                  + aPlane.w();
+      if (aDist < 0.0)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+//! Returns the transformed bounding box stored in the shape or partition node,
+//! void if the node has no bounds.
+static Bnd_Box nodeBox(const Handle(JtData_Object)& theNode)
+{
+  Bnd_Box aBox;
+  if (Handle(JtNode_Shape_Base) aShape = Handle(JtNode_Shape_Base)::DownCast(theNode))
+  {
+    const Jt_BBoxF32& aBounds = aShape->Bounds();
+    aBox.Update(aBounds.MinCorner.X, aBounds.MinCorner.Y, aBounds.MinCorner.Z,
+                aBounds.MaxCorner.X, aBounds.MaxCorner.Y, aBounds.MaxCorner.Z);
+  }
+  else if (Handle(JtNode_Partition) aPartition = Handle(JtNode_Partition)::DownCast(theNode))
+  {
+    const Jt_BBoxF32& aBounds = aPartition->Bounds();
+    aBox.Update(aBounds.MinCorner.X, aBounds.MinCorner.Y, aBounds.MinCorner.Z,
+                aBounds.MaxCorner.X, aBounds.MaxCorner.Y, aBounds.MaxCorner.Z);
+  }
+  // the bounds of an empty node are stored with the minimum corner above the maximum one
+  Standard_Real aXmin, aYmin, aZmin, aXmax, aYmax, aZmax;
+  if (!aBox.IsVoid())
+  {
+    aBox.Get(aXmin, aYmin, aZmin, aXmax, aYmax, aZmax);
+  }
+  if (aBox.IsVoid() || aXmin > aXmax || aYmin > aYmax || aZmin > aZmax)
+  {
+    return Bnd_Box();
+  }
+  return aBox;
+}
+
+//! Registers segments of the node and its children.
+static void addNode(DEJT_SegmentIndex&                      theIndex,
+                    const Handle(JtData_Object)&            theNode,
+                    const Bnd_Box&                          theParentBox,
+                    NCollection_Map<Handle(JtData_Object)>& theVisited)
+{
+  if (theNode.IsNull() || !theVisited.Add(theNode))
+  {
+    return;
+  }
+  if (Handle(JtNode_Instance) anInstance = Handle(JtNode_Instance)::DownCast(theNode))
+  {
+    addNode(theIndex, anInstance->Object(), theParentBox, theVisited);
+    return;
+  }
+
+  Bnd_Box aBox = nodeBox(theNode);
+  if (aBox.IsVoid())
+  {
+    aBox = theParentBox;
+  }
+  if (Handle(JtNode_Shape_Base) aShape = Handle(JtNode_Shape_Base)::DownCast(theNode))
+  {
+    const JtData_Array<Handle(JtProperty_LateLoaded)>* aLateLoads = aShape->LateLoads();
+    if (aLateLoads != NULL)
+    {
+      for (size_t aSegIter = 0; aSegIter < aLateLoads->size(); ++aSegIter)
+      {
+        theIndex.Add((*aLateLoads)[aSegIter], aBox);
+      }
+    }
+    return;
+  }
+  if (Handle(JtNode_Group) aGroup = Handle(JtNode_Group)::DownCast(theNode))
+  {
+    // the box of a partition is inherited by its content, other groups pass the parent box
+    for (size_t aChildIter = 0; aChildIter < aGroup->Children().size(); ++aChildIter)
+    {
+      addNode(theIndex, aGroup->Children()[aChildIter], aBox, theVisited);
+    }
+  }
+}
+} // namespace
+
+//=======================================================================
+// function : DEJT_SegmentIndex
+// purpose  :
+//=======================================================================
+DEJT_SegmentIndex::DEJT_SegmentIndex()
+    : BVH_PrimitiveSet3d(new BVH_BinnedBuilder<Standard_Real, 3>(BVH_Constants_LeafNodeSizeAverage,
+                                                                 BVH_Constants_MaxTreeDepth))
+{
+}
+
+//=======================================================================
+// function : Add
+// purpose  :
+//=======================================================================
+void DEJT_SegmentIndex::Add(const Handle(JtProperty_LateLoaded)& theSegment,
+                            const Bnd_Box&                       theBox)
+{
+  if (theSegment.IsNull() || theBox.IsVoid())
+  {
+    return;
+  }
+  Standard_Real aXmin, aYmin, aZmin, aXmax, aYmax, aZmax;
+  theBox.Get(aXmin, aYmin, aZmin, aXmax, aYmax, aZmax);
+  mySegments.Append(theSegment);
+  myBoxes.Append(
+    BVH_Box<Standard_Real, 3>(BVH_Vec3d(aXmin, aYmin, aZmin), BVH_Vec3d(aXmax, aYmax, aZmax)));
+  MarkDirty();
+}
+
+//=======================================================================
+// function : Perform
+// purpose  :
+//=======================================================================
+Standard_Integer DEJT_SegmentIndex::Perform(const Handle(JtNode_Partition)& theRoot)
+{
+  const Standard_Integer                 aNbBefore = Size();
+  NCollection_Map<Handle(JtData_Object)> aVisited;
+  addNode(*this, theRoot, Bnd_Box(), aVisited);
+  return Size() - aNbBefore;
+}
+
+//=======================================================================
+// function : Clear
+// purpose  :
+//=======================================================================
+void DEJT_SegmentIndex::Clear()
+{
+  mySegments.Clear();
+  myBoxes.Clear();
+  MarkDirty();
+}
+
+//=======================================================================
+// function : Size
+// purpose  :
+//=======================================================================
+Standard_Integer DEJT_SegmentIndex::Size() const
+{
+  return mySegments.Length();
+}
+
+//=======================================================================
+// function : Box
+// purpose  :
+//=======================================================================
+BVH_Box<Standard_Real, 3> DEJT_SegmentIndex::Box(const Standard_Integer theIndex) const
+{
+  return myBoxes.Value(theIndex);
+}
+
+//=======================================================================
+// function : Center
+// purpose  :
+//=======================================================================
+Standard_Real DEJT_SegmentIndex::Center(const Standard_Integer theIndex,
+                                        const Standard_Integer theAxis) const
+{
+  const BVH_Box<Standard_Real, 3>& aBox = myBoxes.Value(theIndex);
+  return (aBox.CornerMin()[theAxis] + aBox.CornerMax()[theAxis]) * 0.5;
+}
+
+//=======================================================================
+// function : Swap
+// purpose  :
+//=======================================================================
+void DEJT_SegmentIndex::Swap(const Standard_Integer theIndex1, const Standard_Integer theIndex2)
+{
+  std::swap(mySegments.ChangeValue(theIndex1), mySegments.ChangeValue(theIndex2));
+  std::swap(myBoxes.ChangeValue(theIndex1), myBoxes.ChangeValue(theIndex2));
+}
+
+//=======================================================================
+// function : select
+// purpose  :
+//=======================================================================
+template <typename ThePredicate>
+Standard_Integer DEJT_SegmentIndex::select(
+  const ThePredicate&                                  thePredicate,
+  NCollection_Sequence<Handle(JtProperty_LateLoaded)>& theSegments)
+{
+  if (mySegments.IsEmpty())
+  {
+    return 0;
+  }
+  const opencascade::handle<BVH_Tree<Standard_Real, 3>>& aBVH = BVH();
+  if (aBVH.IsNull() || aBVH->Length() == 0)
+  {
+    return 0;
+  }
+
+  Standard_Integer aNbFound = 0;
+  Standard_Integer aStack[BVH_Constants_MaxTreeDepth + 1];
+  Standard_Integer aHead = -1;
+  Standard_Integer aNode = 0;
+  for (;;)
+  {
+    if (!thePredicate.IsOut(aBVH->MinPoint(aNode), aBVH->MaxPoint(aNode)))
+    {
+      if (!aBVH->IsOuter(aNode))
+      {
+        aStack[++aHead] = aBVH->template Child<1>(aNode);
+        aNode           = aBVH->template Child<0>(aNode);
+        continue;
+      }
+      for (Standard_Integer anIndex = aBVH->BegPrimitive(aNode);
+           anIndex <= aBVH->EndPrimitive(aNode);
+           ++anIndex)
+      {
+        const BVH_Box<Standard_Real, 3>& aBox = myBoxes.Value(anIndex);
+        if (!thePredicate.IsOut(aBox.CornerMin(), aBox.CornerMax()))
+        {
+          theSegments.Append(mySegments.Value(anIndex));
+          ++aNbFound;
+        }
+      }
+    }
+    if (aHead < 0)
+    {
+      break;
+    }
+    aNode = aStack[aHead--];
+  }
+  return aNbFound;
+}
+
+//=======================================================================
+// function : Select
+// purpose  :
+//=======================================================================
+Standard_Integer DEJT_SegmentIndex::Select(
+  const Bnd_Box&                                       theBox,
+  NCollection_Sequence<Handle(JtProperty_LateLoaded)>& theSegments)
+{
+  if (theBox.IsVoid())
+  {
+    return 0;
+  }
+  Standard_Real aXmin, aYmin, aZmin, aXmax, aYmax, aZmax;
+  theBox.Get(aXmin, aYmin, aZmin, aXmax, aYmax, aZmax);
+  DEJT_BoxPredicate aPredicate;
+  aPredicate.Min = BVH_Vec3d(aXmin, aYmin, aZmin);
+  aPredicate.Max = BVH_Vec3d(aXmax, aYmax, aZmax);
+  return select(aPredicate, theSegments);
+}
+
+//=======================================================================
+// function : Select
+// purpose  :
+//=======================================================================
+Standard_Integer DEJT_SegmentIndex::Select(
+  const NCollection_Array1<gp_Pln>&                    thePlanes,
+  NCollection_Sequence<Handle(JtProperty_LateLoaded)>& theSegments)
+{
+  DEJT_PlanesPredicate aPredicate;
+  for (NCollection_Array1<gp_Pln>::Iterator aPlaneIter(thePlanes); aPlaneIter.More();
+       aPlaneIter.Next())
+  {
+    Standard_Real aA, aB, aC, aD;
+    aPlaneIter.Value().Coefficients(aA, aB, aC, aD);
+    aPredicate.Planes.Append(NCollection_Vec4<Standard_Real>(aA, aB, aC, aD));
+  }
+  return select(aPredicate, theSegments);
+}
+
+//=======================================================================
+// function : Select
+// purpose  :
+//=======================================================================
+Standard_Integer DEJT_SegmentIndex::Select(
+  const Handle(Graphic3d_Camera)&                      theCamera,
+  NCollection_Sequence<Handle(JtProperty_LateLoaded)>& theSegments)
+{
+  if (theCamera.IsNull())
+  {
+    return 0;
+  }
+  NCollection_Array1<gp_Pln> aPlanes(1, 6);
+  FrustumPlanes(theCamera, aPlanes);
+  return Select(aPlanes, theSegments);
+}
+
+//=======================================================================
+// function : FrustumPlanes
+// purpose  :
+//=======================================================================
+void DEJT_SegmentIndex::FrustumPlanes(const Handle(Graphic3d_Camera)& theCamera,
+                                      NCollection_Array1<gp_Pln>&     thePlanes)
+{
+  // planes are extracted from the rows of the combined projection and view matrix
+  const Graphic3d_Mat4d aClipMat = theCamera->ProjectionMatrix() * theCamera->OrientationMatrix();
+  const NCollection_Vec4<Standard_Real> aRowX = aClipMat.GetRow(0);
+  const NCollection_Vec4<Standard_Real> aRowY = aClipMat.GetRow(1);
+  const NCollection_Vec4<Standard_Real> aRowZ = aClipMat.GetRow(2);
+  const NCollection_Vec4<Standard_Real> aRowW = aClipMat.GetRow(3);
+  const NCollection_Vec4<Standard_Real> anEquations[6] =
+    {aRowW + aRowX, aRowW - aRowX, aRowW + aRowY, aRowW - aRowY, aRowW + aRowZ, aRowW - aRowZ};
+  Standard_Integer aPlaneIndex = thePlanes.Lower();
+  for (Standard_Integer anEqIter = 0; anEqIter < 6 && aPlaneIndex <= thePlanes.Upper();
+       ++anEqIter, ++aPlaneIndex)
+  {
+    const NCollection_Vec4<Standard_Real>& anEq = anEquations[anEqIter];
+    // gp_Pln normalizes the coefficients
+    thePlanes.SetValue(aPlaneIndex, gp_Pln(anEq.x(), anEq.y(), anEq.z(), anEq.w()));
+  }
+}
@@ -0,0 +1,133 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+
+#ifndef _DEJT_SegmentIndex_HeaderFile
+#define _DEJT_SegmentIndex_HeaderFile
+
+#include <Bnd_Box.hxx>
+#include <BVH_PrimitiveSet3d.hxx>
+#include <gp_Pln.hxx>
+#include <Graphic3d_Camera.hxx>
+#include <JtNode_Partition.hxx>
+#include <JtProperty_LateLoaded.hxx>
+#include <NCollection_Array1.hxx>
+#include <NCollection_Sequence.hxx>
+#include <NCollection_Vector.hxx>
+
+//! Spatial index of late-loaded JT segments.
+//! Every segment is registered with the bounding box of its node taken from the LSG
+//! (the bounds of the shape node owning the late-loaded property or of its partition);
+//! the boxes are organized into a bounding volume hierarchy, so that segments
+//! intersecting a clipping box or a camera frustum are found without iterating all of them.
+//! The found segments can be scheduled for loading, e.g. by DEJT_SegmentCache::LoadParallel():
+//! @code
+//!   Handle(JtData_Model) aModel = new JtData_Model (aRootFilePath);
+//!   Handle(DEJT_SegmentIndex) anIndex = new DEJT_SegmentIndex();
+//!   anIndex->Perform (aModel->Init (anAllocator, aProgress));
+//!   NCollection_Sequence<Handle(JtProperty_LateLoaded)> aSegments;
+//!   anIndex->Select (aView->Camera(), aSegments);
+//!   aCache->LoadParallel (aSegments);
+//! @endcode
+class DEJT_SegmentIndex : public BVH_PrimitiveSet3d
+{
+  DEFINE_STANDARD_RTTIEXT(DEJT_SegmentIndex, BVH_PrimitiveSet3d)
+public:
+  //! Creates an empty index.
+  Standard_EXPORT DEJT_SegmentIndex();
+
+  //! Registers the segment with the bounding box of its node in world coordinates.
+  //! Segments with void boxes are ignored.
+  Standard_EXPORT void Add(const Handle(JtProperty_LateLoaded)& theSegment, const Bnd_Box& theBox);
+
+  //! Registers the late-loaded segments of the shape nodes of the scene graph.
+  //! The scene graph is traversed from the root partition through the children of group nodes
+  //! and the objects of instance nodes, as by DEJT_PartitionPrefetcher::CollectReferences();
+  //! partition nodes are entered as well, as their content is resolved by JtData_Model::Init().
+  //! Every segment is registered with the transformed bounding box of its shape node;
+  //! shape nodes without bounds take the box of the closest enclosing partition.
+  //! Shape nodes shared by several instances are registered once.
+  //! The model should be kept alive while the index is used.
+  //! @param[in] theRoot root partition returned by JtData_Model::Init()
+  //! @return number of registered segments
+  Standard_EXPORT Standard_Integer Perform(const Handle(JtNode_Partition)& theRoot);
+
+  //! Removes all segments.
+  Standard_EXPORT void Clear();
+
+  //! Returns the segment with the given index.
+  const Handle(JtProperty_LateLoaded)& Segment(const Standard_Integer theIndex) const
+  {
+    return mySegments.Value(theIndex);
+  }
+
+  //! Appends segments which boxes intersect the box.
+  //! @param[in] theBox clipping box in world coordinates
+  //! @param[out] theSegments found segments
+  //! @return number of found segments
+  Standard_EXPORT Standard_Integer
+    Select(const Bnd_Box&                                       theBox,
+           NCollection_Sequence<Handle(JtProperty_LateLoaded)>& theSegments);
+
+  //! Appends segments which boxes are not entirely behind any of the planes.
+  //! @param[in] thePlanes planes bounding the convex volume, normals are directed inside
+  //! @param[out] theSegments found segments
+  //! @return number of found segments
+  Standard_EXPORT Standard_Integer
+    Select(const NCollection_Array1<gp_Pln>&                    thePlanes,
+           NCollection_Sequence<Handle(JtProperty_LateLoaded)>& theSegments);
+
+  //! Appends segments which boxes intersect the view frustum of the camera.
+  //! @param[in] theCamera camera defining the frustum
+  //! @param[out] theSegments found segments
+  //! @return number of found segments
+  Standard_EXPORT Standard_Integer
+    Select(const Handle(Graphic3d_Camera)&                      theCamera,
+           NCollection_Sequence<Handle(JtProperty_LateLoaded)>& theSegments);
+
+  //! Computes the planes of the view frustum of the camera with normals directed inside.
+  //! @param[in] theCamera camera defining the frustum
+  //! @param[out] thePlanes left, right, bottom, top, near and far planes
+  Standard_EXPORT static void FrustumPlanes(const Handle(Graphic3d_Camera)& theCamera,
+                                            NCollection_Array1<gp_Pln>&     thePlanes);
+
+public:
+  //! Returns the number of segments.
+  Standard_EXPORT virtual Standard_Integer Size() const Standard_OVERRIDE;
+
+  //! Returns the bounding box of the segment.
+  Standard_EXPORT virtual BVH_Box<Standard_Real, 3> Box(const Standard_Integer theIndex) const
+    Standard_OVERRIDE;
+
+  //! Returns the center of the segment box along the axis.
+  Standard_EXPORT virtual Standard_Real Center(const Standard_Integer theIndex,
+                                               const Standard_Integer theAxis) const
+    Standard_OVERRIDE;
+
+  //! Swaps two segments.
+  Standard_EXPORT virtual void Swap(const Standard_Integer theIndex1,
+                                    const Standard_Integer theIndex2) Standard_OVERRIDE;
+
+private:
+  //! Traverses the hierarchy and appends segments which boxes are accepted by the predicate.
+  template <typename ThePredicate>
+  Standard_Integer select(const ThePredicate&                                  thePredicate,
+                          NCollection_Sequence<Handle(JtProperty_LateLoaded)>& theSegments);
+
+private:
+  NCollection_Vector<Handle(JtProperty_LateLoaded)> mySegments; //!< registered segments
+  NCollection_Vector<BVH_Box<Standard_Real, 3>>     myBoxes;    //!< boxes of segments
+};
+
+#endif // _DEJT_SegmentIndex_HeaderFile
@@ -0,0 +1,237 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+#include <DEJT_TriangulationDeduplicator.hxx>
+
+#include <BRep_TFace.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+
+#include <cstring>
+
+namespace
+{
+//! Raw storage of the mesh array.
+struct DEJT_MeshArray
+{
+  const Standard_Byte* Data; //!< first element
+  size_t               Size; //!< size in bytes
+
+  DEJT_MeshArray()
+      : Data(NULL),
+        Size(0)
+  {
+  }
+
+  //! Initializes from the aliased array (nodes, UV nodes).
+  template <int theAlignment>
+  DEJT_MeshArray(const NCollection_AliasedArray<theAlignment>& theArray)
+      : Data(theArray.IsEmpty() ? NULL : &theArray.template Value<Standard_Byte>(0)),
+        Size(size_t(theArray.Size()) * size_t(theArray.Stride()))
+  {
+  }
+
+  //! Initializes from the plain array (triangles, normals).
+  template <typename T>
+  DEJT_MeshArray(const NCollection_Array1<T>& theArray)
+      : Data(theArray.IsEmpty() ? NULL : (const Standard_Byte*)&theArray.First()),
+        Size(size_t(theArray.Length()) * sizeof(T))
+  {
+  }
+
+  //! Returns TRUE if arrays are bit-identical.
+  bool IsSame(const DEJT_MeshArray& theOther) const
+  {
+    return Size == theOther.Size && (Size == 0 || memcmp(Data, theOther.Data, Size) == 0);
+  }
+};
+
+//! Appends the array to the 64-bit hash.
+//! Data is processed by 8-byte words in 4 independent lanes of FNV-1a style mixing.
+static void hashArray(uint64_t& theHash, const DEJT_MeshArray& theArray)
+{
+  const uint64_t aPrime    = 1099511628211ULL;
+  uint64_t       aLanes[4] = {theHash, theHash ^ 0x9e3779b97f4a7c15ULL,
+                              theHash ^ 0xc2b2ae3d27d4eb4fULL, theHash ^ 0x165667b19e3779f9ULL};
+  size_t         anOffset  = 0;
+  for (; anOffset + 4 * sizeof(uint64_t) <= theArray.Size; anOffset += 4 * sizeof(uint64_t))
+  {
+    for (int aLaneIter = 0; aLaneIter < 4; ++aLaneIter)
+    {
+      uint64_t aWord = 0;
+      memcpy(&aWord, theArray.Data + anOffset + aLaneIter * sizeof(uint64_t), sizeof(uint64_t));
+      aLanes[aLaneIter] = (aLanes[aLaneIter] ^ aWord) * aPrime;
+    }
+  }
+
+  theHash = aLanes[0];
+  for (int aLaneIter = 1; aLaneIter < 4; ++aLaneIter)
+  {
+    theHash = (theHash ^ (aLanes[aLaneIter] >> 29) ^ aLanes[aLaneIter]) * aPrime;
+  }
+  for (; anOffset < theArray.Size; ++anOffset)
+  {
+    theHash = (theHash ^ theArray.Data[anOffset]) * aPrime;
+  }
+  theHash = (theHash ^ (uint64_t)theArray.Size) * aPrime;
+}
+} // namespace
+
+//=======================================================================
+// function : DEJT_TriangulationDeduplicator
+// purpose  :
+//=======================================================================
+DEJT_TriangulationDeduplicator::DEJT_TriangulationDeduplicator()
+    : myNbTriangulations(0),
+      myNbUnique(0)
+{
+}
+
+//=======================================================================
+// function : HashCode
+// purpose  :
+//=======================================================================
+size_t DEJT_TriangulationDeduplicator::HashCode(const Handle(Poly_Triangulation)& theTriangulation)
+{
+  // nodes and triangles identify the mesh well enough, other attributes are compared by IsEqual()
+  uint64_t aHash = 14695981039346656037ULL;
+  hashArray(aHash, DEJT_MeshArray(theTriangulation->InternalNodes()));
+  hashArray(aHash, DEJT_MeshArray(theTriangulation->InternalTriangles()));
+  // finalizer of MurmurHash3 spreads the word-wise mixing over all bits of the result
+  aHash ^= aHash >> 33;
+  aHash *= 0xff51afd7ed558ccdULL;
+  aHash ^= aHash >> 33;
+  aHash *= 0xc4ceb9fe1a85ec53ULL;
+  aHash ^= aHash >> 33;
+  return (size_t)aHash;
+}
+
+//=======================================================================
+// function : IsEqual
+// purpose  :
+//=======================================================================
+bool DEJT_TriangulationDeduplicator::IsEqual(const Handle(Poly_Triangulation)& theTriangulation1,
+                                             const Handle(Poly_Triangulation)& theTriangulation2)
+{
+  // arrays are compared as whole memory blocks, consistently with HashCode();
+  // nodes of different precision are never equal
+  const Standard_Real aDeflection1 = theTriangulation1->Deflection();
+  const Standard_Real aDeflection2 = theTriangulation2->Deflection();
+  return memcmp(&aDeflection1, &aDeflection2, sizeof(Standard_Real)) == 0
+         && theTriangulation1->HasNormals() == theTriangulation2->HasNormals()
+         && theTriangulation1->HasUVNodes() == theTriangulation2->HasUVNodes()
+         && DEJT_MeshArray(theTriangulation1->InternalTriangles())
+              .IsSame(DEJT_MeshArray(theTriangulation2->InternalTriangles()))
+         && DEJT_MeshArray(theTriangulation1->InternalNodes())
+              .IsSame(DEJT_MeshArray(theTriangulation2->InternalNodes()))
+         && (!theTriangulation1->HasNormals()
+             || DEJT_MeshArray(theTriangulation1->InternalNormals())
+                  .IsSame(DEJT_MeshArray(theTriangulation2->InternalNormals())))
+         && (!theTriangulation1->HasUVNodes()
+             || DEJT_MeshArray(theTriangulation1->InternalUVNodes())
+                  .IsSame(DEJT_MeshArray(theTriangulation2->InternalUVNodes())));
+}
+
+//=======================================================================
+// function : share
+// purpose  :
+//=======================================================================
+const Handle(Poly_Triangulation)& DEJT_TriangulationDeduplicator::share(
+  const Handle(Poly_Triangulation)& theTriangulation)
+{
+  if (const Handle(Poly_Triangulation)* aShared = myShared.Seek(theTriangulation))
+  {
+    return *aShared;
+  }
+
+  ++myNbTriangulations;
+  const size_t                                aHash = HashCode(theTriangulation);
+  NCollection_List<Handle(Poly_Triangulation)>* aBucket = myUnique.ChangeSeek(aHash);
+  if (aBucket == NULL)
+  {
+    aBucket = myUnique.Bound(aHash, NCollection_List<Handle(Poly_Triangulation)>());
+  }
+  for (NCollection_List<Handle(Poly_Triangulation)>::Iterator anIter(*aBucket); anIter.More();
+       anIter.Next())
+  {
+    if (IsEqual(anIter.Value(), theTriangulation))
+    {
+      return *myShared.Bound(theTriangulation, anIter.Value());
+    }
+  }
+
+  ++myNbUnique;
+  aBucket->Append(theTriangulation);
+  return *myShared.Bound(theTriangulation, theTriangulation);
+}
+
+//=======================================================================
+// function : Perform
+// purpose  :
+//=======================================================================
+void DEJT_TriangulationDeduplicator::Perform(const TopoDS_Shape& theShape)
+{
+  for (TopExp_Explorer aFaceIter(theShape, TopAbs_FACE); aFaceIter.More(); aFaceIter.Next())
+  {
+    Handle(BRep_TFace) aTFace = Handle(BRep_TFace)::DownCast(aFaceIter.Current().TShape());
+    if (aTFace.IsNull() || aTFace->Triangulations().IsEmpty())
+    {
+      continue;
+    }
+
+    // faces may keep several LODs, the active one is preserved
+    bool                       isChanged = false;
+    Poly_ListOfTriangulation   aTriangulations;
+    Handle(Poly_Triangulation) anActive;
+    for (Poly_ListOfTriangulation::Iterator aTriIter(aTFace->Triangulations()); aTriIter.More();
+         aTriIter.Next())
+    {
+      const Handle(Poly_Triangulation)& aTriangulation = aTriIter.Value();
+      // triangulations with deferred data are not loaded and cannot be compared
+      const Handle(Poly_Triangulation)& aShared =
+        !aTriangulation.IsNull() && aTriangulation->NbNodes() > 0 ? share(aTriangulation)
+                                                                  : aTriangulation;
+      isChanged = isChanged || aShared != aTriangulation;
+      aTriangulations.Append(aShared);
+      if (aTriangulation == aTFace->ActiveTriangulation())
+      {
+        anActive = aShared;
+      }
+    }
+    if (isChanged)
+    {
+      aTFace->Triangulations(aTriangulations, anActive);
+    }
+  }
+}
+
+//=======================================================================
+// function : Perform
+// purpose  :
+//=======================================================================
+void DEJT_TriangulationDeduplicator::Perform(const Handle(TDocStd_Document)& theDocument)
+{
+  Handle(XCAFDoc_ShapeTool) aShapeTool = XCAFDoc_DocumentTool::ShapeTool(theDocument->Main());
+  TDF_LabelSequence         aLabels;
+  aShapeTool->GetShapes(aLabels);
+  for (TDF_LabelSequence::Iterator aLabelIter(aLabels); aLabelIter.More(); aLabelIter.Next())
+  {
+    if (XCAFDoc_ShapeTool::IsSimpleShape(aLabelIter.Value()))
+    {
+      Perform(XCAFDoc_ShapeTool::GetShape(aLabelIter.Value()));
+    }
+  }
+}
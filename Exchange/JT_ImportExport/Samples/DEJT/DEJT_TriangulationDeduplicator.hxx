@@ -0,0 +1,82 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+#ifndef _DEJT_TriangulationDeduplicator_HeaderFile
+#define _DEJT_TriangulationDeduplicator_HeaderFile
+
+#include <NCollection_DataMap.hxx>
+#include <NCollection_List.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TDocStd_Document.hxx>
+#include <TopoDS_Shape.hxx>
+
+//! Tool sharing bit-identical triangulations between faces.
+//! JT files often define the same mesh for many parts (fasteners, standard parts)
+//! without instancing; after reading, each copy is a separate Poly_Triangulation.
+//! The tool finds triangulations with identical nodes, triangles, normals and UV nodes
+//! (by content hash, confirmed by exact comparison) and makes faces refer to one of them.
+//! Triangulations are compared in local coordinates of the faces,
+//! so that meshes placed with different locations are shared as well.
+//!
+//! Floating point arrays are compared by their bit patterns (memcmp), not by value:
+//! coordinates equal to -0.0 and 0.0 are considered different, and NaN values
+//! are considered equal only with the same payload. This never shares meshes which
+//! render differently, but may keep numerically equal meshes unshared.
+class DEJT_TriangulationDeduplicator
+{
+public:
+  //! Empty constructor.
+  Standard_EXPORT DEJT_TriangulationDeduplicator();
+
+  //! Shares identical triangulations of all shapes of the document.
+  Standard_EXPORT void Perform(const Handle(TDocStd_Document)& theDocument);
+
+  //! Shares identical triangulations of the faces of the shape.
+  //! Might be called several times to share triangulations between shapes.
+  Standard_EXPORT void Perform(const TopoDS_Shape& theShape);
+
+  //! Returns the number of distinct triangulations met.
+  Standard_Integer NbTriangulations() const { return myNbTriangulations; }
+
+  //! Returns the number of triangulations left after sharing.
+  Standard_Integer NbUnique() const { return myNbUnique; }
+
+  //! Returns the ratio of met triangulations to unique ones (1.0 means nothing is shared).
+  Standard_Real Ratio() const
+  {
+    return myNbUnique != 0 ? Standard_Real(myNbTriangulations) / Standard_Real(myNbUnique) : 1.0;
+  }
+
+  //! Computes the hash of the bit patterns of the nodes and triangles.
+  Standard_EXPORT static size_t HashCode(const Handle(Poly_Triangulation)& theTriangulation);
+
+  //! Returns TRUE if triangulations have bit-identical content;
+  //! floating point values are compared by their bit patterns, e.g. -0.0 differs from 0.0.
+  Standard_EXPORT static bool IsEqual(const Handle(Poly_Triangulation)& theTriangulation1,
+                                      const Handle(Poly_Triangulation)& theTriangulation2);
+
+private:
+  //! Returns the shared triangulation with the same content.
+  const Handle(Poly_Triangulation)& share(const Handle(Poly_Triangulation)& theTriangulation);
+
+private:
+  //! map of met triangulations to the shared ones
+  NCollection_DataMap<Handle(Poly_Triangulation), Handle(Poly_Triangulation)> myShared;
+  //! unique triangulations by content hash
+  NCollection_DataMap<size_t, NCollection_List<Handle(Poly_Triangulation)>> myUnique;
+  Standard_Integer myNbTriangulations; //!< number of met triangulations
+  Standard_Integer myNbUnique;         //!< number of unique triangulations
+};
+
+#endif // _DEJT_TriangulationDeduplicator_HeaderFile
@@ -13,6 +13,7 @@
 // OTHER LIABILITIES.
 
 #include <XSDRAWJT.hxx>
+#include <XSDRAWJT_Test.hxx>
 
 #include <BinDrivers.hxx>
 #include <BinLDrivers.hxx>
@@ -26,21 +27,36 @@
 #include <Draw_PluginMacro.hxx>
 #include <Draw_ProgressIndicator.hxx>
 #include <NCollection_AccAllocator.hxx>
+#include <NCollection_IncAllocator.hxx>
+#include <NCollection_Sequence.hxx>
 #include <JtData_Model.hxx>
 #include <JtTools_FileDumpBRepProvider.hxx>
 #include <JtWireframe_BRepProvider.hxx>
 #include <DEJT_ConfigurationNode.hxx>
+#include <DEJT_IncrementalWriter.hxx>
+#include <DEJT_MappedFileSystem.hxx>
+#include <DEJT_PartFilter.hxx>
+#include <DEJT_PartitionPrefetcher.hxx>
+#include <DEJT_Provider.hxx>
+#include <DEJT_SegmentCache.hxx>
+#include <DEJT_SegmentIndex.hxx>
+#include <DEJT_TriangulationDeduplicator.hxx>
 #include <JTCAFControl_Reader.hxx>
 #include <JTCAFControl_XcafToJT.hxx>
 #include <JtNode_Partition.hxx>
 #include <JtTools_Assembly.hxx>
 #include <UnitsMethods.hxx>
 #include <OSD_File.hxx>
+#include <OSD_MemInfo.hxx>
 #include <OSD_OpenFile.hxx>
 #include <OSD_Protection.hxx>
+#include <OSD_Timer.hxx>
+#include <Message_ProgressIndicator.hxx>
+#include <NCollection_IndexedDataMap.hxx>
 #include <StdDrivers.hxx>
 #include <StdLDrivers.hxx>
 #include <TDataStd_Name.hxx>
+#include <V3d_View.hxx>
 #include <ViewerTest.hxx>
 #include <XCAFDoc_DocumentTool.hxx>
 #include <XmlDrivers.hxx>
@@ -50,6 +66,10 @@
 #include <XSAlgo_AlgoContainer.hxx>
 #include <Jt_SceneGraph.hxx>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 //! Return global instance of XT B-Rep provider to be loaded by another DRAW plugin linked to TKDEXT.
 static Handle(JtTools_IBRepProvider) & XSDRAWJT_XTBRepProvider()
 {
@@ -140,20 +160,102 @@ void XSDRAWJT::SetXTBRepProvider(const Handle(JtTools_IBRepProvider) & theBRepPr
 // purpose  :
 //=======================================================================
 static Standard_Integer LoadLSG(
-    Draw_Interpretor & /*theDI*/,
+    Draw_Interpretor &theDI,
     Standard_Integer theNbArgs,
     const char **theArgVec)
 {
-  if (theNbArgs != 2)
+  TCollection_AsciiString aFileName;
+  bool toPrefetch = false;
+  bool toCullByView = false;
+  Bnd_Box aClipBox;
+  Standard_Integer aNbInFlight = 0;
+  for (Standard_Integer anArgIter = 1; anArgIter < theNbArgs; ++anArgIter)
   {
-    std::cout << "Usage: LoadLSG jtFile\n";
+    TCollection_AsciiString anArg(theArgVec[anArgIter]);
+    anArg.LowerCase();
+    if (anArg == "-prefetch")
+    {
+      toPrefetch = true;
+      if (anArgIter + 1 < theNbArgs && TCollection_AsciiString(theArgVec[anArgIter + 1]).IsIntegerValue())
+      {
+        aNbInFlight = Draw::Atoi(theArgVec[++anArgIter]);
+      }
+    }
+    else if (anArg == "-box" && anArgIter + 6 < theNbArgs)
+    {
+      aClipBox.Update(Draw::Atof(theArgVec[anArgIter + 1]), Draw::Atof(theArgVec[anArgIter + 2]),
+                      Draw::Atof(theArgVec[anArgIter + 3]), Draw::Atof(theArgVec[anArgIter + 4]),
+                      Draw::Atof(theArgVec[anArgIter + 5]), Draw::Atof(theArgVec[anArgIter + 6]));
+      anArgIter += 6;
+    }
+    else if (anArg == "-view")
+    {
+      toCullByView = true;
+    }
+    else if (aFileName.IsEmpty())
+    {
+      aFileName = theArgVec[anArgIter];
+    }
+    else
+    {
+      std::cout << "Syntax error at argument '" << theArgVec[anArgIter] << "'\n";
+      return 1;
+    }
+  }
+  if (aFileName.IsEmpty())
+  {
+    std::cout << "Usage: LoadLSG jtFile [-prefetch [maxFilesInFlight]]"
+                 " [-box xmin ymin zmin xmax ymax zmax] [-view]\n";
+    return 1;
+  }
+  Handle(V3d_View) aView = ViewerTest::CurrentView();
+  if (toCullByView && aView.IsNull())
+  {
+    std::cout << "Error: no active viewer\n";
     return 1;
   }
 
-  TCollection_AsciiString aFileName(theArgVec[1]);
-  Handle(Jt_SceneGraph) aLSG = new Jt_SceneGraph;
-  aLSG->LoadFile(aFileName);
+  // partition files stay mapped for the time of loading
+  DEJT_MappedFileSystem::Sentry aMappingSentry(aFileName, toPrefetch);
+  if (toPrefetch)
+  {
+    DEJT_PartitionPrefetcher aPrefetcher;
+    const Standard_Integer aNbFiles = aPrefetcher.Perform(aFileName, aNbInFlight);
+    theDI << "Prefetched: " << aNbFiles << " files, " << Standard_Integer(aPrefetcher.Size() / 1024)
+          << " KiB\n";
+  }
+  if (aClipBox.IsVoid() && !toCullByView)
+  {
+    Handle(Jt_SceneGraph) aLSG = new Jt_SceneGraph;
+    aLSG->LoadFile(aFileName);
+    return 0;
+  }
 
+  // late-loaded segments within the clipping box or the view frustum only
+  Handle(NCollection_IncAllocator) anAllocator = new NCollection_IncAllocator();
+  Handle(JtData_Model) aModel = new JtData_Model(aFileName);
+  const Handle(JtNode_Partition) aRoot = aModel->Init(anAllocator, Message_ProgressRange());
+  if (aRoot.IsNull())
+  {
+    std::cout << "Error: the scene graph of '" << aFileName << "' cannot be read\n";
+    return 1;
+  }
+  Handle(DEJT_SegmentIndex) anIndex = new DEJT_SegmentIndex();
+  const Standard_Integer aNbSegments = anIndex->Perform(aRoot);
+  NCollection_Sequence<Handle(JtProperty_LateLoaded)> aSegments;
+  if (!aClipBox.IsVoid())
+  {
+    anIndex->Select(aClipBox, aSegments);
+  }
+  else
+  {
+    anIndex->Select(aView->Camera(), aSegments);
+  }
+  Handle(DEJT_SegmentCache) aCache = new DEJT_SegmentCache();
+  const Standard_Integer aNbFailed = aCache->LoadParallel(aSegments);
+  theDI << "Segments: " << aNbSegments << ", selected: " << aSegments.Length()
+        << ", failed: " << aNbFailed << ", loaded: " << Standard_Integer(aCache->Size() / 1024)
+        << " KiB\n";
   return 0;
 }
 
@@ -174,14 +276,19 @@ static Standard_Integer ReadJt(
   bool toParallel = false;
   bool toSkipDegenerateTriangles = true;
   bool toDeduplicatePrims = true;
+  bool toDeduplicateMeshes = false;
   bool toDeferMetadata = false;
-  bool toCacheFileContent = false;
+  DEJT_ConfigurationNode::ReadMode_FileAccess aFileAccessMode =
+      DEJT_ConfigurationNode::ReadMode_FileAccess_Stream;
   bool loadHiddenMetadata = true;
   bool toSkipLateDataLoading = false;
   bool toKeepLateData = true;
   bool toLoadStrictly = false;
   bool toPrintDebugInfo = false;
   bool toFilterLayers = false;
+  bool toPrefetch = false;
+  Standard_Integer aNbInFlight = 0;
+  DEJT_PartFilter aPartFilter;
   bool toReadWireframe = false;
   bool toReadXt = false;
   JTCAFControl_Representation aPrefGeomRepr = JTCAFControl_Representation_PreferMesh;
@@ -213,6 +320,18 @@ static Standard_Integer ReadJt(
         ++anArgIter;
       }
     }
+    else if (anArg == "-prefetch")
+    {
+      toPrefetch = true;
+      if (anArgIter + 1 < theNbArgs && Draw::ParseOnOff(theArgVec[anArgIter + 1], toPrefetch))
+      {
+        ++anArgIter;
+      }
+      else if (anArgIter + 1 < theNbArgs && TCollection_AsciiString(theArgVec[anArgIter + 1]).IsIntegerValue())
+      {
+        aNbInFlight = Draw::Atoi(theArgVec[++anArgIter]);
+      }
+    }
     else if (anArg == "-skipdegeneratetriangles" || anArg == "-skipdegenerate")
     {
       toSkipDegenerateTriangles = true;
@@ -229,6 +348,14 @@ static Standard_Integer ReadJt(
         ++anArgIter;
       }
     }
+    else if (anArg == "-deduplicatemeshes")
+    {
+      toDeduplicateMeshes = true;
+      if (anArgIter + 1 < theNbArgs && Draw::ParseOnOff(theArgVec[anArgIter + 1], toDeduplicateMeshes))
+      {
+        ++anArgIter;
+      }
+    }
     else if (anArg == "-defermetadata")
     {
       toDeferMetadata = true;
@@ -246,11 +373,35 @@ static Standard_Integer ReadJt(
     }
     else if (anArg == "-tocachefilecontent" || anArg == "-tocachefile" || anArg == "-tocachecontent" || anArg == "-tocache")
     {
-      toCacheFileContent = true;
+      bool toCacheFileContent = true;
       if (anArgIter + 1 < theNbArgs && Draw::ParseOnOff(theArgVec[anArgIter + 1], toCacheFileContent))
       {
         ++anArgIter;
       }
+      aFileAccessMode = toCacheFileContent ? DEJT_ConfigurationNode::ReadMode_FileAccess_Cache
+                                           : DEJT_ConfigurationNode::ReadMode_FileAccess_Stream;
+    }
+    else if (anArg == "-fileaccess" && anArgIter + 1 < theNbArgs)
+    {
+      TCollection_AsciiString anAccessStr(theArgVec[++anArgIter]);
+      anAccessStr.LowerCase();
+      if (anAccessStr == "stream")
+      {
+        aFileAccessMode = DEJT_ConfigurationNode::ReadMode_FileAccess_Stream;
+      }
+      else if (anAccessStr == "cache")
+      {
+        aFileAccessMode = DEJT_ConfigurationNode::ReadMode_FileAccess_Cache;
+      }
+      else if (anAccessStr == "mmap" || anAccessStr == "map")
+      {
+        aFileAccessMode = DEJT_ConfigurationNode::ReadMode_FileAccess_MemoryMap;
+      }
+      else
+      {
+        std::cout << "Syntax error at '" << theArgVec[anArgIter] << "'\n";
+        return 1;
+      }
     }
     else if (anArg == "-skiplateloading")
     {
@@ -361,6 +512,23 @@ static Standard_Integer ReadJt(
     {
       toFilterLayers = true;
     }
+    else if (anArg == "-only" && anArgIter + 1 < theNbArgs)
+    {
+      aPartFilter.AddPattern(theArgVec[++anArgIter]);
+    }
+    else if (anArg == "-onlylayer" && anArgIter + 1 < theNbArgs)
+    {
+      aPartFilter.AddLayer(theArgVec[++anArgIter]);
+    }
+    else if (anArg == "-onlybox" && anArgIter + 6 < theNbArgs)
+    {
+      Bnd_Box aBox;
+      aBox.Update(Draw::Atof(theArgVec[anArgIter + 1]), Draw::Atof(theArgVec[anArgIter + 2]),
+                  Draw::Atof(theArgVec[anArgIter + 3]), Draw::Atof(theArgVec[anArgIter + 4]),
+                  Draw::Atof(theArgVec[anArgIter + 5]), Draw::Atof(theArgVec[anArgIter + 6]));
+      aPartFilter.SetBox(aBox);
+      anArgIter += 6;
+    }
     else if (anArg == "-outhasmixednblods" && anArgIter + 1 < theNbArgs)
     {
       anOutHasMixedNbLodsVar = theArgVec[++anArgIter];
@@ -410,7 +578,7 @@ static Standard_Integer ReadJt(
     aReader.SetSkipDegenerateTriangles(toSkipDegenerateTriangles);
     aReader.SetDeduplicatePrimitives(toDeduplicatePrims);
     aReader.SetDeferMetadata(toDeferMetadata);
-    aReader.SetCacheFileContent(toCacheFileContent);
+    aReader.SetCacheFileContent(aFileAccessMode == DEJT_ConfigurationNode::ReadMode_FileAccess_Cache);
     aReader.SetPreferredRepresentation(aPrefGeomRepr);
     aReader.SetLoadHiddenMetadata(loadHiddenMetadata);
     aReader.SetToSkipLateDataLoading(toSkipLateDataLoading);
@@ -451,6 +619,14 @@ static Standard_Integer ReadJt(
     }
     aReader.SetSystemLengthUnit(aLengthUnitM);
 
+    DEJT_MappedFileSystem::Sentry aMappingSentry(aFilePath, aFileAccessMode == DEJT_ConfigurationNode::ReadMode_FileAccess_MemoryMap);
+    if (toPrefetch)
+    {
+      DEJT_PartitionPrefetcher aPrefetcher;
+      const Standard_Integer aNbFiles = aPrefetcher.Perform(aFilePath, aNbInFlight);
+      theDI << "Prefetched: " << aNbFiles << " files\n";
+    }
+    const Standard_Integer aFirstShapeTag = DEJT_Provider::NextShapeTag(aDoc);
     if (!aReader.Perform(aDoc, aFilePath.ToCString(), aProgress->Start()))
     {
       std::cout << "Error: file reading failed '" << aFilePath << "'\n";
@@ -464,6 +640,18 @@ static Standard_Integer ReadJt(
     TCollection_AsciiString aTypeStr;
     printBRepJtType(aReader.BRepGeometryTypes(), aTypeStr);
     theDI << "Nb.LODs: " << aReader.NbTriangulationLods() << "\n";
+    if (!aPartFilter.IsEmpty())
+    {
+      aPartFilter.Perform(aDoc, aFirstShapeTag);
+      theDI << "Parts:   " << aPartFilter.NbKept() << " kept of " << aPartFilter.NbParts() << "\n";
+    }
+    if (toDeduplicateMeshes)
+    {
+      DEJT_TriangulationDeduplicator aDeduplicator;
+      aDeduplicator.Perform(aDoc);
+      theDI << "Meshes:  " << aDeduplicator.NbUnique() << " unique of "
+            << aDeduplicator.NbTriangulations() << " (ratio " << aDeduplicator.Ratio() << ")\n";
+    }
     theDI << "B-Rep:   " << aTypeStr << "\n";
     if (!anOutNbLodsVar.IsEmpty())
     {
@@ -485,6 +673,461 @@ static Standard_Integer ReadJt(
   return 0;
 }
 
+//! Allocator counting allocations of the JT model.
+class XSDRAWJT_CountingAllocator : public NCollection_BaseAllocator
+{
+public:
+  XSDRAWJT_CountingAllocator(const Handle(NCollection_BaseAllocator)& theBaseAllocator)
+      : myBaseAllocator(theBaseAllocator),
+        myNbAllocations(0),
+        mySize(0)
+  {
+  }
+
+  virtual void* Allocate(const size_t theSize) Standard_OVERRIDE
+  {
+    ++myNbAllocations;
+    mySize += theSize;
+    return myBaseAllocator->Allocate(theSize);
+  }
+
+  //! Containers request blocks by AllocateOptimal(), which should be counted as well.
+  virtual void* AllocateOptimal(const size_t theSize) Standard_OVERRIDE
+  {
+    return Allocate(theSize);
+  }
+
+  virtual void Free(void* theAddress) Standard_OVERRIDE { myBaseAllocator->Free(theAddress); }
+
+  //! Returns the number of allocations.
+  size_t NbAllocations() const { return myNbAllocations; }
+
+  //! Returns the total size of allocated memory.
+  size_t Size() const { return mySize; }
+
+private:
+  Handle(NCollection_BaseAllocator) myBaseAllocator;
+  size_t                            myNbAllocations;
+  size_t                            mySize;
+};
+
+//! Progress indicator measuring the time of reading phases within a single pass.
+//! The phase is defined by the outermost named sub-scope of the reader scope.
+class XSDRAWJT_PhaseTimer : public Message_ProgressIndicator
+{
+public:
+  XSDRAWJT_PhaseTimer() { myTimer.Start(); }
+
+  //! Returns the time of each phase in seconds in the order of appearance.
+  const NCollection_IndexedDataMap<TCollection_AsciiString, Standard_Real>& Phases()
+  {
+    switchPhase(myPhase);
+    return myPhases;
+  }
+
+  virtual void Show(const Message_ProgressScope& theScope,
+                    const Standard_Boolean       isForce) Standard_OVERRIDE
+  {
+    (void)isForce;
+    // chain of scopes from the root of the indicator to the given one
+    NCollection_Sequence<const Message_ProgressScope*> aChain;
+    for (const Message_ProgressScope* aScope = &theScope; aScope != NULL; aScope = aScope->Parent())
+    {
+      aChain.Prepend(aScope);
+    }
+    const Standard_Integer aDepth = aChain.Length() >= 3 ? 3 : aChain.Length();
+    const Standard_CString aName  = aDepth >= 2 ? aChain.Value(aDepth)->Name() : NULL;
+    switchPhase(aName != NULL ? TCollection_AsciiString(aName) : TCollection_AsciiString("other"));
+  }
+
+private:
+  //! Adds the time since the last switch to the current phase and makes the given one current.
+  void switchPhase(const TCollection_AsciiString& thePhase)
+  {
+    if (thePhase == myPhase && !myPhase.IsEmpty())
+    {
+      return;
+    }
+    const Standard_Real aTime = myTimer.ElapsedTime();
+    if (!myPhase.IsEmpty())
+    {
+      if (Standard_Real* aPhaseTime = myPhases.ChangeSeek(myPhase))
+      {
+        *aPhaseTime += aTime - myPhaseStart;
+      }
+      else
+      {
+        myPhases.Add(myPhase, aTime - myPhaseStart);
+      }
+    }
+    myPhase      = thePhase.IsEmpty() ? TCollection_AsciiString("other") : thePhase;
+    myPhaseStart = aTime;
+  }
+
+private:
+  OSD_Timer                                                        myTimer;
+  NCollection_IndexedDataMap<TCollection_AsciiString, Standard_Real> myPhases;
+  TCollection_AsciiString                                          myPhase;
+  Standard_Real                                                    myPhaseStart = 0.0;
+};
+
+//! Sampler of the working set of the process during a run,
+//! as the peak working set reported by the system is not reset between runs.
+class XSDRAWJT_WorkingSetSampler
+{
+public:
+  //! Starts sampling with the given interval in milliseconds.
+  XSDRAWJT_WorkingSetSampler(const int theIntervalMs)
+      : myBase(currentWorkingSet()),
+        myPeak(myBase),
+        myToStop(false)
+  {
+    myThread = std::thread([this, theIntervalMs]() {
+      while (!myToStop)
+      {
+        update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(theIntervalMs));
+      }
+    });
+  }
+
+  ~XSDRAWJT_WorkingSetSampler() { Stop(); }
+
+  //! Stops sampling and returns the peak growth of the working set in bytes.
+  size_t Stop()
+  {
+    myToStop = true;
+    if (myThread.joinable())
+    {
+      myThread.join();
+      update();
+    }
+    return myPeak - myBase;
+  }
+
+private:
+  static size_t currentWorkingSet()
+  {
+    OSD_MemInfo aMemInfo(Standard_False);
+    aMemInfo.SetActive(Standard_False);
+    aMemInfo.SetActive(OSD_MemInfo::MemWorkingSet, Standard_True);
+    aMemInfo.Update();
+    return aMemInfo.Value(OSD_MemInfo::MemWorkingSet);
+  }
+
+  void update()
+  {
+    const size_t aSize = currentWorkingSet();
+    if (aSize > myPeak)
+    {
+      myPeak = aSize;
+    }
+  }
+
+private:
+  std::thread       myThread;
+  size_t            myBase;
+  size_t            myPeak;
+  std::atomic<bool> myToStop;
+};
+
+//! Reading configuration of JtBench command.
+struct XSDRAWJT_BenchConfig
+{
+  bool                                        ToParallel;
+  DEJT_ConfigurationNode::ReadMode_FileAccess FileAccessMode;
+  bool                                        ToDeferMetadata;
+  Standard_Integer                            LodIndex;
+};
+
+//! Reads the JT file with metadata and PMI into a new document within the benchmark configuration.
+//! @return elapsed time in seconds or -1.0 on failure
+static Standard_Real benchReadJt(const TCollection_AsciiString& theFilePath,
+                                 const XSDRAWJT_BenchConfig&    theConfig,
+                                 const Message_ProgressRange&   theProgress)
+{
+  Handle(TDocStd_Document) aDoc = new TDocStd_Document("BinXCAF");
+  OSD_Timer                aTimer;
+  aTimer.Start();
+  {
+    JTCAFControl_Reader aReader;
+    aReader.SetParallel(theConfig.ToParallel);
+    aReader.SetTriangulationLod(theConfig.LodIndex);
+    aReader.SetDeferMetadata(theConfig.ToDeferMetadata);
+    aReader.SetCacheFileContent(theConfig.FileAccessMode
+                                == DEJT_ConfigurationNode::ReadMode_FileAccess_Cache);
+    aReader.SetTranslateMetadata(true);
+    aReader.SetTranslatePMI(true);
+    DEJT_MappedFileSystem::Sentry aMappingSentry(
+      theFilePath,
+      theConfig.FileAccessMode == DEJT_ConfigurationNode::ReadMode_FileAccess_MemoryMap);
+    if (!aReader.Perform(aDoc, theFilePath.ToCString(), theProgress))
+    {
+      return -1.0;
+    }
+  }
+  aTimer.Stop();
+  return aTimer.ElapsedTime();
+}
+
+//! Appends the string to JSON output with escaping.
+static void benchJsonString(TCollection_AsciiString& theJson, const TCollection_AsciiString& theStr)
+{
+  theJson += "\"";
+  for (Standard_Integer aCharIter = 1; aCharIter <= theStr.Length(); ++aCharIter)
+  {
+    const Standard_Character aChar = theStr.Value(aCharIter);
+    switch (aChar)
+    {
+      case '"':
+        theJson += "\\\"";
+        break;
+      case '\\':
+        theJson += "\\\\";
+        break;
+      case '\b':
+        theJson += "\\b";
+        break;
+      case '\f':
+        theJson += "\\f";
+        break;
+      case '\n':
+        theJson += "\\n";
+        break;
+      case '\r':
+        theJson += "\\r";
+        break;
+      case '\t':
+        theJson += "\\t";
+        break;
+      default: {
+        // other control characters U+0000..U+001F are not allowed in JSON strings
+        if ((unsigned char)aChar < 0x20)
+        {
+          char aCode[8];
+          Sprintf(aCode, "\\u%04x", (unsigned int)(unsigned char)aChar);
+          theJson += aCode;
+        }
+        else
+        {
+          theJson += aChar;
+        }
+        break;
+      }
+    }
+  }
+  theJson += "\"";
+}
+
+//=======================================================================
+// function : JtBench
+// purpose  :
+//=======================================================================
+static Standard_Integer JtBench(
+    Draw_Interpretor &theDI,
+    Standard_Integer theNbArgs,
+    const char **theArgVec)
+{
+  NCollection_Sequence<TCollection_AsciiString> aFiles;
+  NCollection_Sequence<bool> aParallelModes, aDeferModes;
+  NCollection_Sequence<DEJT_ConfigurationNode::ReadMode_FileAccess> aFileAccessModes;
+  NCollection_Sequence<Standard_Integer> aLods;
+  TCollection_AsciiString anOutFile;
+  Standard_Integer aNbRepeats = 1;
+  Standard_Integer anArenaBlockSize = 0;
+  for (Standard_Integer anArgIter = 1; anArgIter < theNbArgs; ++anArgIter)
+  {
+    TCollection_AsciiString anArg(theArgVec[anArgIter]);
+    anArg.LowerCase();
+    if (anArg == "-parallel" || anArg == "-defermetadata")
+    {
+      NCollection_Sequence<bool>& aModes = anArg == "-parallel" ? aParallelModes : aDeferModes;
+      for (bool aMode = false; anArgIter + 1 < theNbArgs && Draw::ParseOnOff(theArgVec[anArgIter + 1], aMode);
+           ++anArgIter)
+      {
+        aModes.Append(aMode);
+      }
+    }
+    else if (anArg == "-fileaccess")
+    {
+      for (; anArgIter + 1 < theNbArgs; ++anArgIter)
+      {
+        TCollection_AsciiString aModeStr(theArgVec[anArgIter + 1]);
+        aModeStr.LowerCase();
+        if (aModeStr == "stream")
+          aFileAccessModes.Append(DEJT_ConfigurationNode::ReadMode_FileAccess_Stream);
+        else if (aModeStr == "cache")
+          aFileAccessModes.Append(DEJT_ConfigurationNode::ReadMode_FileAccess_Cache);
+        else if (aModeStr == "mmap")
+          aFileAccessModes.Append(DEJT_ConfigurationNode::ReadMode_FileAccess_MemoryMap);
+        else
+          break;
+      }
+    }
+    else if (anArg == "-lod")
+    {
+      for (; anArgIter + 1 < theNbArgs
+             && TCollection_AsciiString(theArgVec[anArgIter + 1]).IsIntegerValue();
+           ++anArgIter)
+      {
+        aLods.Append(Draw::Atoi(theArgVec[anArgIter + 1]));
+      }
+    }
+    else if (anArg == "-repeat" && anArgIter + 1 < theNbArgs)
+    {
+      aNbRepeats = Max(Draw::Atoi(theArgVec[++anArgIter]), 1);
+    }
+    else if (anArg == "-arena" && anArgIter + 1 < theNbArgs)
+    {
+      anArenaBlockSize = Max(Draw::Atoi(theArgVec[++anArgIter]), 0);
+    }
+    else if ((anArg == "-out" || anArg == "-json") && anArgIter + 1 < theNbArgs)
+    {
+      anOutFile = theArgVec[++anArgIter];
+    }
+    else if (anArg.StartsWith("-"))
+    {
+      theDI << "Syntax error at argument '" << theArgVec[anArgIter] << "'\n";
+      return 1;
+    }
+    else
+    {
+      aFiles.Append(theArgVec[anArgIter]);
+    }
+  }
+  if (aFiles.IsEmpty())
+  {
+    theDI << "Syntax error: wrong number of arguments\n";
+    return 1;
+  }
+  if (aParallelModes.IsEmpty())
+  {
+    aParallelModes.Append(false);
+    aParallelModes.Append(true);
+  }
+  if (aDeferModes.IsEmpty())
+  {
+    aDeferModes.Append(false);
+  }
+  if (aFileAccessModes.IsEmpty())
+  {
+    aFileAccessModes.Append(DEJT_ConfigurationNode::ReadMode_FileAccess_Stream);
+  }
+  if (aLods.IsEmpty())
+  {
+    aLods.Append(0);
+  }
+
+  static const char* THE_ACCESS_NAMES[3] = {"stream", "cache", "mmap"};
+  TCollection_AsciiString aJson = "{\n  \"runs\": [";
+  bool isFirstRun = true;
+  for (NCollection_Sequence<TCollection_AsciiString>::Iterator aFileIter(aFiles); aFileIter.More(); aFileIter.Next())
+  {
+    for (NCollection_Sequence<bool>::Iterator aParIter(aParallelModes); aParIter.More(); aParIter.Next())
+    {
+      for (NCollection_Sequence<DEJT_ConfigurationNode::ReadMode_FileAccess>::Iterator anAccessIter(aFileAccessModes);
+           anAccessIter.More(); anAccessIter.Next())
+      {
+        for (NCollection_Sequence<bool>::Iterator aDeferIter(aDeferModes); aDeferIter.More(); aDeferIter.Next())
+        {
+          for (NCollection_Sequence<Standard_Integer>::Iterator aLodIter(aLods); aLodIter.More(); aLodIter.Next())
+          {
+            const XSDRAWJT_BenchConfig aConfig = {aParIter.Value(), anAccessIter.Value(),
+                                                  aDeferIter.Value(), aLodIter.Value()};
+            for (Standard_Integer aRepeatIter = 0; aRepeatIter < aNbRepeats; ++aRepeatIter)
+            {
+              OSD_MemInfo aMemInfo(Standard_False);
+              aMemInfo.SetActive(Standard_False);
+              aMemInfo.SetActive(OSD_MemInfo::MemHeapUsage, Standard_True);
+              aMemInfo.Update();
+              const size_t aHeapBefore = aMemInfo.Value(OSD_MemInfo::MemHeapUsage);
+
+              // TOC and LSG segment parsing into JT data model, measured by its own pass
+              // the arena is released at once together with the model
+              Handle(XSDRAWJT_CountingAllocator) anAllocator = new XSDRAWJT_CountingAllocator(
+                anArenaBlockSize > 0 ? Handle(NCollection_BaseAllocator)(new NCollection_IncAllocator(anArenaBlockSize))
+                                     : NCollection_BaseAllocator::CommonBaseAllocator());
+              OSD_Timer aTimer;
+              aTimer.Start();
+              bool isDone = false;
+              {
+                DEJT_MappedFileSystem::Sentry aMappingSentry(
+                  aFileIter.Value(),
+                  aConfig.FileAccessMode == DEJT_ConfigurationNode::ReadMode_FileAccess_MemoryMap);
+                Handle(JtData_Model) aModel = new JtData_Model(aFileIter.Value().ToCString());
+                isDone = !aModel->Init(anAllocator, Message_ProgressRange(),
+                                       aConfig.FileAccessMode == DEJT_ConfigurationNode::ReadMode_FileAccess_Cache).IsNull();
+              }
+              aTimer.Stop();
+              const Standard_Real aTimeInit = aTimer.ElapsedTime();
+
+              // phases of the full read are timed within the same pass
+              Handle(XSDRAWJT_PhaseTimer) aPhaseTimer = new XSDRAWJT_PhaseTimer();
+              Standard_Real aTimeFull = -1.0;
+              size_t aPeakDelta = 0;
+              if (isDone)
+              {
+                XSDRAWJT_WorkingSetSampler aSampler(5);
+                aTimeFull = benchReadJt(aFileIter.Value(), aConfig, aPhaseTimer->Start());
+                aPeakDelta = aSampler.Stop();
+              }
+              aMemInfo.Update();
+
+              aJson += isFirstRun ? "\n" : ",\n";
+              isFirstRun = false;
+              aJson += "    {\"file\": ";
+              benchJsonString(aJson, aFileIter.Value());
+              aJson += TCollection_AsciiString(", \"parallel\": ") + (aConfig.ToParallel ? "true" : "false")
+                     + ", \"fileAccess\": \"" + THE_ACCESS_NAMES[aConfig.FileAccessMode] + "\""
+                     + ", \"deferMetadata\": " + (aConfig.ToDeferMetadata ? "true" : "false")
+                     + ", \"lod\": " + aConfig.LodIndex
+                     + ", \"arenaBlockSize\": " + anArenaBlockSize
+                     + ", \"repeat\": " + aRepeatIter
+                     + ", \"status\": \"" + (aTimeFull >= 0.0 ? "ok" : "failed") + "\"";
+              if (aTimeFull >= 0.0)
+              {
+                aJson += TCollection_AsciiString(",\n     \"time\": {\"total\": ") + aTimeFull
+                       + ", \"tocParse\": " + aTimeInit + ", \"phases\": {";
+                const NCollection_IndexedDataMap<TCollection_AsciiString, Standard_Real>& aPhases =
+                  aPhaseTimer->Phases();
+                for (Standard_Integer aPhaseIter = 1; aPhaseIter <= aPhases.Extent(); ++aPhaseIter)
+                {
+                  aJson += aPhaseIter > 1 ? ", " : "";
+                  benchJsonString(aJson, aPhases.FindKey(aPhaseIter));
+                  aJson += TCollection_AsciiString(": ") + aPhases.FindFromIndex(aPhaseIter);
+                }
+                aJson += TCollection_AsciiString("}}")
+                       + ",\n     \"memory\": {\"peakWorkingSetDelta\": " + (Standard_Real)aPeakDelta
+                       + ", \"heapDelta\": "
+                       + ((Standard_Real)aMemInfo.Value(OSD_MemInfo::MemHeapUsage) - (Standard_Real)aHeapBefore)
+                       + ", \"tocAllocations\": " + (Standard_Real)anAllocator->NbAllocations()
+                       + ", \"tocAllocatedBytes\": " + (Standard_Real)anAllocator->Size() + "}";
+              }
+              aJson += "}";
+            }
+          }
+        }
+      }
+    }
+  }
+  aJson += "\n  ]\n}\n";
+
+  if (anOutFile.IsEmpty())
+  {
+    theDI << aJson;
+    return 0;
+  }
+  std::ofstream aStream;
+  OSD_OpenStream(aStream, anOutFile, std::ios::out | std::ios::binary);
+  if (!aStream.is_open())
+  {
+    theDI << "Error: unable to open file '" << anOutFile << "' for writing\n";
+    return 1;
+  }
+  aStream << aJson;
+  return 0;
+}
+
 //=======================================================================
 // function : WriteJt
 // purpose  :
@@ -511,6 +1154,8 @@ static Standard_Integer WriteJt(
   JtData_LengthUnit aJtLengthUnit = JtData_LengthUnit_UNKNOWN;
   // Name format
   JTCAFControl_NameFormat aNameFormat = JTCAFControl_InstanceName;
+  // Multithreading parameters
+  bool isParallel = false;
   for (Standard_Integer i = 3; i < theCount; ++i)
   {
     if (isDeflection)
@@ -536,6 +1181,14 @@ static Standard_Integer WriteJt(
         aFileCountMax = Draw::Atoi(theArgs[++i]);
       }
     }
+    else if (!strcmp(theArgs[i], "-parallel"))
+    {
+      isParallel = true;
+      if (theCount > i + 1 && Draw::ParseOnOff(theArgs[i + 1], isParallel))
+      {
+        ++i;
+      }
+    }
     else if (!strcmp(theArgs[i], "-name"))
     {
       if (theCount > i + 1)
@@ -606,6 +1259,11 @@ static Standard_Integer WriteJt(
     aCafLengthUnitM = UnitsMethods::GetCasCadeLengthUnit(UnitsMethods_LengthUnit_Meter);
   }
 
+  for (size_t aLodIter = 0; aLodIter < aLODParameters.size(); ++aLodIter)
+  {
+    aLODParameters[aLodIter].InParallel = isParallel;
+  }
+
   // Create and save the JT model.
   Jt_GUID::Value(Standard_True);
   JTCAFControl_XcafToJT aConverter;
@@ -697,18 +1355,30 @@ static Standard_Integer AssembleJt(
     return 1;
   }
 
-  const Standard_Boolean isShattered = (strcmp(theArgs[1], "-s") == 0);
-  if ((isShattered && theCount == 2) || (!isShattered && theCount == 3))
+  Standard_Integer anArgIter = 1;
+  const Standard_Boolean isShattered = (strcmp(theArgs[anArgIter], "-s") == 0);
+  if (isShattered)
+  {
+    ++anArgIter;
+  }
+  const Standard_Boolean isIncremental =
+    (anArgIter < theCount && strcmp(theArgs[anArgIter], "-incremental") == 0);
+  if (isIncremental)
+  {
+    ++anArgIter;
+  }
+  if (anArgIter >= theCount || (!isShattered && theCount - anArgIter == 2))
   {
     Message::SendFail() << "Error: invalid count of arguments.\n";
     return 1;
   }
+  const char* aSuperModelPath = theArgs[anArgIter++];
 
   JtData_Array<TCollection_AsciiString> *aModelPathPointer = &ModelPaths;
   JtData_Array<TCollection_AsciiString> aModelPaths;
-  if ((isShattered && theCount != 3) || (!isShattered && theCount != 2))
+  if (anArgIter < theCount)
   {
-    for (Jt_I32 aI = (isShattered ? 3 : 2); aI < theCount; ++aI)
+    for (Jt_I32 aI = anArgIter; aI < theCount; ++aI)
     {
       aModelPaths.push_back(theArgs[aI]);
     }
@@ -739,7 +1409,19 @@ static Standard_Integer AssembleJt(
     }
   }
 
-  Handle(JtData_Model) aJTModel = new JtData_Model(theArgs[isShattered ? 2 : 1]);
+  if (isIncremental)
+  {
+    DEJT_IncrementalWriter aWriter;
+    if (!aWriter.Perform(aAssembly, aSuperModelPath, isShattered, aProgressI->Start()))
+    {
+      Message::SendFail() << "Error: failed to store the assembly.\n";
+    }
+    theDI << "Written files: " << aWriter.NbWritten() << ", unchanged files: " << aWriter.NbSkipped()
+          << ", removed files: " << aWriter.NbRemoved() << "\n";
+    return 0;
+  }
+
+  Handle(JtData_Model) aJTModel = new JtData_Model(aSuperModelPath);
   if (!JtData_Model::Store(aJTModel, aAssembly, isShattered))
   {
     Message::SendFail() << "Error: failed to store the assembly.\n";
@@ -770,11 +1452,14 @@ void XSDRAWJT::InitCommands(Draw_Interpretor &theCommands)
                   "\n\t\t:   [-noCreateDoc {on|off}=off]"
                   "\n\t\t:   [-lod LOD=0]"
                   "\n\t\t:   [-parallel {on|off}=off]"
+                  "\n\t\t:   [-prefetch {on|off|NbInFlight}=off]"
                   "\n\t\t:   [-skipDegenerate {on|off}=on]"
                   "\n\t\t:   [-deduplicatePrims {on|off}=on]"
+                  "\n\t\t:   [-deduplicateMeshes {on|off}=off]"
                   "\n\t\t:   [-deferMetadata {on|off}=off]"
                   "\n\t\t:   [-loadhiddenmetadata {on|off}=on]"
                   "\n\t\t:   [-toCacheFileContent {on|off}=off]"
+                  "\n\t\t:   [-fileAccess {stream|cache|mmap}=stream]"
                   "\n\t\t:   [-skipLateLoading {on|off}=on]"
                   "\n\t\t:   [-keepLate {on|off}=on]]"
                   "\n\t\t:   [-toPrintDebugInfo {on|off}=on]]"
@@ -783,20 +1468,32 @@ void XSDRAWJT::InitCommands(Draw_Interpretor &theCommands)
                   "\n\t\t:   [-dumpBRep filePrefix]"
                   "\n\t\t:   [-outHasMixedNbLods Var]"
                   "\n\t\t:   [-filterLayers]"
+                  "\n\t\t:   [-only pattern] [-onlyLayer name]"
+                  "\n\t\t:   [-onlyBox xmin ymin zmin xmax ymax zmax]"
                   "\n\t\t: Reads the JT file and translates it into the CAF document."
                   "\n\t\t:   '-lod' - load specific triangulation (0 - highest quality)"
                   "\n\t\t:   '-strictly' - load and activate ONLY exactly specified triangulation."
                   "\n\t\t:       Full file structure will be loaded in any case."
                   "\n\t\t:   '-parallel' - use multithreaded optimizations"
+                  "\n\t\t:       on the threads configured for OSD_Parallel"
+                  "\n\t\t:   '-prefetch' - read the header, TOC and LSG segment of partition files"
+                  "\n\t\t:       of shattered assembly concurrently before reading the model;"
+                  "\n\t\t:       the maximum number of files read at the same time can be specified"
                   "\n\t\t:   '-skipDegenerate' - skip degenerate triangles"
                   "\n\t\t:   '-deduplicatePrims' - share BRep geometry defining JT"
                   "\n\t\t:       primitives with the same parameters"
+                  "\n\t\t:   '-deduplicateMeshes' - share bit-identical triangulations of"
+                  "\n\t\t:       different parts and print the deduplication ratio"
                   "\n\t\t:   '-deferMetadata' - do not read late-load Metadata straight away"
                   "\n\t\t:   '-loadhiddenmetadata' - controls loading of hidden Metadata"
                   "\n\t\t:   '-noCreateDoc' - use the existing document instead of a new"
                   "\n\t\t:       one"
                   "\n\t\t:   '-toCacheFileContent' - cache entire file content within JT"
-                  "\n\t\t:       Model"
+                  "\n\t\t:       Model; same as '-fileAccess cache'"
+                  "\n\t\t:   '-fileAccess' - define how late-loaded segments access the file:"
+                  "\n\t\t:       stream for re-opening the file for every segment,"
+                  "\n\t\t:       cache for copying entire file content within JT Model,"
+                  "\n\t\t:       mmap for reading segments directly from memory-mapped file"
                   "\n\t\t:   '-skipLateLoading' - skip data loading. It can be performed later (false by default)"
                   "\n\t\t:   '-keepLate' - load data into itself with preservation of information"
                   "\n\t\t:       about deferred storage to load/unload this data later"
@@ -819,13 +1516,21 @@ void XSDRAWJT::InitCommands(Draw_Interpretor &theCommands)
                   "\n\t\t:   '-outHasMixedNbLods' - set the TCL variable to the 'true' value if there are"
                   "\n\t\t:        different numbers of LODs in the JT file else to 'false' value"
                   "\n\t\t:   '-filterLayers' - filter the layers by properties \"ACTIVELAYERFILTER\","
-                  "\n\t\t:       \"LAYERFILTER<ID>\" and \"LAYER\"",
+                  "\n\t\t:       \"LAYERFILTER<ID>\" and \"LAYER\""
+                  "\n\t\t:   '-only' - keep only the nodes which name matches the glob pattern"
+                  "\n\t\t:       ('*', '?') and their children; pattern containing '/' is matched"
+                  "\n\t\t:       against the full path of the node, e.g. \"/Car/Engine*\";"
+                  "\n\t\t:       can be specified several times"
+                  "\n\t\t:   '-onlyLayer' - keep only the nodes of the layer and their children;"
+                  "\n\t\t:       can be specified several times"
+                  "\n\t\t:   '-onlyBox' - keep only the parts intersecting the box",
                   __FILE__, ReadJt, aGroup);
   theCommands.Add("WriteJt",
                   "WriteJt cafDoc jtFile [-partition [<max file count>]]\n"
                   "    [-deflections <LOD0 deflection> [<LOD1 deflection> ...]]\n"
                   "    [-name {product/instance}]\n"
                   "    [-lu <CAF length unit in mm> <JT length unit>]\n"
+                  "    [-parallel [{on|off}]]\n"
                   "  Writes the pre-triangulated model or the model with the required deflections\n"
                   "  from the CAF document to the JT file:\n"
                   "    '-partition' - write part nodes outside of the file containing theirs"
@@ -833,13 +1538,42 @@ void XSDRAWJT::InitCommands(Draw_Interpretor &theCommands)
                   "    '-deflections' - deflections of the LODs (as many deflections are given,"
                   "      as many LODs will be created).\n"
                   "    '-name' - format of the node names (instance name is used by default).\n"
+                  "    '-parallel' - mesh the LODs using the threads configured for OSD_Parallel.\n"
                   "    '-jtLengthUnit' - sets the length units for the JT model, valid names:,\n"
                   "      'millimeters, centimeters, meters, inches, "
                   "      'feet, yards, micrometers, decimeters, kilometers, mils, miles\n",
                   __FILE__, WriteJt, aGroup);
+  theCommands.Add("JtBench",
+                  "JtBench file1 [file2 ...]"
+                  "\n\t\t:   [-parallel {on|off} [{on|off}]=off on]"
+                  "\n\t\t:   [-fileAccess {stream|cache|mmap} [...]=stream]"
+                  "\n\t\t:   [-deferMetadata {on|off} [{on|off}]=off]"
+                  "\n\t\t:   [-lod LOD [LOD ...]=0]"
+                  "\n\t\t:   [-repeat N=1] [-out result.json]"
+                  "\n\t\t:   [-arena blockSize=0]"
+                  "\n\t\t: Reads JT files under each combination of the listed parameters"
+                  "\n\t\t: and reports timings and memory counters in JSON format:"
+                  "\n\t\t:   'total' - time of the full read with Metadata and PMI;"
+                  "\n\t\t:   'phases' - time of the reader progress steps within the same read;"
+                  "\n\t\t:   'tocParse' - reading TOC and LSG segment into JT data model"
+                  "\n\t\t:       by a separate pass before the full read;"
+                  "\n\t\t:   'peakWorkingSetDelta' - peak growth of the working set during the read,"
+                  "\n\t\t:       sampled every 5 ms;"
+                  "\n\t\t:   'tocAllocations' - number of allocations of the 'tocParse' pass;"
+                  "\n\t\t:       '-arena' allocates JT data model from NCollection_IncAllocator"
+                  "\n\t\t:       with the given block size instead of the general heap.",
+                  __FILE__, JtBench, aGroup);
   theCommands.Add("LoadLSG",
-                  "LoadLSG jtFile\n"
-                  "  Iterates over scene graph of loaded jt file",
+                  "LoadLSG jtFile [-prefetch [maxFilesInFlight]]"
+                  " [-box xmin ymin zmin xmax ymax zmax] [-view]\n"
+                  "  Iterates over scene graph of loaded jt file\n"
+                  "  -box, -view load only the late-loaded segments of shape nodes which bounds\n"
+                  "      intersect the clipping box or the view frustum of the active viewer\n"
+                  "      (see DEJT_SegmentIndex)\n"
+                  "  -prefetch reads the header, TOC and LSG segment of partition files\n"
+                  "      referenced by the root file (shattered assembly) concurrently before loading; the number of\n"
+                  "      files read at the same time is limited by the number of logical processors\n"
+                  "      unless specified",
                   __FILE__, LoadLSG, aGroup);
 
   theCommands.Add("ReadWriteJt", "Reads and writes jt file via Jt data model without xcaf conversion."
@@ -853,7 +1587,7 @@ void XSDRAWJT::InitCommands(Draw_Interpretor &theCommands)
                   __FILE__, AddJtModel, aGroup);
   theCommands.Add("AssembleJt",
                   "\n"
-                  "  AssembleJt [-s] <supermodel file path>\n"
+                  "  AssembleJt [-s] [-incremental] <supermodel file path>\n"
                   "    [<model file path 1> ... <model file path n>]\n"
                   "\n"
                   "  With option '-s' assembles the JT models to a single shattered JT supermodel\n"
@@ -863,9 +1597,14 @@ void XSDRAWJT::InitCommands(Draw_Interpretor &theCommands)
                   "  Without option '-s' assembles the JT models to a single monolithic JT\n"
                   "  supermodel.\n"
                   "\n"
+                  "  With option '-incremental' only the files which content differs from\n"
+                  "  the existing files are written.\n"
+                  "\n"
                   "  The list created by command 'AddJtModel' is used\n"
                   "  if the file paths are not set.",
                   __FILE__, AssembleJt, aGroup);
+
+  XSDRAWJT_Test::InitCommands(theCommands);
 }
 
 //==============================================================================
@@ -0,0 +1,338 @@
+// Copyright (c) 2025 OPEN CASCADE SAS
+//
+// This is a code sample provided for preview and evaluation purposes.
+// 
+// Permission is granted hereby to use this sample code for evaluation
+// and learning purposes only. This code may not be used in production
+// environments without proper licensing.
+//
+// THIS CODE SAMPLE IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+// EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIMS, DAMAGES OR
+// OTHER LIABILITIES.
+
+#include <XSDRAWJT_Test.hxx>
+
+#include <DEJT_ConfigurationNode.hxx>
+#include <DEJT_MetadataStore.hxx>
+#include <DEJT_Provider.hxx>
+#include <DEJT_SegmentIndex.hxx>
+#include <Graphic3d_Camera.hxx>
+#include <JtData_Model.hxx>
+#include <Message_ProgressRange.hxx>
+#include <NCollection_IncAllocator.hxx>
+#include <NCollection_Map.hxx>
+#include <OSD_File.hxx>
+#include <OSD_Path.hxx>
+#include <Precision.hxx>
+#include <TDataStd_NamedData.hxx>
+#include <TDF_ChildIterator.hxx>
+#include <TDocStd_Document.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+
+//=======================================================================
+// function : JtTestMetadataStore
+// purpose  : Reads two files lazily into one document and compares
+//            their metadata with the metadata of separate eager reads
+//=======================================================================
+static Standard_Integer JtTestMetadataStore(Draw_Interpretor& theDI,
+                                            Standard_Integer  theNbArgs,
+                                            const char**      theArgVec)
+{
+  if (theNbArgs != 3)
+  {
+    theDI << "Syntax error: wrong number of arguments\n";
+    return 1;
+  }
+
+  Handle(DEJT_ConfigurationNode) aLazyNode = new DEJT_ConfigurationNode();
+  aLazyNode->InternalParameters.ReadTranslateMetadata = true;
+  aLazyNode->InternalParameters.ReadLazyMetadata      = true;
+  Handle(DEJT_ConfigurationNode) anEagerNode =
+    Handle(DEJT_ConfigurationNode)::DownCast(aLazyNode->Copy());
+  anEagerNode->InternalParameters.ReadLazyMetadata = false;
+
+  Handle(TDocStd_Document) aDoc          = new TDocStd_Document("BinXCAF");
+  Handle(DEJT_Provider)    aLazyProvider = new DEJT_Provider(aLazyNode);
+  Standard_Integer         aFirstTags[2] = {0, 0};
+  for (Standard_Integer aFileIter = 0; aFileIter < 2; ++aFileIter)
+  {
+    const TCollection_AsciiString aPath(theArgVec[aFileIter + 1]);
+    if (!OSD_File(OSD_Path(aPath)).Exists())
+    {
+      theDI << "Error: file '" << aPath << "' is not found\n";
+      return 1;
+    }
+    aFirstTags[aFileIter] = DEJT_Provider::NextShapeTag(aDoc);
+    if (!aLazyProvider->Read(aPath, aDoc))
+    {
+      theDI << "Error: lazy reading of '" << aPath << "' has failed\n";
+      return 1;
+    }
+  }
+  const Handle(DEJT_MetadataStore) aStore = DEJT_MetadataStore::Find(aDoc->Main());
+  if (aStore.IsNull() || aStore->NbSources() != 2)
+  {
+    theDI << "Error: the store does not keep both files\n";
+    return 0;
+  }
+
+  bool isOk = true;
+  for (Standard_Integer aFileIter = 0; aFileIter < 2; ++aFileIter)
+  {
+    const TCollection_AsciiString aPath(theArgVec[aFileIter + 1]);
+    Handle(TDocStd_Document)      anEagerDoc      = new TDocStd_Document("BinXCAF");
+    Handle(DEJT_Provider)         anEagerProvider = new DEJT_Provider(anEagerNode);
+    if (!anEagerProvider->Read(aPath, anEagerDoc))
+    {
+      theDI << "Error: eager reading of '" << aPath << "' has failed\n";
+      return 1;
+    }
+
+    Standard_Integer aNbLabels = 0;
+    for (TDF_ChildIterator aLabelIter(XCAFDoc_DocumentTool::ShapesLabel(anEagerDoc->Main()),
+                                      Standard_True);
+         aLabelIter.More();
+         aLabelIter.Next())
+    {
+      Handle(TDataStd_NamedData) anExpected;
+      if (!aLabelIter.Value().FindAttribute(TDataStd_NamedData::GetID(), anExpected))
+      {
+        continue;
+      }
+      ++aNbLabels;
+      const TDF_Label aLabel =
+        DEJT_Provider::MapShapeLabel(aLabelIter.Value(), aDoc, aFirstTags[aFileIter]);
+      const Handle(TDataStd_NamedData) aData = DEJT_MetadataStore::NamedData(aLabel);
+      if (aData.IsNull()
+          || aData->GetIntegersContainer().Extent() != anExpected->GetIntegersContainer().Extent()
+          || aData->GetRealsContainer().Extent() != anExpected->GetRealsContainer().Extent()
+          || aData->GetStringsContainer().Extent() != anExpected->GetStringsContainer().Extent())
+      {
+        theDI << "Error: metadata of a label of '" << aPath << "' differs\n";
+        isOk = false;
+        break;
+      }
+    }
+    if (aNbLabels == 0)
+    {
+      theDI << "Error: file '" << aPath << "' has no metadata to compare\n";
+      isOk = false;
+    }
+  }
+  if (isOk)
+  {
+    theDI << "OK\n";
+  }
+  return 0;
+}
+
+//! Returns TRUE if the box is entirely behind one of the planes.
+static bool isOutOfPlanes(const BVH_Box<Standard_Real, 3>& theBox,
+                          const NCollection_Array1<gp_Pln>& thePlanes)
+{
+  for (NCollection_Array1<gp_Pln>::Iterator aPlaneIter(thePlanes); aPlaneIter.More();
+       aPlaneIter.Next())
+  {
+    bool isBehind = true;
+    for (Standard_Integer aCornerIter = 0; aCornerIter < 8 && isBehind; ++aCornerIter)
+    {
+      const gp_Pnt aCorner(
+        (aCornerIter & 1) != 0 ? theBox.CornerMax().x() : theBox.CornerMin().x(),
+        (aCornerIter & 2) != 0 ? theBox.CornerMax().y() : theBox.CornerMin().y(),
+        (aCornerIter & 4) != 0 ? theBox.CornerMax().z() : theBox.CornerMin().z());
+      const gp_Pln& aPlane = aPlaneIter.Value();
+      isBehind = gp_Vec(aPlane.Location(), aCorner).Dot(gp_Vec(aPlane.Axis().Direction())) < 0.0;
+    }
+    if (isBehind)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//! Compares segments selected by the index with the segments
+//! which boxes are accepted by the brute force check.
+template <typename TheIsOut>
+static bool checkSelection(Draw_Interpretor&                                          theDI,
+                           const Handle(DEJT_SegmentIndex)&                           theIndex,
+                           const NCollection_Sequence<Handle(JtProperty_LateLoaded)>& theFound,
+                           const TheIsOut&                                            theIsOut,
+                           const char*                                                theQuery)
+{
+  NCollection_Map<Handle(JtProperty_LateLoaded)> aFound;
+  for (NCollection_Sequence<Handle(JtProperty_LateLoaded)>::Iterator aSegIter(theFound);
+       aSegIter.More();
+       aSegIter.Next())
+  {
+    aFound.Add(aSegIter.Value());
+  }
+  Standard_Integer aNbExpected = 0;
+  bool             isOk        = aFound.Extent() == theFound.Length();
+  for (Standard_Integer aSegIter = 0; aSegIter < theIndex->Size(); ++aSegIter)
+  {
+    if (!theIsOut(theIndex->Box(aSegIter)))
+    {
+      ++aNbExpected;
+      isOk = isOk && aFound.Contains(theIndex->Segment(aSegIter));
+    }
+  }
+  isOk = isOk && aNbExpected == theFound.Length();
+  if (!isOk)
+  {
+    theDI << "Error: " << theQuery << " selects " << theFound.Length() << " segments instead of "
+          << aNbExpected << "\n";
+  }
+  return isOk;
+}
+
+//=======================================================================
+// function : JtTestSegmentIndex
+// purpose  :
+//=======================================================================
+static Standard_Integer JtTestSegmentIndex(Draw_Interpretor& theDI,
+                                           Standard_Integer  theNbArgs,
+                                           const char**      theArgVec)
+{
+  if (theNbArgs != 2)
+  {
+    theDI << "Syntax error: wrong number of arguments\n";
+    return 1;
+  }
+
+  Handle(NCollection_IncAllocator) anAllocator = new NCollection_IncAllocator();
+  Handle(JtData_Model)             aModel      = new JtData_Model(theArgVec[1]);
+  const Handle(JtNode_Partition)   aRoot       = aModel->Init(anAllocator, Message_ProgressRange());
+  if (aRoot.IsNull())
+  {
+    theDI << "Error: the scene graph of '" << theArgVec[1] << "' cannot be read\n";
+    return 1;
+  }
+  Handle(DEJT_SegmentIndex) anIndex = new DEJT_SegmentIndex();
+  const Standard_Integer    aNbSegments = anIndex->Perform(aRoot);
+  if (aNbSegments == 0)
+  {
+    theDI << "Error: the file has no late-loaded segments with bounds\n";
+    return 0;
+  }
+
+  Bnd_Box aBounds;
+  for (Standard_Integer aSegIter = 0; aSegIter < anIndex->Size(); ++aSegIter)
+  {
+    const BVH_Box<Standard_Real, 3>& aBox = anIndex->Box(aSegIter);
+    aBounds.Update(aBox.CornerMin().x(), aBox.CornerMin().y(), aBox.CornerMin().z(),
+                   aBox.CornerMax().x(), aBox.CornerMax().y(), aBox.CornerMax().z());
+  }
+  const gp_Pnt aMin    = aBounds.CornerMin();
+  const gp_Pnt aMax    = aBounds.CornerMax();
+  const gp_Pnt aCenter = aMin.Translated(gp_Vec(aMin, aMax) * 0.5);
+  const gp_Vec aDiag(aMin, aMax);
+  bool         isOk = true;
+
+  // box queries: the whole model, its lower octant and a box outside of the model
+  Bnd_Box aBoxes[3];
+  aBoxes[0] = aBounds;
+  aBoxes[1].Update(aMin.X(), aMin.Y(), aMin.Z(), aCenter.X(), aCenter.Y(), aCenter.Z());
+  aBoxes[2].Update(aMax.X() + aDiag.Magnitude(), aMax.Y(), aMax.Z());
+  const Standard_Integer aNbBoxExpected[3] = {aNbSegments, -1, 0};
+  for (Standard_Integer aBoxIter = 0; aBoxIter < 3; ++aBoxIter)
+  {
+    NCollection_Sequence<Handle(JtProperty_LateLoaded)> aFound;
+    anIndex->Select(aBoxes[aBoxIter], aFound);
+    const Bnd_Box& aQuery = aBoxes[aBoxIter];
+    isOk = checkSelection(theDI,
+                          anIndex,
+                          aFound,
+                          [&aQuery](const BVH_Box<Standard_Real, 3>& theBox) {
+                            Bnd_Box aBox;
+                            aBox.Update(theBox.CornerMin().x(), theBox.CornerMin().y(),
+                                        theBox.CornerMin().z(), theBox.CornerMax().x(),
+                                        theBox.CornerMax().y(), theBox.CornerMax().z());
+                            return aQuery.IsOut(aBox);
+                          },
+                          "box query")
+           && isOk;
+    if (aNbBoxExpected[aBoxIter] >= 0 && aFound.Length() != aNbBoxExpected[aBoxIter])
+    {
+      theDI << "Error: box query " << aBoxIter << " selects " << aFound.Length()
+            << " segments instead of " << aNbBoxExpected[aBoxIter] << "\n";
+      isOk = false;
+    }
+  }
+
+  // frustum queries: camera fitted to the model, zoomed in and looking away from the model
+  Handle(Graphic3d_Camera) aFitCamera = new Graphic3d_Camera();
+  aFitCamera->SetProjectionType(Graphic3d_Camera::Projection_Perspective);
+  aFitCamera->SetAspect(1.0);
+  aFitCamera->SetUp(gp_Dir(0.0, 0.0, 1.0));
+  aFitCamera->SetCenter(aCenter);
+  aFitCamera->SetEye(aCenter.Translated(gp_Vec(1.0, -1.0, 1.0) * (2.0 * aDiag.Magnitude())));
+  aFitCamera->FitMinMax(aBounds, Precision::Confusion(), false);
+  aFitCamera->ZFitAll(1.0, aBounds, aBounds);
+
+  Handle(Graphic3d_Camera) aZoomCamera = new Graphic3d_Camera();
+  aZoomCamera->Copy(aFitCamera);
+  aZoomCamera->SetCenter(aMin.Translated(gp_Vec(aMin, aMax) * 0.25));
+  aZoomCamera->SetScale(aFitCamera->Scale() * 0.1);
+
+  Handle(Graphic3d_Camera) anAwayCamera = new Graphic3d_Camera();
+  anAwayCamera->Copy(aFitCamera);
+  anAwayCamera->SetCenter(
+    aFitCamera->Eye().Translated(gp_Vec(aFitCamera->Center(), aFitCamera->Eye())));
+
+  const Handle(Graphic3d_Camera)* aCameras[3] = {&aFitCamera, &aZoomCamera, &anAwayCamera};
+  const Standard_Integer aNbFrustumExpected[3] = {aNbSegments, -1, 0};
+  for (Standard_Integer aCamIter = 0; aCamIter < 3; ++aCamIter)
+  {
+    NCollection_Sequence<Handle(JtProperty_LateLoaded)> aFound;
+    anIndex->Select(*aCameras[aCamIter], aFound);
+    NCollection_Array1<gp_Pln> aPlanes(1, 6);
+    DEJT_SegmentIndex::FrustumPlanes(*aCameras[aCamIter], aPlanes);
+    isOk = checkSelection(theDI,
+                          anIndex,
+                          aFound,
+                          [&aPlanes](const BVH_Box<Standard_Real, 3>& theBox) {
+                            return isOutOfPlanes(theBox, aPlanes);
+                          },
+                          "frustum query")
+           && isOk;
+    if (aNbFrustumExpected[aCamIter] >= 0 && aFound.Length() != aNbFrustumExpected[aCamIter])
+    {
+      theDI << "Error: frustum query " << aCamIter << " selects " << aFound.Length()
+            << " segments instead of " << aNbFrustumExpected[aCamIter] << "\n";
+      isOk = false;
+    }
+  }
+
+  if (isOk)
+  {
+    theDI << "OK\n";
+  }
+  return 0;
+}
+
+//=======================================================================
+// function : InitCommands
+// purpose  :
+//=======================================================================
+void XSDRAWJT_Test::InitCommands(Draw_Interpretor& theCommands)
+{
+  const char* aGroup = "TKDEJT checks";
+  theCommands.Add("JtTestMetadataStore",
+                  "JtTestMetadataStore jtFile1 jtFile2"
+                  "\n\t\t: Reads both files into one document with lazy metadata and checks"
+                  "\n\t\t: that metadata of every label of each file matches an eager read.",
+                  __FILE__,
+                  JtTestMetadataStore,
+                  aGroup);
+  theCommands.Add("JtTestSegmentIndex",
+                  "JtTestSegmentIndex jtFile"
+                  "\n\t\t: Builds the spatial index of late-loaded segments from the scene graph"
+                  "\n\t\t: and checks box and frustum selections against a brute force check"
+                  "\n\t\t: of every segment box.",
+                  __FILE__,
+                  JtTestSegmentIndex,
+                  aGroup);
+}
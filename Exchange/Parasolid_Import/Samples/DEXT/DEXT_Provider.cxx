@@ -16,9 +16,14 @@
 
 #include <BinXCAFDrivers.hxx>
 #include <BRep_Builder.hxx>
+#include <BRepBuilderAPI_Transform.hxx>
 #include <DE_ConfigurationNode.hxx>
 #include <Interface_Static.hxx>
 #include <Message.hxx>
+#include <Message_ProgressScope.hxx>
+#include <OSD_Parallel.hxx>
+#include <Precision.hxx>
+#include <Standard_ArrayStreamBuffer.hxx>
 #include <XCAFDoc_DocumentTool.hxx>
 #include <XSControl_WorkSession.hxx>
 #include <DEXT_ConfigurationNode.hxx>
@@ -188,6 +193,152 @@ bool DEXT_Provider::Read(const TCollection_AsciiString& thePath,
   return Read(thePath, theShape, aWS, theProgress);
 }
 
+//=======================================================================
+// function : Read
+// purpose  :
+//=======================================================================
+bool DEXT_Provider::Read(const Blob&                    theBlob,
+                         TopoDS_Shape&                  theShape,
+                         Handle(XSControl_WorkSession)& theWS,
+                         const Message_ProgressRange&   theProgress)
+{
+  if (!GetNode()->IsKind(STANDARD_TYPE(DEXT_ConfigurationNode)))
+  {
+    Message::SendFail() << "Error in the DEXT_Provider during reading the stream " << theBlob.Name
+                        << "\t: Incorrect or empty Configuration Node";
+    return false;
+  }
+  Handle(DEXT_ConfigurationNode) aNode = Handle(DEXT_ConfigurationNode)::DownCast(GetNode());
+  initStatic(aNode);
+  personizeWS(theWS);
+  const bool isDone = readBlob(theBlob, theShape, theWS, theProgress);
+  setStatic(myOldValues);
+  return isDone;
+}
+
+//=======================================================================
+// function : Read
+// purpose  :
+//=======================================================================
+bool DEXT_Provider::Read(const NCollection_Array1<Blob>&   theBlobs,
+                         NCollection_Array1<TopoDS_Shape>& theShapes,
+                         const bool                        theToParallel,
+                         const Message_ProgressRange&      theProgress)
+{
+  if (theBlobs.IsEmpty())
+  {
+    return true;
+  }
+  if (!GetNode()->IsKind(STANDARD_TYPE(DEXT_ConfigurationNode)))
+  {
+    Message::SendFail() << "Error in the DEXT_Provider during reading the streams"
+                        << "\t: Incorrect or empty Configuration Node";
+    return false;
+  }
+  Handle(DEXT_ConfigurationNode) aNode = Handle(DEXT_ConfigurationNode)::DownCast(GetNode());
+  // static parameters are shared by all work sessions, so they are set once for the whole batch
+  initStatic(aNode);
+
+  theShapes.Resize(theBlobs.Lower(), theBlobs.Upper(), false);
+  NCollection_Array1<bool> aResults(theBlobs.Lower(), theBlobs.Upper());
+  aResults.Init(false);
+  NCollection_Array1<Message_ProgressRange> aRanges(theBlobs.Lower(), theBlobs.Upper());
+  Message_ProgressScope aPS(theProgress, "Reading XT data", theBlobs.Size());
+  for (Standard_Integer anIndex = theBlobs.Lower(); anIndex <= theBlobs.Upper(); ++anIndex)
+  {
+    theShapes(anIndex).Nullify();
+    aRanges(anIndex) = aPS.Next();
+  }
+
+  // each block gets its own reader and work session, so that blocks are translated independently
+  OSD_Parallel::For(
+    theBlobs.Lower(),
+    theBlobs.Upper() + 1,
+    [&](const Standard_Integer theIndex) {
+      if (!aRanges(theIndex).More())
+      {
+        return;
+      }
+      Handle(XSControl_WorkSession) aWS = new XSControl_WorkSession();
+      personizeWS(aWS);
+      aResults(theIndex) =
+        readBlob(theBlobs(theIndex), theShapes(theIndex), aWS, aRanges(theIndex));
+    },
+    !theToParallel);
+  setStatic(myOldValues);
+
+  bool isDone = aPS.More();
+  for (Standard_Integer anIndex = theBlobs.Lower(); anIndex <= theBlobs.Upper(); ++anIndex)
+  {
+    isDone = isDone && aResults(anIndex);
+  }
+  return isDone;
+}
+
+//=======================================================================
+// function : readBlob
+// purpose  :
+//=======================================================================
+bool DEXT_Provider::readBlob(const Blob&                    theBlob,
+                             TopoDS_Shape&                  theShape,
+                             Handle(XSControl_WorkSession)& theWS,
+                             const Message_ProgressRange&   theProgress)
+{
+  if (theBlob.Data == nullptr || theBlob.Size == 0)
+  {
+    Message::SendFail() << "Error in the DEXT_Provider during reading the stream " << theBlob.Name
+                        << "\t: empty data";
+    return false;
+  }
+  Handle(DEXT_ConfigurationNode) aNode = Handle(DEXT_ConfigurationNode)::DownCast(GetNode());
+  Message_ProgressScope          aPS(theProgress, "Reading XT stream", 2);
+  XtControl_Reader               aReader;
+  aReader.SetWS(theWS);
+
+  // the stream reads the memory block in place
+  Standard_ArrayStreamBuffer aStreamBuffer(reinterpret_cast<const char*>(theBlob.Data),
+                                           theBlob.Size);
+  std::istream               aStream(&aStreamBuffer);
+  IFSelect_ReturnStatus      aReadStat = aReader.ReadStream(theBlob.Name.ToCString(), aStream);
+  if (aReadStat != IFSelect_RetDone)
+  {
+    Message::SendFail() << "Error in the DEXT_Provider during reading the stream " << theBlob.Name
+                        << "\t: abandon, no model loaded";
+    return false;
+  }
+  aPS.Next();
+  if (aPS.UserBreak())
+  {
+    return false;
+  }
+  if (aReader.TransferRoots(aPS.Next()) <= 0)
+  {
+    if (!aPS.UserBreak())
+    {
+      Message::SendFail() << "Error in the DEXT_Provider during reading the stream "
+                          << theBlob.Name
+                          << "\t: Cannot read any relevant data from the XT stream";
+    }
+    return false;
+  }
+  if (aPS.UserBreak())
+  {
+    return false;
+  }
+  theShape = aReader.OneShape();
+
+  // XT data is defined in meters; scale it the same way as ReadFile() does
+  const Standard_Real aScale = 1000. / aNode->GlobalParameters.LengthUnit;
+  if (Abs(aScale - 1.0) > Precision::Confusion() && !theShape.IsNull())
+  {
+    gp_Trsf aTrsf;
+    aTrsf.SetScaleFactor(aScale);
+    BRepBuilderAPI_Transform aTransform(theShape, aTrsf, false);
+    theShape = aTransform.Shape();
+  }
+  return true;
+}
+
 //=======================================================================
 // function : GetFormat
 // purpose  :
@@ -17,6 +17,7 @@
 
 #include <DE_Provider.hxx>
 #include <DEXT_ConfigurationNode.hxx>
+#include <NCollection_Array1.hxx>
 
 class TopoDS_Shape;
 class TDocStd_Document;
@@ -89,6 +90,42 @@ public:
     TopoDS_Shape&                  theShape,
     const Message_ProgressRange&   theProgress = Message_ProgressRange()) Standard_OVERRIDE;
 
+public:
+  //! Memory block holding the content of a single XT file,
+  //! e.g. a decompressed XT B-Rep segment of a JT file.
+  //! The block is not copied and should outlive the Read() call.
+  struct Blob
+  {
+    const Standard_Byte*    Data = nullptr; //!< first byte of the XT data
+    Standard_Size           Size = 0;       //!< number of bytes
+    TCollection_AsciiString Name;           //!< name used in messages
+  };
+
+  //! Reads XT data from the memory block, according internal configuration.
+  //! The data is passed to the reader through a stream over the block without copying.
+  //! @param[in] theBlob XT data to read
+  //! @param[out] theShape shape to save result
+  //! @param[in] theWS current work session
+  //! @param theProgress[in] progress indicator
+  //! @return true if Read operation has ended correctly
+  Standard_EXPORT bool Read(const Blob&                    theBlob,
+                            TopoDS_Shape&                  theShape,
+                            Handle(XSControl_WorkSession)& theWS,
+                            const Message_ProgressRange&   theProgress = Message_ProgressRange());
+
+  //! Reads a set of independent XT memory blocks, according internal configuration.
+  //! Blocks are translated in parallel, each one within its own work session.
+  //! @param[in] theBlobs XT data to read
+  //! @param[out] theShapes shapes to save result, resized to the number of blocks;
+  //!                       null shape is stored for a block which has not been read
+  //! @param[in] theToParallel flag to translate blocks in parallel threads
+  //! @param theProgress[in] progress indicator
+  //! @return true if all blocks have been read
+  Standard_EXPORT bool Read(const NCollection_Array1<Blob>&   theBlobs,
+                            NCollection_Array1<TopoDS_Shape>& theShapes,
+                            const bool                        theToParallel = true,
+                            const Message_ProgressRange&      theProgress = Message_ProgressRange());
+
 public:
   //! Gets CAD format name of associated provider
   //! @return provider CAD format
@@ -110,6 +147,13 @@ private:
   //! @param[in] theWS current work session
   void personizeWS(Handle(XSControl_WorkSession)& theWS);
 
+  //! Reads XT data from the memory block into the shape.
+  //! Static parameters should be already initialized by the caller.
+  bool readBlob(const Blob&                    theBlob,
+                TopoDS_Shape&                  theShape,
+                Handle(XSControl_WorkSession)& theWS,
+                const Message_ProgressRange&   theProgress);
+
   DEXT_ConfigurationNode::XTCAFControl_InternalSection myOldValues;
 };
 